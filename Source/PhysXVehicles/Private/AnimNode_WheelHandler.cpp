@@ -2,6 +2,7 @@
 
 #include "AnimNode_WheelHandler.h"
 #include "AnimationRuntime.h"
+#include "Animation/AnimTrace.h"
 #include "WheeledVehicle.h"
 #include "WheeledVehicleMovementComponent.h"
 
@@ -12,10 +13,24 @@ PRAGMA_DISABLE_DEPRECATION_WARNINGS
 // FAnimNode_WheelHandler
 
 FAnimNode_WheelHandler::FAnimNode_WheelHandler()
+	: ReducedRateLODThreshold(INDEX_NONE)
+	, ReducedRateInterval(2)
 {
 	AnimInstanceProxy = nullptr;
 }
 
+bool FAnimNode_WheelHandler::ShouldSkipEvaluation(const FComponentSpacePoseContext& Output) const
+{
+	if (ReducedRateLODThreshold == INDEX_NONE || ReducedRateInterval <= 1 || Output.AnimInstanceProxy->GetLODLevel() < ReducedRateLODThreshold)
+	{
+		return false;
+	}
+
+	// Stagger vehicles across frames so they do not all evaluate on the same one
+	const uint64 Phase = PointerHash(AnimInstanceProxy);
+	return (GFrameCounter + Phase) % ReducedRateInterval != 0;
+}
+
 void FAnimNode_WheelHandler::GatherDebugData(FNodeDebugData& DebugData)
 {
 	FString DebugLine = DebugData.GetNodeName(this);
@@ -51,30 +66,53 @@ void FAnimNode_WheelHandler::EvaluateSkeletalControl_AnyThread(FComponentSpacePo
 	check(OutBoneTransforms.Num() == 0);
 
 	const TArray<FWheelAnimData>& WheelAnimData = AnimInstanceProxy->GetWheelAnimData();
+	const bool bSkipEvaluation = ShouldSkipEvaluation(Output);
 
 	const FBoneContainer& BoneContainer = Output.Pose.GetPose().GetBoneContainer();
-	for(const FWheelLookupData& Wheel : Wheels)
+	for(FWheelLookupData& Wheel : Wheels)
 	{
 		if (Wheel.BoneReference.IsValidToEvaluate(BoneContainer))
 		{
 			FCompactPoseBoneIndex WheelSimBoneIndex = Wheel.BoneReference.GetCompactPoseIndex(BoneContainer);
 
+			if (bSkipEvaluation && Wheel.bCacheValid)
+			{
+				OutBoneTransforms.Add(FBoneTransform(WheelSimBoneIndex, Wheel.CachedOutputTM));
+				continue;
+			}
+
 			// the way we apply transform is same as FMatrix or FTransform
 			// we apply scale first, and rotation, and translation
 			// if you'd like to translate first, you'll need two nodes that first node does translate and second nodes to rotate. 
-			FTransform NewBoneTM = Output.Pose.GetComponentSpaceTransform(WheelSimBoneIndex);
+			// The offsets are applied in component space, so there is no bone space round trip to make
+			const FTransform& InputBoneTM = Output.Pose.GetComponentSpaceTransform(WheelSimBoneIndex);
+			const FWheelAnimData& AnimData = WheelAnimData[Wheel.WheelIndex];
+
+			const bool bRotOffsetChanged = !Wheel.bCacheValid || !Wheel.CachedRotOffset.Equals(AnimData.RotOffset, 0.f);
+			if (!bRotOffsetChanged && Wheel.CachedLocOffset == AnimData.LocOffset && Wheel.CachedInputTM.Equals(InputBoneTM, 0.f))
+			{
+				OutBoneTransforms.Add(FBoneTransform(WheelSimBoneIndex, Wheel.CachedOutputTM));
+				continue;
+			}
+
+			if (bRotOffsetChanged)
+			{
+				Wheel.CachedRotOffset = AnimData.RotOffset;
+				Wheel.CachedRotQuat = FQuat(AnimData.RotOffset);
+			}
 
-			FAnimationRuntime::ConvertCSTransformToBoneSpace(Output.AnimInstanceProxy->GetComponentTransform(), Output.Pose, NewBoneTM, WheelSimBoneIndex, BCS_ComponentSpace);
+			FTransform NewBoneTM = InputBoneTM;
 
 			// Apply rotation offset
-			const FQuat BoneQuat(WheelAnimData[Wheel.WheelIndex].RotOffset);
-			NewBoneTM.SetRotation(BoneQuat * NewBoneTM.GetRotation());
+			NewBoneTM.SetRotation(Wheel.CachedRotQuat * NewBoneTM.GetRotation());
 
 			// Apply loc offset
-			NewBoneTM.AddToTranslation(WheelAnimData[Wheel.WheelIndex].LocOffset);
+			NewBoneTM.AddToTranslation(AnimData.LocOffset);
 
-			// Convert back to Component Space.
-			FAnimationRuntime::ConvertBoneSpaceTransformToCS(Output.AnimInstanceProxy->GetComponentTransform(), Output.Pose, NewBoneTM, WheelSimBoneIndex, BCS_ComponentSpace);
+			Wheel.bCacheValid = true;
+			Wheel.CachedLocOffset = AnimData.LocOffset;
+			Wheel.CachedInputTM = InputBoneTM;
+			Wheel.CachedOutputTM = NewBoneTM;
 
 			// add back to it
 			OutBoneTransforms.Add(FBoneTransform(WheelSimBoneIndex, NewBoneTM));
@@ -82,6 +120,12 @@ void FAnimNode_WheelHandler::EvaluateSkeletalControl_AnyThread(FComponentSpacePo
 	}
 
 #if ANIM_TRACE_ENABLED
+	// Only pay for the strings when someone is listening
+	if (!UE_TRACE_CHANNELEXPR_IS_ENABLED(AnimationChannel))
+	{
+		return;
+	}
+
 	for (const FWheelLookupData& Wheel : Wheels)
 	{
 		if (Wheel.BoneReference.BoneIndex != INDEX_NONE)
@@ -125,6 +169,7 @@ void FAnimNode_WheelHandler::InitializeBoneReferences(const FBoneContainer& Requ
 		Wheel->WheelIndex = WheelIndex;
 		Wheel->BoneReference.BoneName = WheelAnimData[WheelIndex].BoneName;
 		Wheel->BoneReference.Initialize(RequiredBones);
+		Wheel->bCacheValid = false;
 	}
 
 	// sort by bone indices
@@ -0,0 +1,168 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "PhysXVehicleAsyncWriter.h"
+#include "HAL/Event.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/RunnableThread.h"
+#include "Serialization/Archive.h"
+
+FPhysXVehicleAsyncWriter::FPhysXVehicleAsyncWriter(const FString& InFilename, int32 InBlockSize, int32 InMaxBlocks)
+	: Filename(InFilename)
+	, BlockSize(FMath::Max(InBlockSize, 1024))
+	, FileWriter(nullptr)
+	, Thread(nullptr)
+	, WorkEvent(nullptr)
+	, CurrentBlock(nullptr)
+{
+	FileWriter = IFileManager::Get().CreateFileWriter(*Filename);
+	if (FileWriter == nullptr)
+	{
+		return;
+	}
+
+	// Need at least one block being filled and one being written
+	const int32 NumBlocks = FMath::Max(InMaxBlocks, 2);
+	for (int32 BlockIdx = 0; BlockIdx < NumBlocks; ++BlockIdx)
+	{
+		TArray<uint8>* Block = Blocks.Add_GetRef(MakeUnique<TArray<uint8>>()).Get();
+		Block->Reserve(BlockSize);
+
+		if (CurrentBlock == nullptr)
+		{
+			CurrentBlock = Block;
+		}
+		else
+		{
+			FreeBlocks.Enqueue(Block);
+		}
+	}
+
+	WorkEvent = FPlatformProcess::GetSynchEventFromPool(false);
+	Thread = FRunnableThread::Create(this, TEXT("PhysXVehicleAsyncWriter"), 0, TPri_BelowNormal);
+}
+
+FPhysXVehicleAsyncWriter::~FPhysXVehicleAsyncWriter()
+{
+	if (Thread)
+	{
+		Flush();
+
+		Stop();
+		Thread->WaitForCompletion();
+		delete Thread;
+		Thread = nullptr;
+	}
+
+	if (WorkEvent)
+	{
+		FPlatformProcess::ReturnSynchEventToPool(WorkEvent);
+		WorkEvent = nullptr;
+	}
+
+	if (FileWriter)
+	{
+		FileWriter->Close();
+		delete FileWriter;
+		FileWriter = nullptr;
+	}
+}
+
+void FPhysXVehicleAsyncWriter::Write(const void* Data, int32 Num)
+{
+	if (CurrentBlock == nullptr || Num <= 0)
+	{
+		return;
+	}
+
+	if (CurrentBlock->Num() > 0 && CurrentBlock->Num() + Num > BlockSize)
+	{
+		Flush();
+	}
+
+	// A single oversized write grows the block rather than being split
+	CurrentBlock->Append((const uint8*)Data, Num);
+}
+
+void FPhysXVehicleAsyncWriter::WriteReliable(const void* Data, int32 Num)
+{
+	if (CurrentBlock == nullptr || Num <= 0)
+	{
+		return;
+	}
+
+	ReliableRecords.Enqueue(TArray<uint8>((const uint8*)Data, Num));
+	WorkEvent->Trigger();
+}
+
+void FPhysXVehicleAsyncWriter::Flush()
+{
+	if (CurrentBlock == nullptr || CurrentBlock->Num() == 0)
+	{
+		return;
+	}
+
+	TArray<uint8>* NextBlock = nullptr;
+	if (FreeBlocks.Dequeue(NextBlock))
+	{
+		PendingBlocks.Enqueue(CurrentBlock);
+		CurrentBlock = NextBlock;
+		WorkEvent->Trigger();
+	}
+	else
+	{
+		// Writer is behind and every block is in flight. Drop this one rather than stall the simulation
+		NumDroppedBlocks.Increment();
+		CurrentBlock->Reset();
+	}
+}
+
+uint32 FPhysXVehicleAsyncWriter::Run()
+{
+	while (!bStopping)
+	{
+		DrainPendingBlocks();
+		WorkEvent->Wait(100);
+	}
+
+	// Make sure everything handed over before Stop() reaches the disk
+	DrainPendingBlocks();
+
+	return 0;
+}
+
+void FPhysXVehicleAsyncWriter::Stop()
+{
+	bStopping = true;
+
+	if (WorkEvent)
+	{
+		WorkEvent->Trigger();
+	}
+}
+
+void FPhysXVehicleAsyncWriter::DrainPendingBlocks()
+{
+	TArray<uint8> Record;
+	TArray<uint8>* Block = nullptr;
+	while (true)
+	{
+		// Reliable records go ahead of each block, a block handed over after one may already reference it
+		while (ReliableRecords.Dequeue(Record))
+		{
+			FileWriter->Serialize(Record.GetData(), Record.Num());
+			NumBytesWritten.Add(Record.Num());
+		}
+
+		if (!PendingBlocks.Dequeue(Block))
+		{
+			break;
+		}
+
+		FileWriter->Serialize(Block->GetData(), Block->Num());
+		NumBytesWritten.Add(Block->Num());
+
+		Block->Reset();
+		FreeBlocks.Enqueue(Block);
+	}
+}
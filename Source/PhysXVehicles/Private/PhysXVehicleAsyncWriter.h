@@ -0,0 +1,107 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "HAL/ThreadSafeBool.h"
+#include "HAL/ThreadSafeCounter.h"
+#include "HAL/ThreadSafeCounter64.h"
+#include "Containers/Queue.h"
+
+class FArchive;
+class FEvent;
+class FRunnableThread;
+
+/**
+ * Streams blocks of bytes to a file on a background thread.
+ * The producer fills the current block and hands it over when it is full, then carries on with a recycled one.
+ * Memory is bounded by the number of blocks: if the writer thread falls behind, the full block is dropped instead of stalling the producer.
+ */
+// 在后台线程上将字节块流式写入文件
+// 生产者填满当前块后将其移交，然后继续使用回收的块
+// 内存受块数量限制：如果写入线程落后，则丢弃已满的块，而不是阻塞生产者
+class FPhysXVehicleAsyncWriter : public FRunnable
+{
+public:
+
+	FPhysXVehicleAsyncWriter(const FString& InFilename, int32 InBlockSize, int32 InMaxBlocks);
+	virtual ~FPhysXVehicleAsyncWriter();
+
+	/** True if the file could be opened for writing */
+	// 如果文件可以被打开以写入，则为真
+	bool IsValid() const { return FileWriter != nullptr; }
+
+	/** Append bytes to the current block. Data passed in a single call is never split across blocks */
+	// 将字节追加到当前块。单次调用传入的数据永远不会被拆分到多个块中
+	void Write(const void* Data, int32 Num);
+
+	/**
+	 * Queue a small record the reader cannot do without, such as a dictionary entry. It bypasses the blocks so it is never dropped,
+	 * and reaches the disk ahead of every block handed over after the call
+	 */
+	// 将读取方不可缺少的小记录（例如字典条目）排队。它绕过块，因此永远不会被丢弃，
+	// 并且会先于调用之后移交的所有块写入磁盘
+	void WriteReliable(const void* Data, int32 Num);
+
+	/** Hand the current block over to the writer thread */
+	// 将当前块移交给写入线程
+	void Flush();
+
+	/** Number of blocks that were dropped because the writer thread fell behind */
+	// 由于写入线程落后而被丢弃的块数
+	int32 GetNumDroppedBlocks() const { return NumDroppedBlocks.GetValue(); }
+
+	/** Number of bytes written to disk so far */
+	// 到目前为止写入磁盘的字节数
+	int64 GetNumBytesWritten() const { return NumBytesWritten.GetValue(); }
+
+	const FString& GetFilename() const { return Filename; }
+
+	/** FRunnable interface */
+	virtual uint32 Run() override;
+	virtual void Stop() override;
+	/** End FRunnable interface */
+
+private:
+
+	/** Write every pending block to disk and recycle it */
+	// 将所有待处理的块写入磁盘并回收
+	void DrainPendingBlocks();
+
+	FString										Filename;
+
+	int32										BlockSize;
+
+	FArchive*									FileWriter;
+
+	FRunnableThread*							Thread;
+
+	FEvent*										WorkEvent;
+
+	// Owns every block, the queues and CurrentBlock only hold pointers into it
+	// 拥有所有块，队列和 CurrentBlock 只持有指向它们的指针
+	TArray<TUniquePtr<TArray<uint8>>>			Blocks;
+
+	// Block the producer is filling
+	// 生产者正在填充的块
+	TArray<uint8>*								CurrentBlock;
+
+	// Full blocks waiting for the writer thread (producer -> writer)
+	// 等待写入线程的已满块（生产者 -> 写入线程）
+	TQueue<TArray<uint8>*, EQueueMode::Spsc>	PendingBlocks;
+
+	// Records from WriteReliable, written before any pending block (producer -> writer)
+	// 来自 WriteReliable 的记录，在任何待处理块之前写入（生产者 -> 写入线程）
+	TQueue<TArray<uint8>, EQueueMode::Spsc>		ReliableRecords;
+
+	// Empty blocks handed back by the writer thread (writer -> producer)
+	// 写入线程交还的空块（写入线程 -> 生产者）
+	TQueue<TArray<uint8>*, EQueueMode::Spsc>	FreeBlocks;
+
+	FThreadSafeCounter							NumDroppedBlocks;
+
+	FThreadSafeCounter64						NumBytesWritten;
+
+	FThreadSafeBool								bStopping;
+};
@@ -0,0 +1,40 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "WheeledVehicleMovementComponent4W.h"
+#include "PhysXPublic.h"
+
+PRAGMA_DISABLE_DEPRECATION_WARNINGS
+
+#if PHYSICS_INTERFACE_PHYSX
+
+/**
+ * Conversions from our drivetrain setup to PhysX shared by the driven vehicle components, defined in WheeledVehicleMovementComponent4W.cpp
+ */
+// 由驱动型车辆组件共享的、从我们的传动系统设置到 PhysX 的转换，定义于 WheeledVehicleMovementComponent4W.cpp
+
+void GetVehicleEngineSetup(const FVehicleEngineData& Setup, PxVehicleEngineData& PxSetup);
+
+void GetVehicleGearSetup(const FVehicleTransmissionData& Setup, PxVehicleGearsData& PxSetup);
+
+void GetVehicleAutoBoxSetup(const FVehicleTransmissionData& Setup, PxVehicleAutoBoxData& PxSetup);
+
+/** Defaults of our engine and transmission setups, taken from PhysX */
+// 我们的引擎和变速器设置的默认值，取自 PhysX
+void GetDefaultVehicleEngineSetup(FVehicleEngineData& Setup);
+
+void GetDefaultVehicleTransmissionSetup(FVehicleTransmissionData& Setup);
+
+/** Engine, clutch, gears and autobox of any PhysX drive */
+// 任意 PhysX 驱动的引擎、离合器、齿轮和自动变速箱
+void SetupVehicleDriveSimData(const FVehicleEngineData& EngineSetup, const FVehicleTransmissionData& TransmissionSetup, PxVehicleDriveSimData& DriveData);
+
+/** Maximum steering versus forward speed, speeds in km/h converted to cm/s */
+// 最大转向与前进速度的关系，速度从 km/h 转换为 cm/s
+void GetVehicleSteerLookup(const FRuntimeFloatCurve& SteeringCurve, PxFixedSizeLookupTable<8>& PxSteerLookup);
+
+#endif // WITH_PHYSX
+
+PRAGMA_ENABLE_DEPRECATION_WARNINGS
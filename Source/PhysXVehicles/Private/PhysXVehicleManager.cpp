@@ -3,6 +3,18 @@
 #include "PhysXVehicleManager.h"
 #include "UObject/UObjectIterator.h"
 #include "TireConfig.h"
+#include "PhysXVehicleReplay.h"
+#include "PhysXVehicleStats.h"
+#include "PhysXVehicleWheelCount.h"
+#include "PhysXVehicleWheelInstances.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/Paths.h"
+#include "Components/PrimitiveComponent.h"
+#include "Async/ParallelFor.h"
 
 #include "PhysicalMaterials/PhysicalMaterial.h"
 #include "Physics/PhysicsFiltering.h"
@@ -15,19 +27,174 @@ PRAGMA_DISABLE_DEPRECATION_WARNINGS
 
 #if WITH_PHYSX_VEHICLES
 
-DECLARE_STATS_GROUP(TEXT("PhysXVehicleManager"), STATGROUP_PhysXVehicleManager, STATGROUP_Advanced);
 DECLARE_CYCLE_STAT(TEXT("PxVehicleSuspensionRaycasts"), STAT_PhysXVehicleManager_PxVehicleSuspensionRaycasts, STATGROUP_PhysXVehicleManager);
+DECLARE_CYCLE_STAT(TEXT("PxVehicleSuspensionRaycasts (Heightfield)"), STAT_PhysXVehicleManager_PxVehicleSuspensionRaycastsHeightfield, STATGROUP_PhysXVehicleManager);
+DECLARE_CYCLE_STAT(TEXT("PxVehicleSuspensionSweeps"), STAT_PhysXVehicleManager_PxVehicleSuspensionSweeps, STATGROUP_PhysXVehicleManager);
 DECLARE_CYCLE_STAT(TEXT("PxUpdateVehicles"), STAT_PhysXVehicleManager_PxUpdateVehicles, STATGROUP_PhysXVehicleManager);
 DECLARE_CYCLE_STAT(TEXT("UpdateTireFrictionTable"), STAT_PhysXVehicleManager_UpdateTireFrictionTable, STATGROUP_PhysXVehicleManager);
 DECLARE_CYCLE_STAT(TEXT("TickVehicles"), STAT_PhysXVehicleManager_TickVehicles, STATGROUP_PhysXVehicleManager);
 DECLARE_CYCLE_STAT(TEXT("VehicleManager Update"), STAT_PhysXVehicleManager_Update, STATGROUP_PhysXVehicleManager);
 DECLARE_CYCLE_STAT(TEXT("Pretick Vehicles"), STAT_PhysXVehicleManager_PretickVehicles, STATGROUP_Physics);
 
+DECLARE_DWORD_COUNTER_STAT(TEXT("Vehicles (Full Simulation)"), STAT_PhysXVehicleManager_NumVehiclesFull, STATGROUP_PhysXVehicleManager);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Vehicles (Kinematic LOD)"), STAT_PhysXVehicleManager_NumVehiclesKinematic, STATGROUP_PhysXVehicleManager);
+DECLARE_CYCLE_STAT(TEXT("Kinematic LOD"), STAT_PhysXVehicleManager_KinematicLOD, STATGROUP_PhysXVehicleManager);
+DECLARE_CYCLE_STAT(TEXT("Instanced Wheels"), STAT_PhysXVehicleManager_InstancedWheels, STATGROUP_PhysXVehicleManager);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Vehicles (Instanced Wheels)"), STAT_PhysXVehicleManager_NumVehiclesInstancedWheels, STATGROUP_PhysXVehicleManager);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Vehicles (Pending Creation)"), STAT_PhysXVehicleManager_NumVehiclesPendingCreation, STATGROUP_PhysXVehicleManager);
+DECLARE_CYCLE_STAT(TEXT("Commit Pending Creations"), STAT_PhysXVehicleManager_CommitPendingCreations, STATGROUP_PhysXVehicleManager);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Wheels Raycast"), STAT_PhysXVehicleManager_NumWheelsRaycast, STATGROUP_PhysXVehicleManager);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Raycast Hits"), STAT_PhysXVehicleManager_NumRaycastHits, STATGROUP_PhysXVehicleManager);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Wheels Raycast (Heightfield)"), STAT_PhysXVehicleManager_NumWheelsRaycastHeightfield, STATGROUP_PhysXVehicleManager);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Wheels Swept"), STAT_PhysXVehicleManager_NumWheelsSwept, STATGROUP_PhysXVehicleManager);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Sweep Hits"), STAT_PhysXVehicleManager_NumSweepHits, STATGROUP_PhysXVehicleManager);
+DECLARE_CYCLE_STAT(TEXT("Suspension PreFilter"), STAT_PhysXVehicleManager_SuspensionPreFilter, STATGROUP_PhysXVehicleManager);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Suspension PreFilter Calls"), STAT_PhysXVehicleManager_NumSuspensionPreFilterCalls, STATGROUP_PhysXVehicleManager);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Suspension Queries Skipped"), STAT_PhysXVehicleManager_NumSuspensionQueriesSkipped, STATGROUP_PhysXVehicleManager);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Suspension Query Skip Rate (%)"), STAT_PhysXVehicleManager_SuspensionQuerySkipRate, STATGROUP_PhysXVehicleManager);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Substeps Executed"), STAT_PhysXVehicleManager_NumSubsteps, STATGROUP_PhysXVehicleManager);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Friction Table Rebuilds"), STAT_PhysXVehicleManager_NumFrictionTableRebuilds, STATGROUP_PhysXVehicleManager);
+
+DEFINE_STAT(STAT_PhysXVehicle_TickVehicle);
+DEFINE_STAT(STAT_PhysXVehicle_UpdateDrag);
+DEFINE_STAT(STAT_PhysXVehicle_Avoidance);
+DEFINE_STAT(STAT_PhysXVehicle_TireShader);
+DEFINE_STAT(STAT_PhysXVehicle_AnimProxyPreUpdate);
+DEFINE_STAT(STAT_PhysXVehicle_SetupVehicle);
+DEFINE_STAT(STAT_PhysXVehicle_TireShaderCalls);
+DEFINE_STAT(STAT_PhysXVehicle_LockWaitMicroseconds);
+
 bool FPhysXVehicleManager::bUpdateTireFrictionTable = false;
 PxVehicleDrivableSurfaceToTireFrictionPairs* FPhysXVehicleManager::SurfaceTirePairs = NULL;
 TMap<FPhysScene*, FPhysXVehicleManager*> FPhysXVehicleManager::SceneToVehicleManagerMap;
 uint32 FPhysXVehicleManager::VehicleSetupTag = 0;
 
+static TAutoConsoleVariable<int32> CVarVehicleSuspensionSweepHits(
+	TEXT("p.Vehicle.SuspensionSweepHits"),
+	4,
+	TEXT("Number of hits reported per wheel by suspension sweeps (1-16). PhysX picks the best contact among them."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarVehicleSuspensionReuseDistance(
+	TEXT("p.Vehicle.SuspensionReuseDistance"),
+	0.5f,
+	TEXT("Skip a vehicle's suspension queries and reuse its cached hit planes while its chassis moved less than this distance (cm) since the last query. 0 disables reuse."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarVehicleSuspensionReuseAngle(
+	TEXT("p.Vehicle.SuspensionReuseAngle"),
+	0.25f,
+	TEXT("Maximum chassis rotation (degrees) since the last suspension query for cached hit planes to be reused."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarVehicleSuspensionReuseMaxAge(
+	TEXT("p.Vehicle.SuspensionReuseMaxAge"),
+	8,
+	TEXT("Maximum number of consecutive steps a vehicle may reuse cached suspension hit planes before it is queried again, so moving geometry underneath is eventually noticed."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarVehicleHeightfieldFastPath(
+	TEXT("p.Vehicle.HeightfieldFastPath"),
+	1,
+	TEXT("Raycast the suspension of vehicles resting only on registered heightfields against a scene holding just those heightfields. 0 always queries the full scene."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarVehicleHeightfieldRevalidateInterval(
+	TEXT("p.Vehicle.HeightfieldRevalidateInterval"),
+	4,
+	TEXT("Number of consecutive heightfield scene queries before a vehicle queries the full scene again, so other geometry under its wheels is noticed."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarVehicleParallelInput(
+	TEXT("p.Vehicle.ParallelInput"),
+	0,
+	TEXT("Smooth vehicle inputs in a parallel pass over packed per vehicle data. Skips PreTick and UpdateState, only enable it when no vehicle component overrides them."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarVehicleParallelInputMinBatch(
+	TEXT("p.Vehicle.ParallelInputMinBatch"),
+	32,
+	TEXT("Minimum number of locally controlled vehicles for the input pass to go wide, below it runs on the game thread."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarVehicleParallelTick(
+	TEXT("p.Vehicle.ParallelTick"),
+	0,
+	TEXT("Update wheel world states in parallel batches, each under one scene read lock, then pass inputs and apply drag for every vehicle under one write lock. Skips TickVehicle, UpdateSimulation and UpdateDrag, only enable it when no vehicle component overrides them."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarVehicleParallelTickBatchSize(
+	TEXT("p.Vehicle.ParallelTickBatchSize"),
+	16,
+	TEXT("Number of vehicles each parallel tick task handles."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarVehicleInstancedWheels(
+	TEXT("p.Vehicle.InstancedWheels"),
+	1,
+	TEXT("Draw the wheels of vehicles farther than their InstancedWheelsDistance from every view with instanced static meshes and stop evaluating their skeletons. 0 keeps skeletal wheels everywhere."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarVehicleKinematicLOD(
+	TEXT("p.Vehicle.KinematicLOD"),
+	1,
+	TEXT("Move vehicles farther than their KinematicLODDistance from every player with a kinematic arcade model instead of PxVehicleUpdates. 0 keeps every vehicle fully simulated."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarVehicleMaxCreationsPerFrame(
+	TEXT("p.Vehicle.MaxCreationsPerFrame"),
+	0,
+	TEXT("Maximum number of vehicles set up per frame, the rest wait in a queue for the following frames so a wave of spawns does not hitch. 0 sets every vehicle up as soon as its physics state is created."),
+	ECVF_Default);
+
+// Log the object every suspension query hits. Walks every UObject per hit, only for tracking down filtering issues
+#ifndef PHYSX_VEHICLE_DEBUG_SUSPENSION_HITS
+#define PHYSX_VEHICLE_DEBUG_SUSPENSION_HITS 0
+#endif
+
+/**
+ * tire shader every vehicle is set up with, defined in WheeledVehicleMovementComponent.cpp
+ */
+void PTireShader(const void* shaderData, const PxF32 tireFriction,
+	const PxF32 longSlip, const PxF32 latSlip,
+	const PxF32 camber, const PxF32 wheelOmega, const PxF32 wheelRadius, const PxF32 recipWheelRadius,
+	const PxF32 restTireLoad, const PxF32 normalisedTireLoad, const PxF32 tireLoad,
+	const PxF32 gravity, const PxF32 recipGravity,
+	PxF32& wheelTorque, PxF32& tireLongForceMag, PxF32& tireLatForceMag, PxF32& tireAlignMoment);
+
+/**
+ * filtering shared by the suspension raycasts and sweeps
+ */
+static FORCEINLINE bool ShouldSuspensionQueryHit( const PxFilterData& SuspensionData, const PxFilterData& HitData )
+{
+	PHYSX_VEHICLE_QUERY_FILTER_SCOPE_CYCLE_COUNTER(STAT_PhysXVehicleManager_SuspensionPreFilter);
+	PHYSX_VEHICLE_QUERY_FILTER_INC_COUNTER(STAT_PhysXVehicleManager_NumSuspensionPreFilterCalls);
+
+	// SuspensionData is the vehicle suspension query, packed by PackSuspensionQueryFilterData.
+	// HitData is the shape potentially hit by the query.
+
+	// don't collide with owner chassis, complexity must match and the hit shape must block the suspension channel
+	const bool bHit = (SuspensionData.word0 != HitData.word0)
+		& ((SuspensionData.word2 & HitData.word3) != 0)
+		& ((SuspensionData.word1 & HitData.word1) != 0);
+
+#if PHYSX_VEHICLE_DEBUG_SUSPENSION_HITS
+	if ( bHit )
+	{
+		for ( FObjectIterator It; It; ++It )
+		{
+			if ( It->GetUniqueID() == HitData.word0 )
+			{
+				UE_LOG( LogVehicles, Log, TEXT("Suspension query hit %s"), *It->GetName() );
+				break;
+			}
+		}
+	}
+#endif
+
+	return bHit;
+}
+
 /**
  * prefilter shader for suspension raycasts
  */
@@ -37,57 +204,82 @@ static PxQueryHitType::Enum WheelRaycastPreFilter(
 	const void* constantBlock, PxU32 constantBlockSize,
 	PxHitFlags& filterFlags)
 {
-	// SuspensionData is the vehicle suspension raycast.
-	// HitData is the shape potentially hit by the raycast.
+	return ShouldSuspensionQueryHit( SuspensionData, HitData ) ? PxQueryHitType::eBLOCK : PxQueryHitType::eNONE;
+}
+
+/**
+ * prefilter shader for suspension sweeps, hits are touches so several of them get reported per wheel
+ */
+static PxQueryHitType::Enum WheelSweepPreFilter(	
+	PxFilterData SuspensionData, 
+	PxFilterData HitData,
+	const void* constantBlock, PxU32 constantBlockSize,
+	PxHitFlags& filterFlags)
+{
+	return ShouldSuspensionQueryHit( SuspensionData, HitData ) ? PxQueryHitType::eTOUCH : PxQueryHitType::eNONE;
+}
+
+/**
+ * suspension filtering for single scene queries, such as the kinematic LOD's axle rays
+ */
+class FSuspensionQueryFilterCallback : public PxQueryFilterCallback
+{
+public:
+	explicit FSuspensionQueryFilterCallback( const PxFilterData& InSuspensionData )
+		: SuspensionData( InSuspensionData )
+	{
+	}
 
-	// don't collide with owner chassis
-	if ( SuspensionData.word0 == HitData.word0 )
+	virtual PxQueryHitType::Enum preFilter( const PxFilterData& FilterData, const PxShape* Shape, const PxRigidActor* Actor, PxHitFlags& QueryFlags ) override
 	{
-		return PxQueryHitType::eNONE;
+		return ShouldSuspensionQueryHit( SuspensionData, Shape->getQueryFilterData() ) ? PxQueryHitType::eBLOCK : PxQueryHitType::eNONE;
 	}
-	
-	PxU32 ShapeFlags = SuspensionData.word3 & 0xFFFFFF;
-	PxU32 QuerierFlags = HitData.word3 & 0xFFFFFF;
-	PxU32 CommonFlags = ShapeFlags & QuerierFlags;
 
-	// Check complexity matches
-	if (!(CommonFlags & EPDF_SimpleCollision) && !(CommonFlags & EPDF_ComplexCollision))
+	virtual PxQueryHitType::Enum postFilter( const PxFilterData& FilterData, const PxQueryHit& Hit ) override
 	{
-		return PxQueryHitType::eNONE;
+		return PxQueryHitType::eBLOCK;
 	}
 
-	// collision channels filter
-	ECollisionChannel SuspensionChannel = GetCollisionChannel(SuspensionData.word3);
+private:
+	PxFilterData SuspensionData;
+};
 
-	if ( ECC_TO_BITFIELD(SuspensionChannel) & HitData.word1)
+/**
+ * sweeps need a convex wheel shape, triangle mesh wheels can only be raycast
+ */
+static bool CanSweepSuspension_AssumesLocked( const PxVehicleWheels* PVehicle )
+{
+	const PxRigidDynamic* PActor = PVehicle->getRigidDynamicActor();
+	const PxU32 NumShapes = PActor->getNbShapes();
+
+	for ( PxU32 WheelIdx = 0; WheelIdx < PVehicle->mWheelsSimData.getNbWheels(); ++WheelIdx )
 	{
-		// debug what object we hit
-		if ( false )
+		const PxI32 ShapeIdx = PVehicle->mWheelsSimData.getWheelShapeMapping( WheelIdx );
+		if ( ShapeIdx < 0 || (PxU32)ShapeIdx >= NumShapes )
 		{
-			for ( FObjectIterator It; It; ++It )
-			{
-				if ( It->GetUniqueID() == HitData.word0 )
-				{
-					UObject* HitObj = *It;
-					FString HitObjName = HitObj->GetName();
-					break;
-				}
-			}
+			return false;
 		}
 
-		return PxQueryHitType::eBLOCK;
+		PxShape* PShape = nullptr;
+		PActor->getShapes( &PShape, 1, ShapeIdx );
+		if ( PShape == nullptr || PShape->getGeometryType() == PxGeometryType::eTRIANGLEMESH )
+		{
+			return false;
+		}
 	}
 
-	return PxQueryHitType::eNONE;
+	return true;
 }
 
 FPhysXVehicleManager::FPhysXVehicleManager(FPhysScene* PhysScene)
-	: WheelRaycastBatchQuery(NULL)
-
-#if PX_DEBUG_VEHICLE_ON
-	, TelemetryData4W(NULL)
-	, TelemetryVehicle(NULL)
-#endif
+	: NumKinematicVehicles(0)
+	, NumTelemetryVehicles(0)
+	, WheelRaycastBatchQuery(NULL)
+	, WheelSweepBatchQuery(NULL)
+	, SweepHitsPerWheel(FMath::Clamp(CVarVehicleSuspensionSweepHits.GetValueOnGameThread(), 1, 16))
+	, HeightfieldScene(NULL)
+	, HeightfieldSceneDispatcher(NULL)
+	, HeightfieldBatchQuery(NULL)
 {
 	// Save pointer to PhysX scene
 	Scene = PhysScene->GetPxScene();
@@ -95,6 +287,8 @@ FPhysXVehicleManager::FPhysXVehicleManager(FPhysScene* PhysScene)
 	// Set up delegates
 	OnPhysScenePreTickHandle = PhysScene->OnPhysScenePreTick.AddRaw(this, &FPhysXVehicleManager::PreTick);
 	OnPhysSceneStepHandle = PhysScene->OnPhysSceneStep.AddRaw(this, &FPhysXVehicleManager::Update);
+	OnWorldPostActorTickHandle = FWorldDelegates::OnWorldPostActorTick.AddRaw(this, &FPhysXVehicleManager::PostActorTick);
+	OnComponentDestroyPhysicsHandle = UActorComponent::GlobalDestroyPhysicsDelegate.AddRaw(this, &FPhysXVehicleManager::OnComponentDestroyPhysicsState);
 
 	// Add to map
 	FPhysXVehicleManager::SceneToVehicleManagerMap.Add(PhysScene, this);
@@ -108,21 +302,21 @@ void FPhysXVehicleManager::DetachFromPhysScene(FPhysScene* PhysScene)
 {
 	PhysScene->OnPhysScenePreTick.Remove(OnPhysScenePreTickHandle);
 	PhysScene->OnPhysSceneStep.Remove(OnPhysSceneStepHandle);
+	FWorldDelegates::OnWorldPostActorTick.Remove(OnWorldPostActorTickHandle);
+	UActorComponent::GlobalDestroyPhysicsDelegate.Remove(OnComponentDestroyPhysicsHandle);
 
 	FPhysXVehicleManager::SceneToVehicleManagerMap.Remove(PhysScene);
 }
 
 FPhysXVehicleManager::~FPhysXVehicleManager()
 {
-#if PX_DEBUG_VEHICLE_ON
-	if(TelemetryData4W)
-	{
-		TelemetryData4W->free();
-		TelemetryData4W = NULL;
-	}
+	StopReplayRecording();
+	StopReplayPlayback();
+	StopTelemetryExport();
 
-	TelemetryVehicle = NULL;
-#endif
+	FWorldDelegates::OnWorldPostActorTick.Remove(OnWorldPostActorTickHandle);
+	UActorComponent::GlobalDestroyPhysicsDelegate.Remove(OnComponentDestroyPhysicsHandle);
+	InstancedWheels.Reset();
 
 	// Remove the N-wheeled vehicles.
 	while( Vehicles.Num() > 0 )
@@ -137,6 +331,39 @@ FPhysXVehicleManager::~FPhysXVehicleManager()
 		WheelRaycastBatchQuery = NULL;
 	}
 
+	if ( WheelSweepBatchQuery )
+	{
+		WheelSweepBatchQuery->release();
+		WheelSweepBatchQuery = NULL;
+	}
+
+	// Release the heightfield scene and its proxy actors
+	for ( FHeightfieldTile& Tile : HeightfieldTiles )
+	{
+		HeightfieldScene->removeActor( *Tile.ProxyActor );
+		Tile.ProxyActor->release();
+	}
+	HeightfieldTiles.Empty();
+	HeightfieldShapes.Empty();
+
+	if ( HeightfieldBatchQuery )
+	{
+		HeightfieldBatchQuery->release();
+		HeightfieldBatchQuery = NULL;
+	}
+
+	if ( HeightfieldScene )
+	{
+		HeightfieldScene->release();
+		HeightfieldScene = NULL;
+	}
+
+	if ( HeightfieldSceneDispatcher )
+	{
+		HeightfieldSceneDispatcher->release();
+		HeightfieldSceneDispatcher = NULL;
+	}
+
 	// Release the  friction values used for combinations of tire type and surface type.
 	//if ( SurfaceTirePairs )
 	//{
@@ -169,6 +396,15 @@ UTireConfig* FPhysXVehicleManager::GetDefaultTireConfig()
 	return DefaultTireConfig;
 }
 
+PxFilterData FPhysXVehicleManager::PackSuspensionQueryFilterData( const PxFilterData& WheelQueryFilterData )
+{
+	// word0 (owner id) and word3 are kept as is, word1 and word2 of a wheel's query data are empty since wheels ignore every channel
+	PxFilterData SuspensionData = WheelQueryFilterData;
+	SuspensionData.word1 = ECC_TO_BITFIELD( GetCollisionChannel( WheelQueryFilterData.word3 ) );
+	SuspensionData.word2 = WheelQueryFilterData.word3 & (EPDF_SimpleCollision | EPDF_ComplexCollision);
+	return SuspensionData;
+}
+
 void FPhysXVehicleManager::UpdateTireFrictionTable()
 {
 	bUpdateTireFrictionTable = true;
@@ -176,6 +412,9 @@ void FPhysXVehicleManager::UpdateTireFrictionTable()
 
 void FPhysXVehicleManager::UpdateTireFrictionTableInternal()
 {
+	PHYSX_VEHICLE_TRACE_SCOPE(PhysXVehicle_UpdateTireFrictionTable);
+	PHYSX_VEHICLE_INC_COUNTER(STAT_PhysXVehicleManager_NumFrictionTableRebuilds);
+
 	const PxU32 MAX_NUM_MATERIALS = 128;
 
 	// There are tire types and then there are drivable surface types.
@@ -230,9 +469,9 @@ void FPhysXVehicleManager::SetUpBatchedSceneQuery()
 {
 	int32 NumWheels = 0;
 
-	for ( int32 v = PVehicles.Num() - 1; v >= 0; --v )
+	for ( int32 v = RaycastPVehicles.Num() - 1; v >= 0; --v )
 	{
-		NumWheels += PVehicles[v]->mWheelsSimData.getNbWheels();
+		NumWheels += RaycastPVehicles[v]->mWheelsSimData.getNbWheels();
 	}
 
 	if ( NumWheels > WheelQueryResults.Num() )
@@ -256,46 +495,73 @@ void FPhysXVehicleManager::SetUpBatchedSceneQuery()
 
 		WheelRaycastBatchQuery = Scene->createBatchQuery( SqDesc );
 	}
-}
 
-void FPhysXVehicleManager::AddVehicle( TWeakObjectPtr<UWheeledVehicleMovementComponent> Vehicle )
-{
-	check(Vehicle != NULL);
-	check(Vehicle->PVehicle);
+	int32 NumSweepWheels = 0;
 
-	Vehicles.Add( Vehicle );
-	PVehicles.Add( Vehicle->PVehicle );
+	for ( int32 v = SweepPVehicles.Num() - 1; v >= 0; --v )
+	{
+		NumSweepWheels += SweepPVehicles[v]->mWheelsSimData.getNbWheels();
+	}
 
-	// init wheels' states
-	int32 NewIndex = PVehiclesWheelsStates.AddZeroed();
-	PxU32 NumWheels = Vehicle->PVehicle->mWheelsSimData.getNbWheels();
-	PVehiclesWheelsStates[NewIndex].nbWheelQueryResults = NumWheels;
-	PVehiclesWheelsStates[NewIndex].wheelQueryResults = new PxWheelQueryResult[NumWheels];  
+	const int32 NumSweepHits = NumSweepWheels * SweepHitsPerWheel;
 
-	SetUpBatchedSceneQuery();
-}
+	if ( NumSweepWheels > WheelSweepResults.Num() || NumSweepHits > WheelSweepHits.Num() )
+	{
+		WheelSweepResults.AddZeroed( FMath::Max( NumSweepWheels - WheelSweepResults.Num(), 0 ) );
+		WheelSweepHits.AddZeroed( FMath::Max( NumSweepHits - WheelSweepHits.Num(), 0 ) );
 
-void FPhysXVehicleManager::RemoveVehicle( TWeakObjectPtr<UWheeledVehicleMovementComponent> Vehicle )
-{
-	check(Vehicle != NULL);
-	check(Vehicle->PVehicle);
+		if ( WheelSweepBatchQuery )
+		{
+			WheelSweepBatchQuery->release();
+			WheelSweepBatchQuery = NULL;
+		}
 
-	PxVehicleWheels* PVehicle = Vehicle->PVehicle;
+		PxBatchQueryDesc SqDesc(0, WheelSweepResults.Num(), 0);
+		SqDesc.queryMemory.userSweepResultBuffer = WheelSweepResults.GetData();
+		SqDesc.queryMemory.userSweepTouchBuffer = WheelSweepHits.GetData();
+		SqDesc.queryMemory.sweepTouchBufferSize = WheelSweepHits.Num();
+		SqDesc.preFilterShader = WheelSweepPreFilter;
 
-	int32 RemovedIndex = Vehicles.Find(Vehicle);
+		WheelSweepBatchQuery = Scene->createBatchQuery( SqDesc );
+	}
 
-	Vehicles.Remove( Vehicle );
-	PVehicles.Remove( PVehicle );
+	SetUpHeightfieldSceneQuery();
+}
 
-	delete[] PVehiclesWheelsStates[RemovedIndex].wheelQueryResults;
-	PVehiclesWheelsStates.RemoveAt(RemovedIndex); // LOC_MOD double check this
-	//PVehiclesWheelsStates.Remove(PVehiclesWheelsStates[RemovedIndex]);
+void FPhysXVehicleManager::SetUpHeightfieldSceneQuery()
+{
+	if ( HeightfieldScene == NULL || (HeightfieldBatchQuery && HeightfieldQueryResults.Num() >= WheelQueryResults.Num()) )
+	{
+		return;
+	}
+
+	// PxVehicleSuspensionRaycasts lays results out like the full scene batch, so both need the same capacity
+	HeightfieldQueryResults.AddZeroed( WheelQueryResults.Num() - HeightfieldQueryResults.Num() );
+	HeightfieldHitResults.AddZeroed( WheelHitResults.Num() - HeightfieldHitResults.Num() );
 
-	if ( PVehicle == TelemetryVehicle )
+	if ( HeightfieldBatchQuery )
 	{
-		TelemetryVehicle = NULL;
+		HeightfieldBatchQuery->release();
+		HeightfieldBatchQuery = NULL;
+	}
+
+	if ( HeightfieldQueryResults.Num() > 0 )
+	{
+		PxBatchQueryDesc SqDesc(HeightfieldQueryResults.Num(), 0, 0);
+		SqDesc.queryMemory.userRaycastResultBuffer = HeightfieldQueryResults.GetData();
+		SqDesc.queryMemory.userRaycastTouchBuffer = HeightfieldHitResults.GetData();
+		SqDesc.queryMemory.raycastTouchBufferSize = HeightfieldHitResults.Num();
+		SqDesc.preFilterShader = WheelRaycastPreFilter;
+
+		HeightfieldBatchQuery = HeightfieldScene->createBatchQuery( SqDesc );
 	}
+}
 
+/**
+ * free a PhysX vehicle of any type, its actor is left alone
+ */
+static void FreeVehicle( PxVehicleWheels* PVehicle )
+{
 	switch( PVehicle->getVehicleType() )
 	{
 	case PxVehicleTypes::eDRIVE4W:
@@ -316,173 +582,2098 @@ void FPhysXVehicleManager::RemoveVehicle( TWeakObjectPtr<UWheeledVehicleMovement
 	}
 }
 
-void FPhysXVehicleManager::Update(FPhysScene* PhysScene, float DeltaTime)
+void FPhysXVehicleManager::AddVehicle( TWeakObjectPtr<UWheeledVehicleMovementComponent> Vehicle )
 {
-	SCOPE_CYCLE_COUNTER(STAT_PhysXVehicleManager_Update);
+	check(Vehicle != NULL);
+	check(Vehicle->PVehicle);
 
-	// Only support vehicles in sync scene
-	if (Vehicles.Num() == 0 )
+	Vehicles.Add( Vehicle );
+	PVehicles.Add( Vehicle->PVehicle );
+	Vehicle->OwningVehicleManager = this;
+	Vehicle->VehicleManagerIndex = Vehicles.Num() - 1;
+
+	if ( TelemetryExporter )
 	{
-		return;
+		TelemetryExporter->RegisterVehicle( Vehicle.Get() );
 	}
 
-	if ( bUpdateTireFrictionTable )
+	// init wheels' states
+	int32 NewIndex = PVehiclesWheelsStates.AddZeroed();
+	PxU32 NumWheels = Vehicle->PVehicle->mWheelsSimData.getNbWheels();
+	PVehiclesWheelsStates[NewIndex].nbWheelQueryResults = NumWheels;
+	PVehiclesWheelsStates[NewIndex].wheelQueryResults = new PxWheelQueryResult[NumWheels];  
+
+	// Point the tire shader at the manager's copy of the wheel data, BindTireShaderData fills in the rest once the wheels exist
+	FTireShaderWheelData* WheelsTireShaderData = new FTireShaderWheelData[NumWheels]();
+	for ( PxU32 WheelIdx = 0; WheelIdx < NumWheels; ++WheelIdx )
 	{
-		SCOPE_CYCLE_COUNTER(STAT_PhysXVehicleManager_UpdateTireFrictionTable);
-		bUpdateTireFrictionTable = false;
-		UpdateTireFrictionTableInternal();
+		WheelsTireShaderData[WheelIdx].TireData = &Vehicle->PVehicle->mWheelsSimData.getTireData( WheelIdx );
+		Vehicle->PVehicle->mWheelsDynData.setTireForceShaderData( WheelIdx, &WheelsTireShaderData[WheelIdx] );
 	}
+	TireShaderData.Add( WheelsTireShaderData );
 
-	// Suspension raycasts
+	VehiclesTelemetry.AddDefaulted();
+
+	FKinematicLODState& KinematicLODState = KinematicLODStates.AddDefaulted_GetRef();
+	KinematicLODState.bWantsKinematic = false;
+	KinematicLODState.bKinematic = false;
+
+	// Reserve the vehicle's wheel world states and fill them once so the wheels can read them straight away
 	{
-		SCOPE_CYCLE_COUNTER(STAT_PhysXVehicleManager_PxVehicleSuspensionRaycasts);
 		SCOPED_SCENE_READ_LOCK(Scene);
-		PxVehicleSuspensionRaycasts( WheelRaycastBatchQuery, PVehicles.Num(), PVehicles.GetData(), WheelQueryResults.Num(), WheelQueryResults.GetData() );
+
+		const PxRigidDynamic* PActor = Vehicle->PVehicle->getRigidDynamicActor();
+		WheelOffsets.Add( WheelShapes.Num() );
+		ChassisPoses.Add( PActor->getGlobalPose() );
+		WheelWorldStates.AddZeroed( NumWheels );
+
+		const int32 FirstAnimData = WheelAnimData.AddZeroed( NumWheels );
+		for ( int32 WheelIdx = 0; WheelIdx < FMath::Min<int32>( NumWheels, Vehicle->WheelSetups.Num() ); ++WheelIdx )
+		{
+			WheelAnimData[FirstAnimData + WheelIdx].BoneName = Vehicle->WheelSetups[WheelIdx].BoneName;
+		}
+
+		for ( PxU32 WheelIdx = 0; WheelIdx < NumWheels; ++WheelIdx )
+		{
+			PxShape* PShape = nullptr;
+			const PxI32 ShapeIdx = Vehicle->PVehicle->mWheelsSimData.getWheelShapeMapping( WheelIdx );
+			if ( ShapeIdx >= 0 )
+			{
+				PActor->getShapes( &PShape, 1, ShapeIdx );
+			}
+			WheelShapes.Add( PShape );
+		}
+
+		UpdateWheelWorldStates_AssumesLocked( NewIndex, NewIndex + 1, 0.f );
 	}
-	
 
-	// Tick vehicles
+	bool bUseSweeps = false;
+	if ( Vehicle->bUseSuspensionSweeps )
 	{
-		SCOPE_CYCLE_COUNTER(STAT_PhysXVehicleManager_TickVehicles);
-		for (int32 i = Vehicles.Num() - 1; i >= 0; --i)
+		SCOPED_SCENE_READ_LOCK(Scene);
+		bUseSweeps = CanSweepSuspension_AssumesLocked( Vehicle->PVehicle );
+
+		if ( !bUseSweeps )
 		{
-			Vehicles[i]->TickVehicle(DeltaTime);
+			UE_LOG( LogVehicles, Warning, TEXT("Vehicle '%s' has wheel shapes that cannot be swept, using suspension raycasts instead"), *GetPathNameSafe( Vehicle.Get() ) );
 		}
 	}
 
-#if PX_DEBUG_VEHICLE_ON
+	// Force a query on the first step
+	FSuspensionQueryCoherence Coherence;
+	Coherence.LastQueryPose = PxTransform(PxIdentity);
+	Coherence.NumReuses = MAX_int32;
+	Coherence.WheelsStates = PVehiclesWheelsStates[NewIndex].wheelQueryResults;
+	Coherence.NumWheels = NumWheels;
+	Coherence.bOnHeightfield = false;
+	Coherence.NumHeightfieldQueries = 0;
+
+	// The query batches keep the partition order too, after the last vehicle with the same key
+	const uint32 PartitionKey = GetPartitionKey( Vehicle->PVehicle );
+	auto FindQueryInsertIndex = [PartitionKey]( const TArray<PxVehicleWheels*>& QueryPVehicles )
+	{
+		int32 InsertIndex = QueryPVehicles.Num();
+		while ( InsertIndex > 0 && GetPartitionKey( QueryPVehicles[InsertIndex - 1] ) > PartitionKey )
+		{
+			--InsertIndex;
+		}
+		return InsertIndex;
+	};
 
-	if ( TelemetryVehicle != NULL )
+	if ( bUseSweeps )
 	{
-		UpdateVehiclesWithTelemetry( DeltaTime );
+		const int32 SweepIndex = FindQueryInsertIndex( SweepPVehicles );
+		SweepPVehicles.Insert( Vehicle->PVehicle, SweepIndex );
+		SweepCoherence.Insert( Coherence, SweepIndex );
+		SweepQueryMask.Insert( true, SweepIndex );
 	}
 	else
 	{
-		UpdateVehicles( DeltaTime );
+		const int32 RaycastIndex = FindQueryInsertIndex( RaycastPVehicles );
+		RaycastPVehicles.Insert( Vehicle->PVehicle, RaycastIndex );
+		RaycastCoherence.Insert( Coherence, RaycastIndex );
+		RaycastQueryMask.Insert( true, RaycastIndex );
+		HeightfieldQueryMask.Insert( false, RaycastIndex );
 	}
 
-#else
+	InsertIntoPartition( NewIndex );
+	InstancedWheelVehicles.Reset();
 
-	UpdateVehicles( DeltaTime );
-
-#endif //PX_DEBUG_VEHICLE_ON
+	SetUpBatchedSceneQuery();
 }
 
-void FPhysXVehicleManager::PreTick(FPhysScene* PhysScene, float DeltaTime)
+void FPhysXVehicleManager::RemoveVehicle( TWeakObjectPtr<UWheeledVehicleMovementComponent> Vehicle )
 {
-	SCOPE_CYCLE_COUNTER(STAT_PhysXVehicleManager_PretickVehicles);
+	check(Vehicle != NULL);
+	check(Vehicle->PVehicle);
 
-	for (int32 i = 0; i < Vehicles.Num(); ++i)
+	PxVehicleWheels* PVehicle = Vehicle->PVehicle;
+
+	int32 RemovedIndex = Vehicles.Find(Vehicle);
+
+	// Hand the chassis back to the simulation, the body may outlive the vehicle
+	if ( KinematicLODStates[RemovedIndex].bKinematic )
 	{
-		Vehicles[i]->PreTick(DeltaTime);
+		SCOPED_SCENE_WRITE_LOCK(Scene);
+		PVehicle->getRigidDynamicActor()->setRigidBodyFlag( PxRigidBodyFlag::eKINEMATIC, false );
+		--NumKinematicVehicles;
+	}
+
+	InstancedWheelVehicles.Reset();
+	const int32 RaycastIndex = RaycastPVehicles.Find( PVehicle );
+	if ( RaycastIndex != INDEX_NONE )
+	{
+		RaycastPVehicles.RemoveAt( RaycastIndex );
+		RaycastCoherence.RemoveAt( RaycastIndex );
+		RaycastQueryMask.RemoveAt( RaycastIndex );
+		HeightfieldQueryMask.RemoveAt( RaycastIndex );
 	}
-}
 
+	const int32 SweepIndex = SweepPVehicles.Find( PVehicle );
+	if ( SweepIndex != INDEX_NONE )
+	{
+		SweepPVehicles.RemoveAt( SweepIndex );
+		SweepCoherence.RemoveAt( SweepIndex );
+		SweepQueryMask.RemoveAt( SweepIndex );
+	}
 
-void FPhysXVehicleManager::UpdateVehicles( float DeltaTime )
-{
-	SCOPE_CYCLE_COUNTER(STAT_PhysXVehicleManager_PxUpdateVehicles);
-	SCOPED_SCENE_WRITE_LOCK(Scene);
-	PxVehicleUpdates( DeltaTime, GetSceneGravity_AssumesLocked(), *SurfaceTirePairs, PVehicles.Num(), PVehicles.GetData(), PVehiclesWheelsStates.GetData());
+	delete[] PVehiclesWheelsStates[RemovedIndex].wheelQueryResults;
+	delete[] TireShaderData[RemovedIndex];
+
+	if ( VehiclesTelemetry[RemovedIndex] )
+	{
+		--NumTelemetryVehicles;
+	}
+
+	// Wheels are stored in registration order, close the gap and move the offsets of the vehicles behind it
+	const int32 FirstWheel = WheelOffsets[RemovedIndex];
+	const int32 NumRemovedWheels = GetNumWheels( RemovedIndex );
+	WheelWorldStates.RemoveAt( FirstWheel, NumRemovedWheels );
+	WheelAnimData.RemoveAt( FirstWheel, NumRemovedWheels, false );
+	WheelShapes.RemoveAt( FirstWheel, NumRemovedWheels );
+
+	for ( int32 i = 0; i < WheelOffsets.Num(); ++i )
+	{
+		if ( WheelOffsets[i] > FirstWheel )
+		{
+			WheelOffsets[i] -= NumRemovedWheels;
+		}
+	}
+
+	// Swap the vehicle out to the end of the arrays parallel to Vehicles and drop it
+	RemoveFromPartition( RemovedIndex );
+
+	Vehicle->OwningVehicleManager = nullptr;
+	Vehicle->VehicleManagerIndex = INDEX_NONE;
+
+	Vehicles.Pop( false );
+	PVehicles.Pop( false );
+	PVehiclesWheelsStates.Pop( false );
+	TireShaderData.Pop( false );
+	VehiclesTelemetry.Pop( false );
+	KinematicLODStates.Pop( false );
+	WheelOffsets.Pop( false );
+	ChassisPoses.Pop( false );
+
+	FreeVehicle( PVehicle );
 }
 
-PxVec3 FPhysXVehicleManager::GetSceneGravity_AssumesLocked()
+bool FPhysXVehicleManager::QueueVehicleCreation( TWeakObjectPtr<UWheeledVehicleMovementComponent> Vehicle )
 {
-	return Scene->getGravity();
+	check(Vehicle != NULL);
+
+	if ( CVarVehicleMaxCreationsPerFrame.GetValueOnGameThread() <= 0 )
+	{
+		return false;
+	}
+
+	PendingCreations.AddUnique( Vehicle );
+	return true;
 }
 
-void FPhysXVehicleManager::SetRecordTelemetry( TWeakObjectPtr<UWheeledVehicleMovementComponent> Vehicle, bool bRecord )
+void FPhysXVehicleManager::CancelVehicleCreation( TWeakObjectPtr<UWheeledVehicleMovementComponent> Vehicle )
 {
-#if PX_DEBUG_VEHICLE_ON
+	PendingCreations.Remove( Vehicle );
+}
 
-	if ( Vehicle != NULL && Vehicle->PVehicle != NULL )
+void FPhysXVehicleManager::CommitPendingCreations()
+{
+	if ( PendingCreations.Num() == 0 )
 	{
-		PxVehicleWheels* PVehicle = Vehicle->PVehicle;
+		return;
+	}
 
-		if ( bRecord )
-		{
-			int32 VehicleIndex = Vehicles.Find( Vehicle );
+	SCOPE_CYCLE_COUNTER(STAT_PhysXVehicleManager_CommitPendingCreations);
+	PHYSX_VEHICLE_TRACE_SCOPE(PhysXVehicle_CommitPendingCreations);
 
-			if ( VehicleIndex != INDEX_NONE )
-			{
-				// Make sure telemetry is setup
-				SetupTelemetryData();
+	// Setting the budget back to 0 flushes the queue
+	const int32 MaxCreations = CVarVehicleMaxCreationsPerFrame.GetValueOnGameThread();
+	const int32 NumToCommit = MaxCreations > 0 ? FMath::Min( MaxCreations, PendingCreations.Num() ) : PendingCreations.Num();
 
-				TelemetryVehicle = PVehicle;
+	// Take the batch out first, setting a vehicle up may queue or cancel others through physics state changes
+	TArray<TWeakObjectPtr<UWheeledVehicleMovementComponent>, TInlineAllocator<16>> Batch( PendingCreations.GetData(), NumToCommit );
+	PendingCreations.RemoveAt( 0, NumToCommit, false );
 
-				if ( VehicleIndex != 0 )
-				{
-					Vehicles.Swap( 0, VehicleIndex );
-					PVehicles.Swap( 0, VehicleIndex );
-					PVehiclesWheelsStates.Swap( 0, VehicleIndex );
-				}
-			}
-		}
-		else
+	for ( const TWeakObjectPtr<UWheeledVehicleMovementComponent>& Vehicle : Batch )
+	{
+		// Destroyed components never got to cancel, and one whose physics state went away since is not created again
+		if ( Vehicle.IsValid() && Vehicle->IsPhysicsStateCreated() && Vehicle->PVehicle == nullptr )
 		{
-			if ( PVehicle == TelemetryVehicle )
-			{
-				TelemetryVehicle = NULL;
-			}
+			Vehicle->FinishCreatePhysicsState();
 		}
 	}
 
-#endif
+	PHYSX_VEHICLE_INC_COUNTER_BY(STAT_PhysXVehicleManager_NumVehiclesPendingCreation, PendingCreations.Num());
 }
 
-#if PX_DEBUG_VEHICLE_ON
+uint32 FPhysXVehicleManager::GetPartitionKey( const PxVehicleWheels* PVehicle )
+{
+	return ( (uint32)PVehicle->getVehicleType() << 8 ) | PVehicle->mWheelsSimData.getNbWheels();
+}
 
-void FPhysXVehicleManager::SetupTelemetryData()
+void FPhysXVehicleManager::SwapVehicleSlots( int32 A, int32 B )
 {
-	// set up telemetry for 4 wheels
-	if(TelemetryData4W == NULL)
+	if ( A == B )
 	{
-		SCOPED_SCENE_WRITE_LOCK(Scene);
-
-		float Empty[] = { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f };
+		return;
+	}
 
-		TelemetryData4W = PxVehicleTelemetryData::allocate(4);
-		TelemetryData4W->setup(1.0f, 1.0f, 0.0f, 0.0f, Empty, Empty, PxVec3(0,0,0), PxVec3(0,0,0), PxVec3(0,0,0));
+	Vehicles.Swap( A, B );
+	PVehicles.Swap( A, B );
+	PVehiclesWheelsStates.Swap( A, B );
+	TireShaderData.Swap( A, B );
+	VehiclesTelemetry.Swap( A, B );
+	KinematicLODStates.Swap( A, B );
+	WheelOffsets.Swap( A, B );
+	ChassisPoses.Swap( A, B );
+
+	// Only the two vehicles that moved learn their new index
+	if ( UWheeledVehicleMovementComponent* VehicleA = Vehicles[A].Get() )
+	{
+		VehicleA->VehicleManagerIndex = A;
+	}
+	if ( UWheeledVehicleMovementComponent* VehicleB = Vehicles[B].Get() )
+	{
+		VehicleB->VehicleManagerIndex = B;
 	}
 }
 
-void FPhysXVehicleManager::UpdateVehiclesWithTelemetry( float DeltaTime )
+void FPhysXVehicleManager::InsertIntoPartition( int32 VehicleIdx )
 {
-	check(TelemetryVehicle);
-	check(PVehicles.Find(TelemetryVehicle) == 0);
+	check(VehicleIdx == Vehicles.Num() - 1);
 
-	SCOPED_SCENE_WRITE_LOCK(Scene);
-	if ( PxVehicleTelemetryData* TelemetryData = GetTelemetryData_AssumesLocked() )
-	{
-		PxVehicleUpdateSingleVehicleAndStoreTelemetryData( DeltaTime, GetSceneGravity_AssumesLocked(), *SurfaceTirePairs, TelemetryVehicle, PVehiclesWheelsStates.GetData(), *TelemetryData );
+	const uint32 Key = GetPartitionKey( PVehicles[VehicleIdx] );
 
-		if ( PVehicles.Num() > 1 )
-		{
-			PxVehicleUpdates( DeltaTime, GetSceneGravity_AssumesLocked(), *SurfaceTirePairs, PVehicles.Num() - 1, &PVehicles[1], &PVehiclesWheelsStates[1] );
-		}
+	int32 PartitionIdx = 0;
+	while ( PartitionIdx < VehiclePartitions.Num() && VehiclePartitions[PartitionIdx].Key < Key )
+	{
+		++PartitionIdx;
 	}
-	else
+
+	if ( PartitionIdx == VehiclePartitions.Num() || VehiclePartitions[PartitionIdx].Key != Key )
 	{
-		UE_LOG( LogPhysics, Warning, TEXT("Cannot record telemetry for vehicle, it does not have 4 wheels") );
+		FVehiclePartition NewPartition;
+		NewPartition.Key = Key;
+		NewPartition.First = PartitionIdx < VehiclePartitions.Num() ? VehiclePartitions[PartitionIdx].First : VehicleIdx;
+		NewPartition.Num = 0;
+		VehiclePartitions.Insert( NewPartition, PartitionIdx );
+	}
 
-		PxVehicleUpdates( DeltaTime, GetSceneGravity_AssumesLocked(), *SurfaceTirePairs, PVehicles.Num(), PVehicles.GetData(), PVehiclesWheelsStates.GetData() );
+	// Each later partition hands its first vehicle to its end, which walks the new vehicle down to the end of its own partition
+	for ( int32 LaterIdx = VehiclePartitions.Num() - 1; LaterIdx > PartitionIdx; --LaterIdx )
+	{
+		FVehiclePartition& Later = VehiclePartitions[LaterIdx];
+		SwapVehicleSlots( VehicleIdx, Later.First );
+		VehicleIdx = Later.First;
+		++Later.First;
 	}
+
+	check(VehicleIdx == VehiclePartitions[PartitionIdx].First + VehiclePartitions[PartitionIdx].Num);
+	++VehiclePartitions[PartitionIdx].Num;
 }
 
-PxVehicleTelemetryData* FPhysXVehicleManager::GetTelemetryData_AssumesLocked()
+void FPhysXVehicleManager::RemoveFromPartition( int32 VehicleIdx )
 {
-	if ( TelemetryVehicle )
+	int32 PartitionIdx = 0;
+	while ( VehicleIdx >= VehiclePartitions[PartitionIdx].First + VehiclePartitions[PartitionIdx].Num )
 	{
-		if ( TelemetryVehicle->mWheelsSimData.getNbWheels() == 4 )
-		{
-			return TelemetryData4W;
-		}
+		++PartitionIdx;
+	}
+
+	// Swap with the last vehicle of the partition, then each later partition moves its last vehicle into the hole in front of it
+	FVehiclePartition& Partition = VehiclePartitions[PartitionIdx];
+	--Partition.Num;
+	int32 Hole = Partition.First + Partition.Num;
+	SwapVehicleSlots( VehicleIdx, Hole );
+
+	for ( int32 LaterIdx = PartitionIdx + 1; LaterIdx < VehiclePartitions.Num(); ++LaterIdx )
+	{
+		FVehiclePartition& Later = VehiclePartitions[LaterIdx];
+		const int32 Last = Later.First + Later.Num - 1;
+		SwapVehicleSlots( Hole, Last );
+		--Later.First;
+		Hole = Last;
 	}
 
-	return nullptr;
+	check(Hole == Vehicles.Num() - 1);
+
+	if ( Partition.Num == 0 )
+	{
+		VehiclePartitions.RemoveAt( PartitionIdx );
+	}
 }
 
-#endif //PX_DEBUG_VEHICLE_ON
+void FPhysXVehicleManager::Update(FPhysScene* PhysScene, float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_PhysXVehicleManager_Update);
+	PHYSX_VEHICLE_TRACE_SCOPE(PhysXVehicle_Update);
+
+	// Only support vehicles in sync scene
+	if (Vehicles.Num() == 0 )
+	{
+		return;
+	}
+
+	if ( bUpdateTireFrictionTable )
+	{
+		SCOPE_CYCLE_COUNTER(STAT_PhysXVehicleManager_UpdateTireFrictionTable);
+		bUpdateTireFrictionTable = false;
+		UpdateTireFrictionTableInternal();
+
+		if ( TelemetryExporter )
+		{
+			TelemetryExporter->RegisterSurfaces();
+		}
+	}
+
+	// Replay playback overrides the inputs gathered in PreTick, so it has to happen before the vehicles tick
+	if ( ReplayRecorder || ReplayPlayer )
+	{
+		PHYSX_VEHICLE_LOCK_WAIT_BEGIN();
+		SCOPED_SCENE_WRITE_LOCK(Scene);
+		PHYSX_VEHICLE_LOCK_WAIT_END();
+
+		if ( ReplayPlayer )
+		{
+			DeltaTime = ReplayPlayer->ApplyInputs_AssumesLocked( DeltaTime, Vehicles );
+		}
+
+		if ( ReplayRecorder )
+		{
+			ReplayRecorder->RecordInputs_AssumesLocked( DeltaTime, Vehicles );
+		}
+	}
+
+	// Tier switches go before the suspension queries, so a vehicle back from the kinematic tier is queried this step
+	ApplyKinematicLODRequests();
+
+	PHYSX_VEHICLE_INC_COUNTER_BY(STAT_PhysXVehicleManager_NumVehiclesFull, PVehicles.Num() - NumKinematicVehicles);
+	PHYSX_VEHICLE_INC_COUNTER_BY(STAT_PhysXVehicleManager_NumVehiclesKinematic, NumKinematicVehicles);
+
+	const int32 DesiredSweepHitsPerWheel = FMath::Clamp( CVarVehicleSuspensionSweepHits.GetValueOnGameThread(), 1, 16 );
+	if ( DesiredSweepHitsPerWheel != SweepHitsPerWheel )
+	{
+		SweepHitsPerWheel = DesiredSweepHitsPerWheel;
+		SetUpBatchedSceneQuery();
+	}
+
+	int32 NumQueriedVehicles = 0;
+
+	// Suspension raycasts
+	if ( RaycastPVehicles.Num() > 0 )
+	{
+		SCOPE_CYCLE_COUNTER(STAT_PhysXVehicleManager_PxVehicleSuspensionRaycasts);
+		PHYSX_VEHICLE_TRACE_SCOPE(PhysXVehicle_SuspensionRaycasts);
+		PHYSX_VEHICLE_LOCK_WAIT_BEGIN();
+		SCOPED_SCENE_READ_LOCK(Scene);
+		PHYSX_VEHICLE_LOCK_WAIT_END();
+
+		// Vehicles left out of the mask reuse their cached hit planes in PxVehicleUpdates
+		NumQueriedVehicles += BuildSuspensionQueryMask_AssumesLocked( RaycastPVehicles, RaycastCoherence, RaycastQueryMask );
+		const int32 NumHeightfieldVehicles = BuildHeightfieldQueryMask();
+
+		PxVehicleSuspensionRaycasts( WheelRaycastBatchQuery, RaycastPVehicles.Num(), RaycastPVehicles.GetData(), WheelQueryResults.Num(), WheelQueryResults.GetData(), RaycastQueryMask.GetData() );
+
+		// PhysX resets the results of the vehicles a call masks out, so the heightfield vehicles get a call of their own over just them.
+		// The full scene call above masked them out, and this one leaves every other vehicle untouched
+		if ( NumHeightfieldVehicles > 0 )
+		{
+			SCOPE_CYCLE_COUNTER(STAT_PhysXVehicleManager_PxVehicleSuspensionRaycastsHeightfield);
+			PHYSX_VEHICLE_TRACE_SCOPE(PhysXVehicle_SuspensionRaycastsHeightfield);
+
+			PxVehicleSuspensionRaycasts( HeightfieldBatchQuery, HeightfieldPVehicles.Num(), HeightfieldPVehicles.GetData(), HeightfieldQueryResults.Num(), HeightfieldQueryResults.GetData() );
+
+#if PHYSX_VEHICLE_PROFILING && STATS
+			int32 NumHeightfieldWheels = 0;
+			for ( const PxVehicleWheels* HeightfieldPVehicle : HeightfieldPVehicles )
+			{
+				NumHeightfieldWheels += HeightfieldPVehicle->mWheelsSimData.getNbWheels();
+			}
+
+			INC_DWORD_STAT_BY(STAT_PhysXVehicleManager_NumWheelsRaycastHeightfield, NumHeightfieldWheels);
+#endif
+		}
+
+#if PHYSX_VEHICLE_PROFILING && STATS
+		if ( FThreadStats::IsCollectingData() )
+		{
+			int32 NumWheels = 0;
+			for ( int32 v = 0; v < RaycastPVehicles.Num(); ++v )
+			{
+				NumWheels += RaycastQueryMask[v] ? RaycastPVehicles[v]->mWheelsSimData.getNbWheels() : 0;
+			}
+
+			int32 NumHits = 0;
+			for ( int32 WheelIdx = 0; WheelIdx < NumWheels; ++WheelIdx )
+			{
+				NumHits += WheelQueryResults[WheelIdx].hasBlock ? 1 : 0;
+			}
+
+			INC_DWORD_STAT_BY(STAT_PhysXVehicleManager_NumWheelsRaycast, NumWheels);
+			INC_DWORD_STAT_BY(STAT_PhysXVehicleManager_NumRaycastHits, NumHits);
+		}
+#endif
+	}
+
+	// Suspension sweeps, kept as a separate stat so both modes can be compared on the same content
+	if ( SweepPVehicles.Num() > 0 )
+	{
+		SCOPE_CYCLE_COUNTER(STAT_PhysXVehicleManager_PxVehicleSuspensionSweeps);
+		PHYSX_VEHICLE_TRACE_SCOPE(PhysXVehicle_SuspensionSweeps);
+		PHYSX_VEHICLE_LOCK_WAIT_BEGIN();
+		SCOPED_SCENE_READ_LOCK(Scene);
+		PHYSX_VEHICLE_LOCK_WAIT_END();
+
+		NumQueriedVehicles += BuildSuspensionQueryMask_AssumesLocked( SweepPVehicles, SweepCoherence, SweepQueryMask );
+		PxVehicleSuspensionSweeps( WheelSweepBatchQuery, SweepPVehicles.Num(), SweepPVehicles.GetData(), WheelSweepResults.Num(), WheelSweepResults.GetData(), (PxU16)SweepHitsPerWheel, SweepQueryMask.GetData() );
+
+#if PHYSX_VEHICLE_PROFILING && STATS
+		if ( FThreadStats::IsCollectingData() )
+		{
+			int32 NumWheels = 0;
+			for ( int32 v = 0; v < SweepPVehicles.Num(); ++v )
+			{
+				NumWheels += SweepQueryMask[v] ? SweepPVehicles[v]->mWheelsSimData.getNbWheels() : 0;
+			}
+
+			int32 NumHits = 0;
+			for ( int32 WheelIdx = 0; WheelIdx < NumWheels; ++WheelIdx )
+			{
+				NumHits += WheelSweepResults[WheelIdx].getNbAnyHits();
+			}
+
+			INC_DWORD_STAT_BY(STAT_PhysXVehicleManager_NumWheelsSwept, NumWheels);
+			INC_DWORD_STAT_BY(STAT_PhysXVehicleManager_NumSweepHits, NumHits);
+		}
+#endif
+	}
+	
+
+#if PHYSX_VEHICLE_PROFILING && STATS
+	{
+		const int32 NumSkippedVehicles = PVehicles.Num() - NumQueriedVehicles;
+		INC_DWORD_STAT_BY(STAT_PhysXVehicleManager_NumSuspensionQueriesSkipped, NumSkippedVehicles);
+		SET_FLOAT_STAT(STAT_PhysXVehicleManager_SuspensionQuerySkipRate, 100.f * NumSkippedVehicles / PVehicles.Num());
+	}
+#endif
+
+	// Tick vehicles
+	{
+		SCOPE_CYCLE_COUNTER(STAT_PhysXVehicleManager_TickVehicles);
+		PHYSX_VEHICLE_TRACE_SCOPE(PhysXVehicle_TickVehicles);
+		if ( CVarVehicleParallelTick.GetValueOnGameThread() == 0 )
+		{
+			{
+				PHYSX_VEHICLE_LOCK_WAIT_BEGIN();
+				SCOPED_SCENE_READ_LOCK(Scene);
+				PHYSX_VEHICLE_LOCK_WAIT_END();
+				UpdateWheelWorldStates_AssumesLocked( 0, Vehicles.Num(), DeltaTime );
+			}
+
+			for (int32 i = Vehicles.Num() - 1; i >= 0; --i)
+			{
+				Vehicles[i]->TickVehicle(DeltaTime);
+			}
+		}
+		else
+		{
+			TickVehiclesParallel( DeltaTime );
+		}
+	}
+
+	UpdateVehicles( DeltaTime );
+
+	if ( ReplayRecorder || ReplayPlayer )
+	{
+		PHYSX_VEHICLE_TRACE_SCOPE(PhysXVehicle_Replay);
+		PHYSX_VEHICLE_LOCK_WAIT_BEGIN();
+		SCOPED_SCENE_READ_LOCK(Scene);
+		PHYSX_VEHICLE_LOCK_WAIT_END();
+
+		if ( ReplayRecorder )
+		{
+			ReplayRecorder->RecordOutputs_AssumesLocked( PVehicles, PVehiclesWheelsStates );
+		}
+
+		if ( ReplayPlayer )
+		{
+			ReplayPlayer->CompareOutputs_AssumesLocked( Vehicles, PVehicles, PVehiclesWheelsStates );
+		}
+	}
+
+	if ( ReplayPlayer && !ReplayPlayer->IsPlaying() )
+	{
+		StopReplayPlayback();
+	}
+}
+
+void FPhysXVehicleManager::FWheelWorldStates::AddZeroed( int32 Count )
+{
+	for ( TArray<float>* Channel : { &LocationX, &LocationY, &LocationZ, &RotationX, &RotationY, &RotationZ, &RotationW, &VelocityX, &VelocityY, &VelocityZ } )
+	{
+		Channel->AddZeroed( Count );
+	}
+}
+
+void FPhysXVehicleManager::FWheelWorldStates::RemoveAt( int32 Index, int32 Count )
+{
+	for ( TArray<float>* Channel : { &LocationX, &LocationY, &LocationZ, &RotationX, &RotationY, &RotationZ, &RotationW, &VelocityX, &VelocityY, &VelocityZ } )
+	{
+		Channel->RemoveAt( Index, Count, false );
+	}
+}
+
+void FPhysXVehicleManager::UpdateWheelWorldStates_AssumesLocked( int32 FirstVehicle, int32 EndVehicle, float DeltaTime )
+{
+	PHYSX_VEHICLE_TRACE_SCOPE(PhysXVehicle_UpdateWheelWorldStates);
+
+	const float InvDeltaTime = DeltaTime > 0.f ? 1.f / DeltaTime : 0.f;
+
+	for ( int32 v = FirstVehicle; v < EndVehicle; ++v )
+	{
+		ChassisPoses[v] = PVehicles[v]->getRigidDynamicActor()->getGlobalPose();
+	}
+
+	FWheelWorldStates& States = WheelWorldStates;
+	for ( int32 v = FirstVehicle; v < EndVehicle; ++v )
+	{
+		const PxTransform& ChassisPose = ChassisPoses[v];
+		const int32 FirstWheel = WheelOffsets[v];
+
+		DispatchWheelCount( GetNumWheels( v ), [this, &States, &ChassisPose, FirstWheel, InvDeltaTime]( auto NumWheels )
+		{
+			for ( int32 WheelIdx = 0; WheelIdx < NumWheels; ++WheelIdx )
+			{
+				const int32 w = FirstWheel + WheelIdx;
+				const PxTransform WheelPose = WheelShapes[w] ? ChassisPose.transform( WheelShapes[w]->getLocalPose() ) : ChassisPose;
+
+				States.VelocityX[w] = ( WheelPose.p.x - States.LocationX[w] ) * InvDeltaTime;
+				States.VelocityY[w] = ( WheelPose.p.y - States.LocationY[w] ) * InvDeltaTime;
+				States.VelocityZ[w] = ( WheelPose.p.z - States.LocationZ[w] ) * InvDeltaTime;
+
+				States.LocationX[w] = WheelPose.p.x;
+				States.LocationY[w] = WheelPose.p.y;
+				States.LocationZ[w] = WheelPose.p.z;
+
+				States.RotationX[w] = WheelPose.q.x;
+				States.RotationY[w] = WheelPose.q.y;
+				States.RotationZ[w] = WheelPose.q.z;
+				States.RotationW[w] = WheelPose.q.w;
+			}
+		});
+	}
+}
+
+void FPhysXVehicleManager::UpdateWheelAnimData_AssumesLocked()
+{
+	PHYSX_VEHICLE_TRACE_SCOPE(PhysXVehicle_UpdateWheelAnimData);
+
+	for ( int32 v = 0; v < PVehicles.Num(); ++v )
+	{
+		const PxVehicleWheelsDynData& DynData = PVehicles[v]->mWheelsDynData;
+		const PxWheelQueryResult* WheelsStates = PVehiclesWheelsStates[v].wheelQueryResults;
+		FWheelAnimData* VehicleAnimData = WheelAnimData.GetData() + WheelOffsets[v];
+
+		DispatchWheelCount( GetNumWheels( v ), [&DynData, WheelsStates, VehicleAnimData]( auto NumWheels )
+		{
+			for ( int32 WheelIdx = 0; WheelIdx < NumWheels; ++WheelIdx )
+			{
+				FWheelAnimData& AnimData = VehicleAnimData[WheelIdx];
+				AnimData.RotOffset.Pitch = -1.0f * FMath::RadiansToDegrees( DynData.getWheelRotationAngle( WheelIdx ) );
+				AnimData.RotOffset.Yaw = FMath::RadiansToDegrees( WheelsStates[WheelIdx].steerAngle );
+				AnimData.RotOffset.Roll = 0.f;
+
+				AnimData.LocOffset.X = 0.f;
+				AnimData.LocOffset.Y = 0.f;
+				AnimData.LocOffset.Z = WheelsStates[WheelIdx].suspJounce;
+			}
+		});
+	}
+}
+
+void FPhysXVehicleManager::BindTireShaderData( TWeakObjectPtr<UWheeledVehicleMovementComponent> Vehicle )
+{
+	const int32 VehicleIdx = Vehicles.Find( Vehicle );
+	check(VehicleIdx != INDEX_NONE);
+
+	FTireShaderWheelData* WheelsTireShaderData = TireShaderData[VehicleIdx];
+	const int32 NumWheels = FMath::Min( Vehicle->Wheels.Num(), GetNumWheels( VehicleIdx ) );
+	for ( int32 WheelIdx = 0; WheelIdx < NumWheels; ++WheelIdx )
+	{
+		UVehicleWheel* Wheel = Vehicle->Wheels[WheelIdx];
+		WheelsTireShaderData[WheelIdx].TireModel = Wheel->GetTireModel();
+		WheelsTireShaderData[WheelIdx].Wheel = Vehicle->bCallGenerateTireForces ? Wheel : nullptr;
+	}
+}
+
+void FPhysXVehicleManager::PublishTireShaderData()
+{
+	PHYSX_VEHICLE_TRACE_SCOPE(PhysXVehicle_PublishTireShaderData);
+
+	for ( int32 v = 0; v < Vehicles.Num(); ++v )
+	{
+		// Kinematic vehicles skipped PxVehicleUpdates and keep the values from their last full step
+		UWheeledVehicleMovementComponent* Vehicle = Vehicles[v].Get();
+		if ( !Vehicle || KinematicLODStates[v].bKinematic )
+		{
+			continue;
+		}
+
+		const FTireShaderWheelData* WheelsTireShaderData = TireShaderData[v];
+		const int32 NumWheels = FMath::Min( Vehicle->Wheels.Num(), GetNumWheels( v ) );
+		for ( int32 WheelIdx = 0; WheelIdx < NumWheels; ++WheelIdx )
+		{
+			const FTireShaderWheelData& WheelData = WheelsTireShaderData[WheelIdx];
+			UVehicleWheel* Wheel = Vehicle->Wheels[WheelIdx];
+			Wheel->DebugLongSlip = WheelData.LongSlip;
+			Wheel->DebugLatSlip = WheelData.LatSlip;
+			Wheel->DebugNormalizedTireLoad = WheelData.NormalizedTireLoad;
+			Wheel->DebugTireLoad = WheelData.TireLoad;
+			Wheel->DebugWheelTorque = WheelData.WheelTorque;
+			Wheel->DebugLongForce = WheelData.LongForce;
+			Wheel->DebugLatForce = WheelData.LatForce;
+		}
+	}
+}
+
+void FPhysXVehicleManager::TickVehiclesParallel( float DeltaTime )
+{
+	// Only the wheel world states go wide, they read PhysX and write the manager's own arrays. PhysX wants the lock taken by every
+	// thread using the scene, read locks are shared so each batch takes one
+	const int32 BatchSize = FMath::Max( CVarVehicleParallelTickBatchSize.GetValueOnGameThread(), 1 );
+	const int32 NumBatches = FMath::DivideAndRoundUp( Vehicles.Num(), BatchSize );
+
+	ParallelFor( NumBatches, [this, DeltaTime, BatchSize](int32 BatchIdx)
+	{
+		PHYSX_VEHICLE_TRACE_SCOPE(PhysXVehicle_TickVehicleBatch);
+		PHYSX_VEHICLE_LOCK_WAIT_BEGIN();
+		SCOPED_SCENE_READ_LOCK(Scene);
+		PHYSX_VEHICLE_LOCK_WAIT_END();
+
+		const int32 First = BatchIdx * BatchSize;
+		const int32 End = FMath::Min( First + BatchSize, Vehicles.Num() );
+		UpdateWheelWorldStates_AssumesLocked( First, End, DeltaTime );
+	}, NumBatches < 2 );
+
+	// Inputs and drag write the PhysX vehicles and the components write UObject state, keep them on the game thread under one write lock
+	PHYSX_VEHICLE_LOCK_WAIT_BEGIN();
+	SCOPED_SCENE_WRITE_LOCK(Scene);
+	PHYSX_VEHICLE_LOCK_WAIT_END();
+
+	for ( int32 i = 0; i < Vehicles.Num(); ++i )
+	{
+		UWheeledVehicleMovementComponent* Vehicle = Vehicles[i].Get();
+		Vehicle->TickVehicle_AssumesLocked( DeltaTime, ChassisPoses[i] );
+
+		// Mirror into the wheels' properties for gameplay code reading them
+		const int32 FirstWheel = WheelOffsets[i];
+		const int32 NumWheels = FMath::Min( Vehicle->Wheels.Num(), GetWheelOffsetEnd( i ) - FirstWheel );
+		for ( int32 WheelIdx = 0; WheelIdx < NumWheels; ++WheelIdx )
+		{
+			Vehicle->Wheels[WheelIdx]->SetWorldState( WheelWorldStates.GetLocation( FirstWheel + WheelIdx ), WheelWorldStates.GetVelocity( FirstWheel + WheelIdx ) );
+		}
+	}
+}
+
+int32 FPhysXVehicleManager::BuildHeightfieldQueryMask()
+{
+	if ( HeightfieldBatchQuery == NULL || HeightfieldShapes.Num() == 0 || CVarVehicleHeightfieldFastPath.GetValueOnGameThread() == 0 )
+	{
+		FMemory::Memzero( HeightfieldQueryMask.GetData(), HeightfieldQueryMask.Num() * sizeof(bool) );
+		HeightfieldPVehicles.Reset();
+		return 0;
+	}
+
+	const int32 RevalidateInterval = CVarVehicleHeightfieldRevalidateInterval.GetValueOnGameThread();
+
+	HeightfieldPVehicles.Reset();
+
+	for ( int32 v = 0; v < RaycastPVehicles.Num(); ++v )
+	{
+		FSuspensionQueryCoherence& VehicleCoherence = RaycastCoherence[v];
+
+		bool bHeightfield = false;
+		if ( RaycastQueryMask[v] )
+		{
+			bHeightfield = VehicleCoherence.bOnHeightfield && VehicleCoherence.NumHeightfieldQueries < RevalidateInterval;
+			VehicleCoherence.NumHeightfieldQueries = bHeightfield ? VehicleCoherence.NumHeightfieldQueries + 1 : 0;
+		}
+
+		RaycastQueryMask[v] = RaycastQueryMask[v] && !bHeightfield;
+		HeightfieldQueryMask[v] = bHeightfield;
+		if ( bHeightfield )
+		{
+			HeightfieldPVehicles.Add( RaycastPVehicles[v] );
+		}
+	}
+
+	return HeightfieldPVehicles.Num();
+}
+
+void FPhysXVehicleManager::UpdateHeightfieldContacts()
+{
+	for ( int32 v = 0; v < RaycastPVehicles.Num(); ++v )
+	{
+		// Reused hit planes say nothing new about what is under the wheels
+		if ( !RaycastQueryMask[v] && !HeightfieldQueryMask[v] )
+		{
+			continue;
+		}
+
+		FSuspensionQueryCoherence& VehicleCoherence = RaycastCoherence[v];
+
+		bool bOnHeightfield = true;
+		for ( PxU32 WheelIdx = 0; WheelIdx < VehicleCoherence.NumWheels && bOnHeightfield; ++WheelIdx )
+		{
+			const PxWheelQueryResult& WheelState = VehicleCoherence.WheelsStates[WheelIdx];
+			bOnHeightfield = !WheelState.isInAir && HeightfieldShapes.Contains( WheelState.tireContactShape );
+		}
+
+		VehicleCoherence.bOnHeightfield = bOnHeightfield;
+	}
+}
+
+void FPhysXVehicleManager::RegisterHeightfield( UPrimitiveComponent* Component )
+{
+	FBodyInstance* BodyInstance = Component ? Component->GetBodyInstance() : nullptr;
+	if ( BodyInstance == nullptr || HeightfieldTiles.ContainsByPredicate( [Component]( const FHeightfieldTile& Tile ) { return Tile.Component == Component; } ) )
+	{
+		return;
+	}
+
+	FPhysicsCommand::ExecuteRead(BodyInstance->ActorHandle, [&](const FPhysicsActorHandle& Actor)
+	{
+		PxRigidActor* PActor = FPhysicsInterface::GetPxRigidActor_AssumesLocked(Actor);
+		if ( PActor == nullptr || PActor->is<PxRigidStatic>() == nullptr )
+		{
+			return;
+		}
+
+		TArray<PxShape*> SourceShapes;
+		SourceShapes.AddUninitialized( PActor->getNbShapes() );
+		PActor->getShapes( SourceShapes.GetData(), SourceShapes.Num() );
+
+		FHeightfieldTile Tile;
+		Tile.Component = Component;
+		Tile.ProxyActor = NULL;
+
+		for ( PxShape* SourceShape : SourceShapes )
+		{
+			PxHeightFieldGeometry Geometry;
+			if ( !SourceShape->getHeightFieldGeometry( Geometry ) || !SourceShape->getFlags().isSet( PxShapeFlag::eSCENE_QUERY_SHAPE ) )
+			{
+				continue;
+			}
+
+			if ( HeightfieldScene == NULL )
+			{
+				PxSceneDesc SceneDesc( GPhysXSDK->getTolerancesScale() );
+				HeightfieldSceneDispatcher = PxDefaultCpuDispatcherCreate( 0 );
+				SceneDesc.cpuDispatcher = HeightfieldSceneDispatcher;
+				SceneDesc.filterShader = PxDefaultSimulationFilterShader;
+				HeightfieldScene = GPhysXSDK->createScene( SceneDesc );
+			}
+
+			if ( Tile.ProxyActor == NULL )
+			{
+				Tile.ProxyActor = GPhysXSDK->createRigidStatic( PActor->getGlobalPose() );
+				Tile.ProxyActor->userData = PActor->userData;
+			}
+
+			// Same geometry, materials and filter data, so tire friction and the suspension prefilter see no difference
+			TArray<PxMaterial*> Materials;
+			Materials.AddUninitialized( SourceShape->getNbMaterials() );
+			SourceShape->getMaterials( Materials.GetData(), Materials.Num() );
+
+			PxShape* ProxyShape = GPhysXSDK->createShape( Geometry, Materials.GetData(), Materials.Num(), true, PxShapeFlag::eSCENE_QUERY_SHAPE );
+			ProxyShape->setLocalPose( SourceShape->getLocalPose() );
+			ProxyShape->setQueryFilterData( SourceShape->getQueryFilterData() );
+			ProxyShape->userData = SourceShape->userData;
+			Tile.ProxyActor->attachShape( *ProxyShape );
+			ProxyShape->release();
+
+			Tile.Shapes.Add( SourceShape );
+			Tile.Shapes.Add( ProxyShape );
+		}
+
+		if ( Tile.ProxyActor )
+		{
+			HeightfieldScene->addActor( *Tile.ProxyActor );
+			HeightfieldScene->flushQueryUpdates();
+
+			HeightfieldShapes.Append( Tile.Shapes );
+			HeightfieldTiles.Add( MoveTemp( Tile ) );
+		}
+	});
+
+	SetUpHeightfieldSceneQuery();
+}
+
+void FPhysXVehicleManager::UnregisterHeightfield( UPrimitiveComponent* Component )
+{
+	const int32 TileIndex = HeightfieldTiles.IndexOfByPredicate( [Component]( const FHeightfieldTile& Tile ) { return Tile.Component == Component; } );
+	if ( TileIndex == INDEX_NONE )
+	{
+		return;
+	}
+
+	FHeightfieldTile& Tile = HeightfieldTiles[TileIndex];
+	for ( const PxShape* Shape : Tile.Shapes )
+	{
+		HeightfieldShapes.Remove( Shape );
+	}
+
+	HeightfieldScene->removeActor( *Tile.ProxyActor );
+	Tile.ProxyActor->release();
+	HeightfieldTiles.RemoveAtSwap( TileIndex );
+
+	// Contacts recorded on the removed tile are stale, let every vehicle query the full scene again
+	for ( FSuspensionQueryCoherence& VehicleCoherence : RaycastCoherence )
+	{
+		VehicleCoherence.bOnHeightfield = false;
+	}
+}
+
+void FPhysXVehicleManager::OnComponentDestroyPhysicsState( UActorComponent* Component )
+{
+	if ( HeightfieldTiles.Num() > 0 )
+	{
+		if ( UPrimitiveComponent* Primitive = Cast<UPrimitiveComponent>( Component ) )
+		{
+			UnregisterHeightfield( Primitive );
+		}
+	}
+}
+
+int32 FPhysXVehicleManager::BuildSuspensionQueryMask_AssumesLocked( const TArray<PxVehicleWheels*>& QueryPVehicles, TArray<FSuspensionQueryCoherence>& Coherence, TArray<bool>& QueryMask )
+{
+	const float ReuseDistance = CVarVehicleSuspensionReuseDistance.GetValueOnGameThread();
+	const float ReuseCosHalfAngle = FMath::Cos( FMath::DegreesToRadians( CVarVehicleSuspensionReuseAngle.GetValueOnGameThread() ) * 0.5f );
+	const int32 ReuseMaxAge = CVarVehicleSuspensionReuseMaxAge.GetValueOnGameThread();
+	const bool bAllowReuse = ReuseDistance > 0.f && ReuseMaxAge > 0;
+
+	int32 NumQueried = 0;
+
+	for ( int32 v = 0; v < QueryPVehicles.Num(); ++v )
+	{
+		FSuspensionQueryCoherence& VehicleCoherence = Coherence[v];
+		const PxRigidDynamic* PActor = QueryPVehicles[v]->getRigidDynamicActor();
+
+		// The kinematic LOD tier casts its own rays, force a query once the vehicle comes back
+		if ( PActor->getRigidBodyFlags() & PxRigidBodyFlag::eKINEMATIC )
+		{
+			VehicleCoherence.NumReuses = MAX_int32;
+			QueryMask[v] = false;
+			continue;
+		}
+
+		const PxTransform Pose = PActor->getGlobalPose();
+
+		bool bReuse = false;
+		if ( bAllowReuse && VehicleCoherence.NumReuses < ReuseMaxAge )
+		{
+			// |dot| of unit quaternions is the cosine of half the rotation between them
+			const bool bSamePosition = (Pose.p - VehicleCoherence.LastQueryPose.p).magnitudeSquared() < ReuseDistance * ReuseDistance;
+			const bool bSameRotation = FMath::Abs( Pose.q.dot( VehicleCoherence.LastQueryPose.q ) ) > ReuseCosHalfAngle;
+			bReuse = bSamePosition && bSameRotation;
+		}
+
+		if ( bReuse )
+		{
+			++VehicleCoherence.NumReuses;
+		}
+		else
+		{
+			VehicleCoherence.LastQueryPose = Pose;
+			VehicleCoherence.NumReuses = 0;
+			++NumQueried;
+		}
+
+		QueryMask[v] = !bReuse;
+	}
+
+	return NumQueried;
+}
+
+void FPhysXVehicleManager::PreTick(FPhysScene* PhysScene, float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_PhysXVehicleManager_PretickVehicles);
+	PHYSX_VEHICLE_TRACE_SCOPE(PhysXVehicle_PreTick);
+
+	// Vehicles set up now are ticked along with the rest this frame
+	CommitPendingCreations();
+
+	if ( CVarVehicleParallelInput.GetValueOnGameThread() == 0 )
+	{
+		for (int32 i = 0; i < Vehicles.Num(); ++i)
+		{
+			Vehicles[i]->PreTick(DeltaTime);
+		}
+		return;
+	}
+
+	// Game thread: auto reverse, avoidance and replicated inputs, everything that touches UObjects
+	InputPackets.Reset();
+	InputPacketVehicles.Reset();
+
+	for (int32 i = 0; i < Vehicles.Num(); ++i)
+	{
+		UWheeledVehicleMovementComponent* Vehicle = Vehicles[i].Get();
+		if ( Vehicle->UpdatedComponent && Cast<APawn>( Vehicle->UpdatedComponent->GetOwner() ) )
+		{
+			FVehicleInputPacket& Packet = InputPackets.AddUninitialized_GetRef();
+			if ( Vehicle->GatherInputPacket( DeltaTime, Packet ) )
+			{
+				InputPacketVehicles.Add( Vehicle );
+			}
+			else
+			{
+				InputPackets.Pop( false );
+			}
+		}
+	}
+
+	// Pure per vehicle input math
+	{
+		PHYSX_VEHICLE_TRACE_SCOPE(PhysXVehicle_InterpInputs);
+		ParallelFor( InputPackets.Num(), [this, DeltaTime](int32 PacketIdx)
+		{
+			InputPackets[PacketIdx].InterpInputs( DeltaTime );
+		}, InputPackets.Num() < CVarVehicleParallelInputMinBatch.GetValueOnGameThread() );
+	}
+
+	// Game thread: store the results and replicate them to the server
+	for (int32 i = 0; i < InputPacketVehicles.Num(); ++i)
+	{
+		InputPacketVehicles[i]->ApplyInputPacket( InputPackets[i] );
+	}
+
+	// Recreating physics state removes and re-adds vehicles, so it cannot happen while iterating Vehicles
+	TArray<UWheeledVehicleMovementComponent*, TInlineAllocator<4>> StaleVehicles;
+	for (int32 i = 0; i < Vehicles.Num(); ++i)
+	{
+		if ( Vehicles[i]->VehicleSetupTag != VehicleSetupTag )
+		{
+			StaleVehicles.Add( Vehicles[i].Get() );
+		}
+	}
+
+	for ( UWheeledVehicleMovementComponent* Vehicle : StaleVehicles )
+	{
+		Vehicle->RecreatePhysicsState();
+	}
+}
+
+
+void FPhysXVehicleManager::UpdateVehicles( float DeltaTime )
+{
+	SCOPE_CYCLE_COUNTER(STAT_PhysXVehicleManager_PxUpdateVehicles);
+	PHYSX_VEHICLE_TRACE_SCOPE(PhysXVehicle_PxVehicleUpdates);
+	PHYSX_VEHICLE_LOCK_WAIT_BEGIN();
+	SCOPED_SCENE_WRITE_LOCK(Scene);
+	PHYSX_VEHICLE_LOCK_WAIT_END();
+
+	// Leave the kinematic LOD tier out of the batch, the arrays only need rebuilding while it holds anyone
+	TArray<PxVehicleWheels*>* UpdatePVehicles = &PVehicles;
+	TArray<PxVehicleWheelQueryResult>* UpdateWheelsStates = &PVehiclesWheelsStates;
+	if ( NumKinematicVehicles > 0 )
+	{
+		FullPVehicles.Reset();
+		FullPVehiclesWheelsStates.Reset();
+		for ( int32 i = 0; i < PVehicles.Num(); ++i )
+		{
+			if ( !KinematicLODStates[i].bKinematic )
+			{
+				FullPVehicles.Add( PVehicles[i] );
+				FullPVehiclesWheelsStates.Add( PVehiclesWheelsStates[i] );
+			}
+		}
+
+		UpdatePVehicles = &FullPVehicles;
+		UpdateWheelsStates = &FullPVehiclesWheelsStates;
+	}
+
+#if PHYSX_VEHICLE_PROFILING && STATS
+	if ( FThreadStats::IsCollectingData() )
+	{
+		// Mirrors the sub-step selection PxVehicleUpdates makes from the current forward speed
+		int32 NumSubsteps = 0;
+		for ( int32 i = 0; i < PVehicles.Num(); ++i )
+		{
+			if ( KinematicLODStates[i].bKinematic )
+			{
+				continue;
+			}
+
+			const UWheeledVehicleMovementComponent* Vehicle = Vehicles[i].Get();
+			const float ThresholdSpeed = Vehicle->ThresholdLongitudinalSpeed * 100.f;
+			NumSubsteps += FMath::Abs( PVehicles[i]->computeForwardSpeed() ) < ThresholdSpeed ? Vehicle->LowForwardSpeedSubStepCount : Vehicle->HighForwardSpeedSubStepCount;
+		}
+
+		INC_DWORD_STAT_BY(STAT_PhysXVehicleManager_NumSubsteps, NumSubsteps);
+	}
+#endif
+
+	if ( UpdatePVehicles->Num() > 0 )
+	{
+		PxVehicleUpdates( DeltaTime, GetSceneGravity_AssumesLocked(), *SurfaceTirePairs, UpdatePVehicles->Num(), UpdatePVehicles->GetData(), UpdateWheelsStates->GetData() );
+	}
+
+	if ( NumKinematicVehicles > 0 )
+	{
+		UpdateKinematicVehicles_AssumesLocked( DeltaTime );
+	}
+
+	if ( HeightfieldShapes.Num() > 0 )
+	{
+		UpdateHeightfieldContacts();
+	}
+
+	UpdateWheelAnimData_AssumesLocked();
+
+	// Telemetry reads the wheels' Debug members
+	PublishTireShaderData();
+
+	if ( NumTelemetryVehicles > 0 )
+	{
+		SampleTelemetry_AssumesLocked();
+	}
+
+	if ( TelemetryExporter )
+	{
+		PHYSX_VEHICLE_TRACE_SCOPE(PhysXVehicle_TelemetryExport);
+		TelemetryExporter->Export_AssumesLocked( DeltaTime, Vehicles, PVehicles, PVehiclesWheelsStates );
+	}
+}
+
+PxVec3 FPhysXVehicleManager::GetSceneGravity_AssumesLocked()
+{
+	return Scene->getGravity();
+}
+
+void FPhysXVehicleManager::SetRecordTelemetry( TWeakObjectPtr<UWheeledVehicleMovementComponent> Vehicle, bool bRecord )
+{
+	if ( Vehicle == NULL || Vehicle->PVehicle == NULL )
+	{
+		return;
+	}
+
+	const int32 VehicleIndex = Vehicles.Find( Vehicle );
+	if ( VehicleIndex == INDEX_NONE || VehiclesTelemetry[VehicleIndex].IsValid() == bRecord )
+	{
+		return;
+	}
+
+	// Sampling happens under the write lock in UpdateVehicles
+	SCOPED_SCENE_WRITE_LOCK(Scene);
+
+	if ( bRecord )
+	{
+		VehiclesTelemetry[VehicleIndex] = MakeUnique<FPhysXVehicleTelemetry>( Vehicle->PVehicle->mWheelsSimData.getNbWheels() );
+		++NumTelemetryVehicles;
+	}
+	else
+	{
+		VehiclesTelemetry[VehicleIndex].Reset();
+		--NumTelemetryVehicles;
+	}
+}
+
+const FPhysXVehicleTelemetry* FPhysXVehicleManager::GetTelemetry_AssumesLocked( TWeakObjectPtr<const UWheeledVehicleMovementComponent> Vehicle ) const
+{
+	const int32 Index = Vehicles.IndexOfByKey( Vehicle );
+
+	return Index != INDEX_NONE ? VehiclesTelemetry[Index].Get() : nullptr;
+}
+
+void FPhysXVehicleManager::SampleTelemetry_AssumesLocked()
+{
+	PHYSX_VEHICLE_TRACE_SCOPE(PhysXVehicle_SampleTelemetry);
+
+	for ( int32 i = 0; i < VehiclesTelemetry.Num(); ++i )
+	{
+		if ( FPhysXVehicleTelemetry* Telemetry = VehiclesTelemetry[i].Get() )
+		{
+			Telemetry->Sample_AssumesLocked( PVehicles[i], PVehiclesWheelsStates[i], Vehicles[i]->Wheels );
+		}
+	}
+}
+
+void FPhysXVehicleManager::StartReplayRecording( const FString& Filename )
+{
+	StopReplayRecording();
+
+	ReplayRecorder = MakeUnique<FPhysXVehicleReplayRecorder>( Filename );
+	if ( !ReplayRecorder->IsRecording() )
+	{
+		ReplayRecorder.Reset();
+	}
+}
+
+void FPhysXVehicleManager::StopReplayRecording()
+{
+	ReplayRecorder.Reset();
+}
+
+void FPhysXVehicleManager::StartReplayPlayback( const FString& Filename )
+{
+	StopReplayPlayback();
+
+	ReplayPlayer = MakeUnique<FPhysXVehicleReplayPlayer>( Filename );
+	if ( !ReplayPlayer->IsPlaying() )
+	{
+		ReplayPlayer.Reset();
+	}
+}
+
+void FPhysXVehicleManager::StopReplayPlayback()
+{
+	if ( ReplayPlayer )
+	{
+		ReplayPlayer->LogReport();
+		ReplayPlayer.Reset();
+	}
+}
+
+void FPhysXVehicleManager::StartTelemetryExport( const FString& Filename, EVehicleTelemetryExportFormat Format )
+{
+	StopTelemetryExport();
+
+	TelemetryExporter = MakeUnique<FPhysXVehicleTelemetryExporter>( Filename, Format );
+	if ( !TelemetryExporter->IsExporting() )
+	{
+		TelemetryExporter.Reset();
+		return;
+	}
+
+	for ( const TWeakObjectPtr<UWheeledVehicleMovementComponent>& Vehicle : Vehicles )
+	{
+		TelemetryExporter->RegisterVehicle( Vehicle.Get() );
+	}
+}
+
+void FPhysXVehicleManager::StopTelemetryExport()
+{
+	TelemetryExporter.Reset();
+}
+
+void FPhysXVehicleManager::PostActorTick( UWorld* World, ELevelTick TickType, float DeltaTime )
+{
+	if ( World == nullptr || GetVehicleManagerFromScene( World->GetPhysicsScene() ) != this )
+	{
+		return;
+	}
+
+	// The simulation tier goes by every player this world knows about, the wheel visuals only by the local ones
+	TArray<FVector, TInlineAllocator<4>> PlayerLocations;
+	TArray<FVector, TInlineAllocator<4>> ViewLocations;
+	for ( FConstPlayerControllerIterator It = World->GetPlayerControllerIterator(); It; ++It )
+	{
+		if ( const APlayerController* PlayerController = It->Get() )
+		{
+			FVector ViewLocation;
+			FRotator ViewRotation;
+			PlayerController->GetPlayerViewPoint( ViewLocation, ViewRotation );
+			PlayerLocations.Add( ViewLocation );
+
+			if ( PlayerController->IsLocalController() )
+			{
+				ViewLocations.Add( ViewLocation );
+			}
+		}
+	}
+
+	UpdateKinematicLODRequests( PlayerLocations );
+
+	if ( World->GetNetMode() == NM_DedicatedServer )
+	{
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_PhysXVehicleManager_InstancedWheels);
+	PHYSX_VEHICLE_TRACE_SCOPE(PhysXVehicle_InstancedWheels);
+
+	const bool bAllowInstancedWheels = CVarVehicleInstancedWheels.GetValueOnGameThread() != 0 && ViewLocations.Num() > 0;
+
+	InstancedWheelVehicles.Reset();
+	for ( int32 v = 0; v < Vehicles.Num(); ++v )
+	{
+		UWheeledVehicleMovementComponent* Vehicle = Vehicles[v].Get();
+		if ( Vehicle == nullptr || Vehicle->InstancedWheelMesh == nullptr || Vehicle->UpdatedComponent == nullptr )
+		{
+			continue;
+		}
+
+		bool bFar = false;
+		if ( bAllowInstancedWheels )
+		{
+			// Switch back a little closer than we switched out, so vehicles on the threshold do not flip every frame
+			const float SwitchDistance = Vehicle->IsUsingInstancedWheels() ? Vehicle->InstancedWheelsDistance * 0.9f : Vehicle->InstancedWheelsDistance;
+			const FVector VehicleLocation = Vehicle->UpdatedComponent->GetComponentLocation();
+
+			bFar = true;
+			for ( const FVector& ViewLocation : ViewLocations )
+			{
+				bFar &= FVector::DistSquared( ViewLocation, VehicleLocation ) > FMath::Square( SwitchDistance );
+			}
+		}
+
+		Vehicle->SetUseInstancedWheels( bFar );
+		if ( Vehicle->IsUsingInstancedWheels() )
+		{
+			InstancedWheelVehicles.Add( v );
+		}
+	}
+
+	INC_DWORD_STAT_BY(STAT_PhysXVehicleManager_NumVehiclesInstancedWheels, InstancedWheelVehicles.Num());
+
+	if ( InstancedWheelVehicles.Num() > 0 || InstancedWheels )
+	{
+		WriteInstancedWheels( World, InstancedWheelVehicles );
+	}
+}
+
+void FPhysXVehicleManager::WriteInstancedWheels( UWorld* World, const TArray<int32>& Indices )
+{
+	if ( !InstancedWheels )
+	{
+		InstancedWheels = MakeUnique<FPhysXVehicleWheelInstances>( World );
+	}
+
+	InstancedWheels->BeginUpdate();
+
+	if ( Indices.Num() > 0 )
+	{
+		// The snapshot holds each wheel relative to the chassis pose it was read with, carry it over to the pose the scene ended up with
+		PHYSX_VEHICLE_LOCK_WAIT_BEGIN();
+		SCOPED_SCENE_READ_LOCK(Scene);
+		PHYSX_VEHICLE_LOCK_WAIT_END();
+
+		for ( int32 v : Indices )
+		{
+			const UWheeledVehicleMovementComponent* Vehicle = Vehicles[v].Get();
+			const PxTransform ChassisPose = PVehicles[v]->getRigidDynamicActor()->getGlobalPose();
+			const PxTransform InvSnapshotPose = ChassisPoses[v].getInverse();
+			const int32 EndWheel = GetWheelOffsetEnd( v );
+
+			for ( int32 w = WheelOffsets[v]; w < EndWheel; ++w )
+			{
+				const PxTransform SnapshotWheelPose( U2PVector( WheelWorldStates.GetLocation( w ) ), U2PQuat( WheelWorldStates.GetRotation( w ) ) );
+				const PxTransform WheelPose = ChassisPose.transform( InvSnapshotPose.transform( SnapshotWheelPose ) );
+				InstancedWheels->AddWheel( Vehicle->InstancedWheelMesh, Vehicle->InstancedWheelMeshTransform * P2UTransform( WheelPose ) );
+			}
+		}
+	}
+
+	InstancedWheels->EndUpdate();
+}
+
+void FPhysXVehicleManager::BenchmarkWheelVisuals( UWorld* World, int32 Iterations )
+{
+	TArray<int32> Indices;
+	TArray<USkeletalMeshComponent*> Meshes;
+	for ( int32 v = 0; v < Vehicles.Num(); ++v )
+	{
+		UWheeledVehicleMovementComponent* Vehicle = Vehicles[v].Get();
+		USkeletalMeshComponent* MeshComp = Vehicle ? Cast<USkeletalMeshComponent>( Vehicle->UpdatedComponent ) : nullptr;
+		if ( MeshComp && Vehicle->InstancedWheelMesh )
+		{
+			Indices.Add( v );
+			Meshes.Add( MeshComp );
+		}
+	}
+
+	if ( Indices.Num() == 0 || Iterations <= 0 )
+	{
+		UE_LOG( LogVehicles, Warning, TEXT("Wheel visuals benchmark: no vehicle with a skeletal mesh and an InstancedWheelMesh") );
+		return;
+	}
+
+	// Time the skeletal path on throwaway copies of the meshes, so the vehicles' own anim state and bones are left alone
+	TArray<USkeletalMeshComponent*> BenchMeshes;
+	for ( USkeletalMeshComponent* MeshComp : Meshes )
+	{
+		USkeletalMeshComponent* BenchMesh = NewObject<USkeletalMeshComponent>( MeshComp->GetOwner(), NAME_None, RF_Transient );
+		BenchMesh->SetCollisionEnabled( ECollisionEnabled::NoCollision );
+		BenchMesh->SetHiddenInGame( true );
+		BenchMesh->SetSkeletalMesh( MeshComp->SkeletalMesh );
+		BenchMesh->SetAnimInstanceClass( MeshComp->AnimClass );
+		BenchMesh->SetWorldTransform( MeshComp->GetComponentTransform() );
+		BenchMesh->RegisterComponentWithWorld( World );
+		BenchMeshes.Add( BenchMesh );
+	}
+
+	// Skeletal path: what a vehicle costs the game thread to spin and steer its wheels through its anim instance
+	const double SkeletalStartTime = FPlatformTime::Seconds();
+	for ( int32 Iteration = 0; Iteration < Iterations; ++Iteration )
+	{
+		for ( USkeletalMeshComponent* BenchMesh : BenchMeshes )
+		{
+			BenchMesh->TickAnimation( 1.f / 60.f, false );
+			BenchMesh->RefreshBoneTransforms();
+		}
+	}
+	const double SkeletalSeconds = FPlatformTime::Seconds() - SkeletalStartTime;
+
+	for ( USkeletalMeshComponent* BenchMesh : BenchMeshes )
+	{
+		BenchMesh->DestroyComponent();
+	}
+
+	// Instanced path: wheel transforms from the snapshot straight into the instance buffers
+	const double InstancedStartTime = FPlatformTime::Seconds();
+	for ( int32 Iteration = 0; Iteration < Iterations; ++Iteration )
+	{
+		WriteInstancedWheels( World, Indices );
+	}
+	const double InstancedSeconds = FPlatformTime::Seconds() - InstancedStartTime;
+
+	const double NumSamples = (double)Iterations * Indices.Num();
+	UE_LOG( LogVehicles, Display, TEXT("Wheel visuals benchmark, %d vehicles x %d iterations: skeletal %.2f us/vehicle, instanced %.2f us/vehicle (%.1fx)"),
+		Indices.Num(), Iterations, SkeletalSeconds * 1000000.0 / NumSamples, InstancedSeconds * 1000000.0 / NumSamples,
+		InstancedSeconds > 0.0 ? SkeletalSeconds / InstancedSeconds : 0.0 );
+
+	// Put back the instances the distance test asked for
+	WriteInstancedWheels( World, InstancedWheelVehicles );
+}
+
+void FPhysXVehicleManager::UpdateKinematicLODRequests( const TArray<FVector, TInlineAllocator<4>>& ViewLocations )
+{
+	const bool bAllowKinematic = CVarVehicleKinematicLOD.GetValueOnGameThread() != 0 && ViewLocations.Num() > 0;
+
+	for ( int32 v = 0; v < Vehicles.Num(); ++v )
+	{
+		FKinematicLODState& State = KinematicLODStates[v];
+		const UWheeledVehicleMovementComponent* Vehicle = Vehicles[v].Get();
+
+		State.bWantsKinematic = false;
+		if ( !bAllowKinematic || Vehicle == nullptr || Vehicle->KinematicLODDistance <= 0.f || Vehicle->UpdatedComponent == nullptr )
+		{
+			continue;
+		}
+
+		// Switch back a little closer than we switched out, so vehicles on the threshold do not flip every frame
+		const float SwitchDistance = State.bKinematic ? Vehicle->KinematicLODDistance * 0.9f : Vehicle->KinematicLODDistance;
+		const FVector VehicleLocation = Vehicle->UpdatedComponent->GetComponentLocation();
+
+		State.bWantsKinematic = true;
+		for ( const FVector& ViewLocation : ViewLocations )
+		{
+			State.bWantsKinematic &= FVector::DistSquared( ViewLocation, VehicleLocation ) > FMath::Square( SwitchDistance );
+		}
+	}
+}
+
+void FPhysXVehicleManager::ApplyKinematicLODRequests()
+{
+	const bool bAllowKinematic = CVarVehicleKinematicLOD.GetValueOnGameThread() != 0;
+
+	bool bAnySwitch = false;
+	for ( const FKinematicLODState& State : KinematicLODStates )
+	{
+		bAnySwitch |= ( State.bWantsKinematic && bAllowKinematic ) != State.bKinematic;
+	}
+
+	if ( !bAnySwitch )
+	{
+		return;
+	}
+
+	PHYSX_VEHICLE_LOCK_WAIT_BEGIN();
+	SCOPED_SCENE_WRITE_LOCK(Scene);
+	PHYSX_VEHICLE_LOCK_WAIT_END();
+
+	const PxVec3 GravityDir = GetSceneGravity_AssumesLocked().getNormalized();
+
+	for ( int32 v = 0; v < Vehicles.Num(); ++v )
+	{
+		FKinematicLODState& State = KinematicLODStates[v];
+		const bool bKinematic = State.bWantsKinematic && bAllowKinematic;
+		if ( bKinematic == State.bKinematic )
+		{
+			continue;
+		}
+
+		PxRigidDynamic* PActor = PVehicles[v]->getRigidDynamicActor();
+		if ( bKinematic )
+		{
+			// PhysX refuses kinematic bodies with CCD, those stay fully simulated
+			if ( PActor->getRigidBodyFlags() & PxRigidBodyFlag::eENABLE_CCD )
+			{
+				continue;
+			}
+
+			InitKinematicLODState_AssumesLocked( v, State );
+			PActor->setRigidBodyFlag( PxRigidBodyFlag::eKINEMATIC, true );
+			++NumKinematicVehicles;
+		}
+		else
+		{
+			// Hand speed and yaw rate back to the body and spin the wheels to match, so the drive picks up where the arcade model left off
+			const PxTransform Pose = PActor->getGlobalPose();
+			PActor->setRigidBodyFlag( PxRigidBodyFlag::eKINEMATIC, false );
+			PActor->setLinearVelocity( Pose.q.getBasisVector0() * State.ForwardSpeed + GravityDir * State.VerticalSpeed );
+			PActor->setAngularVelocity( Pose.q.getBasisVector2() * State.YawRate );
+			PActor->wakeUp();
+
+			PxVehicleWheels* PVehicle = PVehicles[v];
+			for ( PxU32 WheelIdx = 0; WheelIdx < PVehicle->mWheelsSimData.getNbWheels(); ++WheelIdx )
+			{
+				PVehicle->mWheelsDynData.setWheelRotationSpeed( WheelIdx, State.ForwardSpeed / PVehicle->mWheelsSimData.getWheelData( WheelIdx ).mRadius );
+			}
+
+			--NumKinematicVehicles;
+		}
+
+		State.bKinematic = bKinematic;
+	}
+}
+
+static const PxVehicleDriveSimData* GetDriveSimData( const PxVehicleWheels* PVehicle )
+{
+	switch( PVehicle->getVehicleType() )
+	{
+	case PxVehicleTypes::eDRIVE4W:
+		return &((const PxVehicleDrive4W*)PVehicle)->mDriveSimData;
+	case PxVehicleTypes::eDRIVENW:
+		return &((const PxVehicleDriveNW*)PVehicle)->mDriveSimData;
+	case PxVehicleTypes::eDRIVETANK:
+		return &((const PxVehicleDriveTank*)PVehicle)->mDriveSimData;
+	default:
+		return nullptr;
+	}
+}
+
+void FPhysXVehicleManager::InitKinematicLODState_AssumesLocked( int32 VehicleIndex, FKinematicLODState& State ) const
+{
+	const UWheeledVehicleMovementComponent* Vehicle = Vehicles[VehicleIndex].Get();
+	const PxVehicleWheels* PVehicle = PVehicles[VehicleIndex];
+	const PxVehicleWheelsSimData& WheelsSimData = PVehicle->mWheelsSimData;
+	const PxRigidDynamic* PActor = PVehicle->getRigidDynamicActor();
+	const PxTransform Pose = PActor->getGlobalPose();
+	const float Mass = FMath::Max( PActor->getMass(), KINDA_SMALL_NUMBER );
+
+	State.ForwardSpeed = PVehicle->computeForwardSpeed();
+	State.VerticalSpeed = 0.f;
+	State.YawRate = PActor->getAngularVelocity().dot( Pose.q.getBasisVector2() );
+
+	// Wheels a few cm apart along the chassis share an axle and a ray
+	const float AxleTolerance = 10.f;
+	State.Axles.Reset();
+	TArray<int32, TInlineAllocator<4>> AxleNumWheels;
+
+	float TotalRadius = 0.f;
+	float TotalBrakeForce = 0.f;
+	float TotalSpringStrength = 0.f;
+	float TotalSprungMass = 0.f;
+	State.MaxSteer = 0.f;
+
+	const int32 NumWheels = WheelsSimData.getNbWheels();
+	for ( int32 WheelIdx = 0; WheelIdx < NumWheels; ++WheelIdx )
+	{
+		const PxVehicleWheelData& WheelData = WheelsSimData.getWheelData( WheelIdx );
+		const PxVehicleSuspensionData& SuspensionData = WheelsSimData.getSuspensionData( WheelIdx );
+		const PxVec3 Offset = WheelsSimData.getWheelCentreOffset( WheelIdx );
+
+		TotalRadius += WheelData.mRadius;
+		TotalBrakeForce += WheelData.mMaxBrakeTorque / WheelData.mRadius;
+		TotalSpringStrength += SuspensionData.mSpringStrength;
+		TotalSprungMass += SuspensionData.mSprungMass;
+		State.MaxSteer = FMath::Max( State.MaxSteer, WheelData.mMaxSteer );
+
+		int32 AxleIdx = State.Axles.IndexOfByPredicate( [&Offset, AxleTolerance]( const FKinematicLODAxle& Axle ) { return FMath::Abs( Axle.LocalCentre.x - Offset.x ) < AxleTolerance; } );
+		if ( AxleIdx == INDEX_NONE )
+		{
+			AxleIdx = State.Axles.AddZeroed();
+			AxleNumWheels.Add( 0 );
+		}
+
+		// Running sums, averaged below
+		FKinematicLODAxle& Axle = State.Axles[AxleIdx];
+		Axle.LocalCentre += Offset;
+		Axle.Radius += WheelData.mRadius;
+		Axle.MaxCompression += SuspensionData.mMaxCompression;
+		Axle.MaxDroop += SuspensionData.mMaxDroop;
+		++AxleNumWheels[AxleIdx];
+	}
+
+	float MinAxleX = 0.f;
+	float MaxAxleX = 0.f;
+	for ( int32 AxleIdx = 0; AxleIdx < State.Axles.Num(); ++AxleIdx )
+	{
+		FKinematicLODAxle& Axle = State.Axles[AxleIdx];
+		const float InvNumWheels = 1.f / AxleNumWheels[AxleIdx];
+		Axle.LocalCentre *= InvNumWheels;
+		Axle.Radius *= InvNumWheels;
+		Axle.MaxCompression *= InvNumWheels;
+		Axle.MaxDroop *= InvNumWheels;
+
+		MinAxleX = AxleIdx == 0 ? Axle.LocalCentre.x : FMath::Min( MinAxleX, Axle.LocalCentre.x );
+		MaxAxleX = AxleIdx == 0 ? Axle.LocalCentre.x : FMath::Max( MaxAxleX, Axle.LocalCentre.x );
+	}
+
+	State.WheelBase = MaxAxleX - MinAxleX;
+	State.BrakeDecel = TotalBrakeForce / Mass;
+	State.SuspensionRate = TotalSprungMass > 0.f ? FMath::Sqrt( TotalSpringStrength / TotalSprungMass ) : 10.f;
+
+	const float AirDensity = 1.25 / (100 * 100 * 100); //kg/cm^3
+	State.DragFactor = 0.5f * AirDensity * Vehicle->DragCoefficient * Vehicle->ChassisHeight * Vehicle->ChassisWidth / Mass;
+
+	// Peak engine torque through first (or reverse) gear for the pull, the engine's top speed through the last gear for the cap.
+	// Vehicles without a drive get their wheel torques from gameplay code, they just hold their speed
+	State.DriveAccel = 0.f;
+	State.ReverseAccel = 0.f;
+	State.MaxForwardSpeed = BIG_NUMBER;
+	State.MaxReverseSpeed = BIG_NUMBER;
+
+	const PxVehicleDriveSimData* DriveSimData = GetDriveSimData( PVehicle );
+	if ( DriveSimData && NumWheels > 0 )
+	{
+		const PxVehicleEngineData& EngineData = DriveSimData->getEngineData();
+		const PxVehicleGearsData& GearsData = DriveSimData->getGearsData();
+		const float AverageRadius = TotalRadius / NumWheels;
+		const float FirstRatio = FMath::Abs( GearsData.getGearRatio( PxVehicleGearsData::eFIRST ) ) * GearsData.mFinalRatio;
+		const float TopRatio = FMath::Abs( GearsData.getGearRatio( (PxVehicleGearsData::Enum)( GearsData.getNbRatios() - 1 ) ) ) * GearsData.mFinalRatio;
+		const float ReverseRatio = FMath::Abs( GearsData.getGearRatio( PxVehicleGearsData::eREVERSE ) ) * GearsData.mFinalRatio;
+
+		State.DriveAccel = EngineData.mPeakTorque * FirstRatio / ( AverageRadius * Mass );
+		State.ReverseAccel = EngineData.mPeakTorque * ReverseRatio / ( AverageRadius * Mass );
+		State.MaxForwardSpeed = TopRatio > 0.f ? EngineData.mMaxOmega * AverageRadius / TopRatio : BIG_NUMBER;
+		State.MaxReverseSpeed = ReverseRatio > 0.f ? EngineData.mMaxOmega * AverageRadius / ReverseRatio : BIG_NUMBER;
+	}
+}
+
+PxTransform FPhysXVehicleManager::StepKinematicLOD_AssumesLocked( int32 VehicleIndex, FKinematicLODState& State, float DeltaTime ) const
+{
+	const UWheeledVehicleMovementComponent* Vehicle = Vehicles[VehicleIndex].Get();
+	const PxVehicleWheels* PVehicle = PVehicles[VehicleIndex];
+	const FReplicatedVehicleState Input = Vehicle->GetSimulationInputState();
+
+	const PxRigidDynamic* PActor = PVehicle->getRigidDynamicActor();
+	PxTransform Pose = PActor->getGlobalPose();
+
+	// Longitudinal: the engine pulls in the direction of the current gear and fades out towards the gear's top speed
+	float Direction = 1.f;
+	bool bDriven = State.DriveAccel > 0.f;
+	if ( Vehicle->PVehicleDrive )
+	{
+		const PxU32 CurrentGear = Vehicle->PVehicleDrive->mDriveDynData.getCurrentGear();
+		bDriven &= CurrentGear != PxVehicleGearsData::eNEUTRAL;
+		Direction = CurrentGear == PxVehicleGearsData::eREVERSE ? -1.f : 1.f;
+	}
+
+	float Accel = -State.DragFactor * State.ForwardSpeed * FMath::Abs( State.ForwardSpeed );
+	if ( bDriven )
+	{
+		const float MaxSpeed = Direction > 0.f ? State.MaxForwardSpeed : State.MaxReverseSpeed;
+		const float SpeedFraction = FMath::Clamp( State.ForwardSpeed * Direction / MaxSpeed, 0.f, 1.f );
+		Accel += Direction * Input.ThrottleInput * ( Direction > 0.f ? State.DriveAccel : State.ReverseAccel ) * ( 1.f - SpeedFraction );
+	}
+	State.ForwardSpeed += Accel * DeltaTime;
+
+	// Brakes never push the vehicle past standstill
+	const float BrakeDelta = FMath::Max( Input.BrakeInput, Input.HandbrakeInput ) * State.BrakeDecel * DeltaTime;
+	State.ForwardSpeed = FMath::Sign( State.ForwardSpeed ) * FMath::Max( FMath::Abs( State.ForwardSpeed ) - BrakeDelta, 0.f );
+
+	// Yaw: bicycle model around the rear axle
+	const float SteerAngle = Input.SteeringInput * State.MaxSteer;
+	State.YawRate = State.WheelBase > KINDA_SMALL_NUMBER ? State.ForwardSpeed * FMath::Tan( SteerAngle ) / State.WheelBase : 0.f;
+
+	const PxVec3 Up = Pose.q.getBasisVector2();
+	Pose.q = ( PxQuat( State.YawRate * DeltaTime, Up ) * Pose.q ).getNormalized();
+	Pose.p += Pose.q.getBasisVector0() * ( State.ForwardSpeed * DeltaTime );
+
+	// Suspension: one ray per axle, filtered like the suspension queries, each axle wants its wheels touching at rest jounce
+	const PxVec3 Gravity = Scene->getGravity();
+	const PxVec3 Down = -Pose.q.getBasisVector2();
+	const PxTransform CMassPose = Pose * PActor->getCMassLocalPose();
+
+	FSuspensionQueryFilterCallback QueryFilter( PVehicle->mWheelsSimData.getNbWheels() > 0 ? PVehicle->mWheelsSimData.getSceneQueryFilterData( 0 ) : PxFilterData() );
+	const PxQueryFilterData FilterData( PxQueryFlag::eSTATIC | PxQueryFlag::eDYNAMIC | PxQueryFlag::ePREFILTER );
+
+	float SumX = 0.f, SumError = 0.f, SumXX = 0.f, SumXError = 0.f;
+	int32 NumContacts = 0;
+	for ( const FKinematicLODAxle& Axle : State.Axles )
+	{
+		const PxVec3 Origin = CMassPose.transform( Axle.LocalCentre ) - Down * Axle.MaxCompression;
+		const float Length = Axle.MaxCompression + Axle.MaxDroop + Axle.Radius;
+
+		PxRaycastBuffer Hit;
+		if ( Scene->raycast( Origin, Down, Length, Hit, PxHitFlag::eDISTANCE, FilterData, &QueryFilter ) && Hit.hasBlock )
+		{
+			// How far the chassis has to rise for this axle to sit at rest
+			const float Error = Axle.MaxCompression + Axle.Radius - Hit.block.distance;
+			SumX += Axle.LocalCentre.x;
+			SumError += Error;
+			SumXX += Axle.LocalCentre.x * Axle.LocalCentre.x;
+			SumXError += Axle.LocalCentre.x * Error;
+			++NumContacts;
+		}
+	}
+
+	if ( NumContacts == 0 )
+	{
+		// Airborne, fall with gravity
+		State.VerticalSpeed += Gravity.magnitude() * DeltaTime;
+		Pose.p += Gravity.getNormalized() * ( State.VerticalSpeed * DeltaTime );
+	}
+	else
+	{
+		// Least squares fit of height and pitch to the axle errors, then settle towards it at the suspension's natural frequency
+		State.VerticalSpeed = 0.f;
+
+		const float MeanX = SumX / NumContacts;
+		const float MeanError = SumError / NumContacts;
+		const float VarianceX = SumXX / NumContacts - MeanX * MeanX;
+		const float Pitch = VarianceX > 1.f ? ( SumXError / NumContacts - MeanX * MeanError ) / VarianceX : 0.f;
+		const float Height = MeanError - Pitch * MeanX;
+		const float Blend = 1.f - FMath::Exp( -State.SuspensionRate * DeltaTime );
+
+		const PxVec3 Forward = Pose.q.getBasisVector0();
+		const PxVec3 SettledUp = Pose.q.getBasisVector2();
+		Pose.p += SettledUp * ( Height * Blend );
+		Pose.q = ( PxQuat( Pitch * Blend, Forward.cross( SettledUp ) ) * Pose.q ).getNormalized();
+	}
+
+	return Pose;
+}
+
+void FPhysXVehicleManager::UpdateKinematicVehicles_AssumesLocked( float DeltaTime )
+{
+	SCOPE_CYCLE_COUNTER(STAT_PhysXVehicleManager_KinematicLOD);
+	PHYSX_VEHICLE_TRACE_SCOPE(PhysXVehicle_KinematicLOD);
+
+	for ( int32 v = 0; v < PVehicles.Num(); ++v )
+	{
+		FKinematicLODState& State = KinematicLODStates[v];
+		if ( !State.bKinematic )
+		{
+			continue;
+		}
+
+		PxVehicleWheels* PVehicle = PVehicles[v];
+		PVehicle->getRigidDynamicActor()->setKinematicTarget( StepKinematicLOD_AssumesLocked( v, State, DeltaTime ) );
+
+		// Keep the wheels rolling for the anim data and for the switch back
+		for ( PxU32 WheelIdx = 0; WheelIdx < PVehicle->mWheelsSimData.getNbWheels(); ++WheelIdx )
+		{
+			const float RotationSpeed = State.ForwardSpeed / PVehicle->mWheelsSimData.getWheelData( WheelIdx ).mRadius;
+			PVehicle->mWheelsDynData.setWheelRotationSpeed( WheelIdx, RotationSpeed );
+			PVehicle->mWheelsDynData.setWheelRotationAngle( WheelIdx, PVehicle->mWheelsDynData.getWheelRotationAngle( WheelIdx ) + RotationSpeed * DeltaTime );
+		}
+	}
+}
+
+PxVehicleWheels* FPhysXVehicleManager::CloneVehicle_AssumesLocked( int32 VehicleIndex, PxScene& DestScene, FTireShaderWheelData*& OutTireShaderData ) const
+{
+	const PxVehicleWheels* PVehicle = PVehicles[VehicleIndex];
+	const PxRigidDynamic* PActor = PVehicle->getRigidDynamicActor();
+	const PxVehicleWheelsSimData& WheelsSimData = PVehicle->mWheelsSimData;
+	const PxU32 NumWheels = WheelsSimData.getNbWheels();
+
+	// Shapes keep their order, so the wheel shape mapping still holds
+	PxRigidDynamic* CloneActor = PxCloneDynamic( *GPhysXSDK, PActor->getGlobalPose(), *PActor );
+	if ( CloneActor == nullptr )
+	{
+		return nullptr;
+	}
+
+	DestScene.addActor( *CloneActor );
+	CloneActor->setLinearVelocity( PActor->getLinearVelocity() );
+	CloneActor->setAngularVelocity( PActor->getAngularVelocity() );
+
+	PxVehicleWheels* Clone = nullptr;
+	switch( PVehicle->getVehicleType() )
+	{
+	case PxVehicleTypes::eDRIVE4W:
+	{
+		const PxVehicleDrive4W* PVehicle4W = (const PxVehicleDrive4W*)PVehicle;
+		PxVehicleDrive4W* Clone4W = PxVehicleDrive4W::allocate( NumWheels );
+		Clone4W->setup( GPhysXSDK, CloneActor, WheelsSimData, PVehicle4W->mDriveSimData, NumWheels - 4 );
+		Clone4W->mDriveDynData = PVehicle4W->mDriveDynData;
+		Clone = Clone4W;
+		break;
+	}
+	case PxVehicleTypes::eDRIVENW:
+	{
+		const PxVehicleDriveNW* PVehicleNW = (const PxVehicleDriveNW*)PVehicle;
+		PxVehicleDriveNW* CloneNW = PxVehicleDriveNW::allocate( NumWheels );
+		CloneNW->setup( GPhysXSDK, CloneActor, WheelsSimData, PVehicleNW->mDriveSimData, NumWheels );
+		CloneNW->mDriveDynData = PVehicleNW->mDriveDynData;
+		Clone = CloneNW;
+		break;
+	}
+	case PxVehicleTypes::eDRIVETANK:
+	{
+		const PxVehicleDriveTank* PVehicleTank = (const PxVehicleDriveTank*)PVehicle;
+		PxVehicleDriveTank* CloneTank = PxVehicleDriveTank::allocate( NumWheels );
+		CloneTank->setup( GPhysXSDK, CloneActor, WheelsSimData, PVehicleTank->mDriveSimData, NumWheels );
+		CloneTank->setDriveModel( PVehicleTank->getDriveModel() );
+		CloneTank->mDriveDynData = PVehicleTank->mDriveDynData;
+		Clone = CloneTank;
+		break;
+	}
+	case PxVehicleTypes::eNODRIVE:
+	{
+		const PxVehicleNoDrive* PVehicleNoDrive = (const PxVehicleNoDrive*)PVehicle;
+		PxVehicleNoDrive* CloneNoDrive = PxVehicleNoDrive::allocate( NumWheels );
+		CloneNoDrive->setup( GPhysXSDK, CloneActor, WheelsSimData );
+		for ( PxU32 WheelIdx = 0; WheelIdx < NumWheels; ++WheelIdx )
+		{
+			CloneNoDrive->setDriveTorque( WheelIdx, PVehicleNoDrive->getDriveTorque( WheelIdx ) );
+			CloneNoDrive->setBrakeTorque( WheelIdx, PVehicleNoDrive->getBrakeTorque( WheelIdx ) );
+			CloneNoDrive->setSteerAngle( WheelIdx, PVehicleNoDrive->getSteerAngle( WheelIdx ) );
+		}
+		Clone = CloneNoDrive;
+		break;
+	}
+	default:
+		CloneActor->release();
+		return nullptr;
+	}
+
+	// Same tire model and shader, but the per sub-step outputs go to the clone's own copy
+	OutTireShaderData = new FTireShaderWheelData[NumWheels];
+	Clone->mWheelsDynData.setTireForceShaderFunction( PTireShader );
+	for ( PxU32 WheelIdx = 0; WheelIdx < NumWheels; ++WheelIdx )
+	{
+		OutTireShaderData[WheelIdx] = TireShaderData[VehicleIndex][WheelIdx];
+		OutTireShaderData[WheelIdx].TireData = &Clone->mWheelsSimData.getTireData( WheelIdx );
+		Clone->mWheelsDynData.setTireForceShaderData( WheelIdx, &OutTireShaderData[WheelIdx] );
+
+		Clone->mWheelsDynData.setWheelRotationSpeed( WheelIdx, PVehicle->mWheelsDynData.getWheelRotationSpeed( WheelIdx ) );
+		Clone->mWheelsDynData.setWheelRotationAngle( WheelIdx, PVehicle->mWheelsDynData.getWheelRotationAngle( WheelIdx ) );
+	}
+
+	return Clone;
+}
+
+void FPhysXVehicleManager::BenchmarkSimulationTiers( int32 Iterations )
+{
+	if ( Vehicles.Num() == 0 || Iterations <= 0 || SurfaceTirePairs == nullptr )
+	{
+		UE_LOG( LogVehicles, Warning, TEXT("Simulation tier benchmark: no simulated vehicle") );
+		return;
+	}
+
+	const float DeltaTime = 1.f / 60.f;
+
+	PHYSX_VEHICLE_LOCK_WAIT_BEGIN();
+	SCOPED_SCENE_WRITE_LOCK(Scene);
+	PHYSX_VEHICLE_LOCK_WAIT_END();
+
+	// Full tier: suspension queries and PxVehicleUpdates over clones of the vehicles PhysX drives, kept in a scene of their own.
+	// The queries still run against the live scene, but into buffers of their own
+	PxSceneDesc SceneDesc( GPhysXSDK->getTolerancesScale() );
+	PxDefaultCpuDispatcher* BenchDispatcher = PxDefaultCpuDispatcherCreate( 0 );
+	SceneDesc.cpuDispatcher = BenchDispatcher;
+	SceneDesc.filterShader = PxDefaultSimulationFilterShader;
+	PxScene* BenchScene = GPhysXSDK->createScene( SceneDesc );
+
+	TArray<PxVehicleWheels*> BenchPVehicles;
+	TArray<PxVehicleWheels*> BenchRaycastPVehicles;
+	TArray<PxVehicleWheels*> BenchSweepPVehicles;
+	TArray<PxVehicleWheelQueryResult> BenchWheelsStates;
+	TArray<FTireShaderWheelData*> BenchTireShaderData;
+	int32 NumRaycastWheels = 0;
+	int32 NumSweepWheels = 0;
+	for ( int32 v = 0; v < PVehicles.Num(); ++v )
+	{
+		if ( KinematicLODStates[v].bKinematic )
+		{
+			continue;
+		}
+
+		FTireShaderWheelData* CloneTireShaderData = nullptr;
+		PxVehicleWheels* Clone = CloneVehicle_AssumesLocked( v, *BenchScene, CloneTireShaderData );
+		if ( Clone == nullptr )
+		{
+			continue;
+		}
+
+		const PxU32 NumWheels = Clone->mWheelsSimData.getNbWheels();
+		BenchPVehicles.Add( Clone );
+		BenchTireShaderData.Add( CloneTireShaderData );
+
+		PxVehicleWheelQueryResult& WheelsStates = BenchWheelsStates.AddZeroed_GetRef();
+		WheelsStates.nbWheelQueryResults = NumWheels;
+		WheelsStates.wheelQueryResults = new PxWheelQueryResult[NumWheels];
+
+		if ( SweepPVehicles.Contains( PVehicles[v] ) )
+		{
+			BenchSweepPVehicles.Add( Clone );
+			NumSweepWheels += NumWheels;
+		}
+		else
+		{
+			BenchRaycastPVehicles.Add( Clone );
+			NumRaycastWheels += NumWheels;
+		}
+	}
+
+	TArray<PxRaycastQueryResult> BenchRaycastResults;
+	TArray<PxRaycastHit> BenchRaycastHits;
+	BenchRaycastResults.AddZeroed( NumRaycastWheels );
+	BenchRaycastHits.AddZeroed( NumRaycastWheels );
+
+	PxBatchQuery* BenchRaycastBatchQuery = NULL;
+	if ( NumRaycastWheels > 0 )
+	{
+		PxBatchQueryDesc SqDesc( NumRaycastWheels, 0, 0 );
+		SqDesc.queryMemory.userRaycastResultBuffer = BenchRaycastResults.GetData();
+		SqDesc.queryMemory.userRaycastTouchBuffer = BenchRaycastHits.GetData();
+		SqDesc.queryMemory.raycastTouchBufferSize = BenchRaycastHits.Num();
+		SqDesc.preFilterShader = WheelRaycastPreFilter;
+
+		BenchRaycastBatchQuery = Scene->createBatchQuery( SqDesc );
+	}
+
+	TArray<PxSweepQueryResult> BenchSweepResults;
+	TArray<PxSweepHit> BenchSweepHits;
+	BenchSweepResults.AddZeroed( NumSweepWheels );
+	BenchSweepHits.AddZeroed( NumSweepWheels * SweepHitsPerWheel );
+
+	PxBatchQuery* BenchSweepBatchQuery = NULL;
+	if ( NumSweepWheels > 0 )
+	{
+		PxBatchQueryDesc SqDesc( 0, NumSweepWheels, 0 );
+		SqDesc.queryMemory.userSweepResultBuffer = BenchSweepResults.GetData();
+		SqDesc.queryMemory.userSweepTouchBuffer = BenchSweepHits.GetData();
+		SqDesc.queryMemory.sweepTouchBufferSize = BenchSweepHits.Num();
+		SqDesc.preFilterShader = WheelSweepPreFilter;
+
+		BenchSweepBatchQuery = Scene->createBatchQuery( SqDesc );
+	}
+
+	const PxVec3 Gravity = GetSceneGravity_AssumesLocked();
+	double FullSeconds = 0.0;
+	if ( BenchPVehicles.Num() > 0 )
+	{
+		const double FullStartTime = FPlatformTime::Seconds();
+		for ( int32 Iteration = 0; Iteration < Iterations; ++Iteration )
+		{
+			if ( BenchRaycastBatchQuery )
+			{
+				PxVehicleSuspensionRaycasts( BenchRaycastBatchQuery, BenchRaycastPVehicles.Num(), BenchRaycastPVehicles.GetData(), BenchRaycastResults.Num(), BenchRaycastResults.GetData() );
+			}
+
+			if ( BenchSweepBatchQuery )
+			{
+				PxVehicleSuspensionSweeps( BenchSweepBatchQuery, BenchSweepPVehicles.Num(), BenchSweepPVehicles.GetData(), BenchSweepResults.Num(), BenchSweepResults.GetData(), (PxU16)SweepHitsPerWheel );
+			}
+
+			PxVehicleUpdates( DeltaTime, Gravity, *SurfaceTirePairs, BenchPVehicles.Num(), BenchPVehicles.GetData(), BenchWheelsStates.GetData() );
+		}
+		FullSeconds = FPlatformTime::Seconds() - FullStartTime;
+	}
+
+	if ( BenchRaycastBatchQuery )
+	{
+		BenchRaycastBatchQuery->release();
+	}
+
+	if ( BenchSweepBatchQuery )
+	{
+		BenchSweepBatchQuery->release();
+	}
+
+	for ( int32 CloneIdx = 0; CloneIdx < BenchPVehicles.Num(); ++CloneIdx )
+	{
+		PxRigidDynamic* CloneActor = BenchPVehicles[CloneIdx]->getRigidDynamicActor();
+		FreeVehicle( BenchPVehicles[CloneIdx] );
+		CloneActor->release();
+
+		delete[] BenchWheelsStates[CloneIdx].wheelQueryResults;
+		delete[] BenchTireShaderData[CloneIdx];
+	}
+
+	BenchScene->release();
+	BenchDispatcher->release();
+
+	// Kinematic tier: every vehicle as if it had switched, on copies of the state and without setting any target
+	TArray<FKinematicLODState> BenchStates;
+	for ( int32 v = 0; v < PVehicles.Num(); ++v )
+	{
+		FKinematicLODState& State = BenchStates.Add_GetRef( KinematicLODStates[v] );
+		if ( !State.bKinematic )
+		{
+			InitKinematicLODState_AssumesLocked( v, State );
+		}
+	}
+
+	const double KinematicStartTime = FPlatformTime::Seconds();
+	for ( int32 Iteration = 0; Iteration < Iterations; ++Iteration )
+	{
+		for ( int32 v = 0; v < BenchStates.Num(); ++v )
+		{
+			StepKinematicLOD_AssumesLocked( v, BenchStates[v], DeltaTime );
+		}
+	}
+	const double KinematicSeconds = FPlatformTime::Seconds() - KinematicStartTime;
+
+	const double FullVehiclesPerMs = FullSeconds > 0.0 ? (double)Iterations * BenchPVehicles.Num() / ( FullSeconds * 1000.0 ) : 0.0;
+	const double KinematicVehiclesPerMs = KinematicSeconds > 0.0 ? (double)Iterations * BenchStates.Num() / ( KinematicSeconds * 1000.0 ) : 0.0;
+	UE_LOG( LogVehicles, Display, TEXT("Simulation tier benchmark, %d iterations: full %d vehicles at %.1f vehicles/ms, kinematic %d vehicles at %.1f vehicles/ms (%.1fx)"),
+		Iterations, BenchPVehicles.Num(), FullVehiclesPerMs, BenchStates.Num(), KinematicVehiclesPerMs,
+		FullVehiclesPerMs > 0.0 ? KinematicVehiclesPerMs / FullVehiclesPerMs : 0.0 );
+}
+
+static FPhysXVehicleManager* GetVehicleManagerFromWorld( UWorld* World )
+{
+	return World ? FPhysXVehicleManager::GetVehicleManagerFromScene( World->GetPhysicsScene() ) : nullptr;
+}
+
+static FAutoConsoleCommandWithWorldAndArgs GVehicleReplayRecordCommand(
+	TEXT("p.Vehicle.ReplayRecord"),
+	TEXT("Record vehicle inputs and wheel states to a replay file. Usage: p.Vehicle.ReplayRecord [Filename]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		if ( FPhysXVehicleManager* VehicleManager = GetVehicleManagerFromWorld( World ) )
+		{
+			const FString Filename = Args.Num() > 0 ? Args[0] : FPaths::ProjectSavedDir() / TEXT("VehicleReplays") / (FDateTime::Now().ToString() + TEXT(".pxvr"));
+			VehicleManager->StartReplayRecording( Filename );
+		}
+	})
+);
+
+static FAutoConsoleCommandWithWorldAndArgs GVehicleReplayPlayCommand(
+	TEXT("p.Vehicle.ReplayPlay"),
+	TEXT("Re-simulate a vehicle replay file and report divergence and timings. Usage: p.Vehicle.ReplayPlay Filename"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		FPhysXVehicleManager* VehicleManager = GetVehicleManagerFromWorld( World );
+		if ( VehicleManager && Args.Num() > 0 )
+		{
+			VehicleManager->StartReplayPlayback( Args[0] );
+		}
+	})
+);
+
+static FAutoConsoleCommandWithWorldAndArgs GVehicleTelemetryExportCommand(
+	TEXT("p.Vehicle.TelemetryExport"),
+	TEXT("Stream wheel, engine and gear channels of all vehicles to a file. Usage: p.Vehicle.TelemetryExport [csv|bin] [Filename]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		if ( FPhysXVehicleManager* VehicleManager = GetVehicleManagerFromWorld( World ) )
+		{
+			const bool bColumnar = Args.Num() > 0 && Args[0] == TEXT("bin");
+			const FString Filename = Args.Num() > 1 ? Args[1] : FPaths::ProjectSavedDir() / TEXT("VehicleTelemetry") / (FDateTime::Now().ToString() + (bColumnar ? TEXT(".pxvt") : TEXT(".csv")));
+			VehicleManager->StartTelemetryExport( Filename, bColumnar ? EVehicleTelemetryExportFormat::Columnar : EVehicleTelemetryExportFormat::Csv );
+		}
+	})
+);
+
+static FAutoConsoleCommandWithWorldAndArgs GVehicleTelemetryExportStopCommand(
+	TEXT("p.Vehicle.TelemetryExportStop"),
+	TEXT("Stop the vehicle telemetry export"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		if ( FPhysXVehicleManager* VehicleManager = GetVehicleManagerFromWorld( World ) )
+		{
+			VehicleManager->StopTelemetryExport();
+		}
+	})
+);
+
+static FAutoConsoleCommandWithWorldAndArgs GVehicleRegisterHeightfieldsCommand(
+	TEXT("p.Vehicle.RegisterHeightfields"),
+	TEXT("Register every static heightfield of the world, such as landscape collision, for the suspension fast path. Usage: p.Vehicle.RegisterHeightfields [0 to unregister]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		if ( FPhysXVehicleManager* VehicleManager = GetVehicleManagerFromWorld( World ) )
+		{
+			const bool bRegister = Args.Num() == 0 || FCString::Atoi( *Args[0] ) != 0;
+			for ( TObjectIterator<UPrimitiveComponent> It; It; ++It )
+			{
+				if ( It->GetWorld() == World && It->Mobility == EComponentMobility::Static )
+				{
+					if ( bRegister )
+					{
+						VehicleManager->RegisterHeightfield( *It );
+					}
+					else
+					{
+						VehicleManager->UnregisterHeightfield( *It );
+					}
+				}
+			}
+		}
+	})
+);
+
+static FAutoConsoleCommandWithWorldAndArgs GVehicleBenchmarkWheelVisualsCommand(
+	TEXT("p.Vehicle.BenchmarkWheelVisuals"),
+	TEXT("Time skeletal against instanced wheels on every vehicle with an InstancedWheelMesh. Usage: p.Vehicle.BenchmarkWheelVisuals [Iterations]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		if ( FPhysXVehicleManager* VehicleManager = GetVehicleManagerFromWorld( World ) )
+		{
+			VehicleManager->BenchmarkWheelVisuals( World, Args.Num() > 0 ? FCString::Atoi( *Args[0] ) : 100 );
+		}
+	})
+);
+
+static FAutoConsoleCommandWithWorldAndArgs GVehicleBenchmarkSimulationTiersCommand(
+	TEXT("p.Vehicle.BenchmarkSimulationTiers"),
+	TEXT("Time the full PhysX simulation against the kinematic LOD tier on every vehicle and log vehicles per millisecond. Usage: p.Vehicle.BenchmarkSimulationTiers [Iterations]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		if ( FPhysXVehicleManager* VehicleManager = GetVehicleManagerFromWorld( World ) )
+		{
+			VehicleManager->BenchmarkSimulationTiers( Args.Num() > 0 ? FCString::Atoi( *Args[0] ) : 100 );
+		}
+	})
+);
+
+#if WITH_EDITOR
+static FAutoConsoleCommandWithWorldAndArgs GVehicleCompileSimSetupsCommand(
+	TEXT("p.Vehicle.CompileSimSetups"),
+	TEXT("Capture the sim data of every vehicle with a CompiledSimSetup into that asset, to be saved and cooked with it. Run in PIE"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		for ( TObjectIterator<UWheeledVehicleMovementComponent> It; It; ++It )
+		{
+			if ( It->GetWorld() == World && It->CompiledSimSetup )
+			{
+				It->CompileSimSetup();
+			}
+		}
+	})
+);
+#endif // WITH_EDITOR
+
+static FAutoConsoleCommandWithWorldAndArgs GVehicleReplayStopCommand(
+	TEXT("p.Vehicle.ReplayStop"),
+	TEXT("Stop vehicle replay recording and playback"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		if ( FPhysXVehicleManager* VehicleManager = GetVehicleManagerFromWorld( World ) )
+		{
+			VehicleManager->StopReplayRecording();
+			VehicleManager->StopReplayPlayback();
+		}
+	})
+);
 
 PxWheelQueryResult* FPhysXVehicleManager::GetWheelsStates_AssumesLocked(TWeakObjectPtr<const UWheeledVehicleMovementComponent> Vehicle)
 {
@@ -0,0 +1,506 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "PhysXVehicleReplay.h"
+#include "PhysXVehicleAsyncWriter.h"
+#include "PhysXVehicleManager.h"
+#include "PhysXPublic.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/FileHelper.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+PRAGMA_DISABLE_DEPRECATION_WARNINGS
+
+#if WITH_PHYSX_VEHICLES
+
+namespace PhysXVehicleReplay
+{
+	// 'PXVR'
+	static const uint32 FileMagic = 0x52565850;
+	// 2: initial chassis and spin state in the first frame of each vehicle
+	// 3: track thrust
+	static const uint32 FileVersion = 3;
+
+	// Recorder streams 64KB blocks, at most 16 of them in flight
+	static const int32 WriterBlockSize = 64 * 1024;
+	static const int32 WriterMaxBlocks = 16;
+
+	// Relative difference above which a wheel channel is considered diverged
+	static const float DivergenceTolerance = 1.e-4f;
+
+	static uint32 GetVehicleId(TMap<TWeakObjectPtr<UWheeledVehicleMovementComponent>, uint32>& VehicleIds, UWheeledVehicleMovementComponent* Vehicle)
+	{
+		if (const uint32* CachedId = VehicleIds.Find(Vehicle))
+		{
+			return *CachedId;
+		}
+
+		const uint32 VehicleId = GetTypeHash(Vehicle->GetPathName());
+		VehicleIds.Add(Vehicle, VehicleId);
+		return VehicleId;
+	}
+
+	static float GetRelativeError(float Recorded, float Simulated)
+	{
+		return FMath::Abs(Simulated - Recorded) / FMath::Max(1.f, FMath::Abs(Recorded));
+	}
+
+	static void CaptureInitialState(const PxVehicleWheels* PVehicle, FPhysXVehicleReplayInitialState& InitialState)
+	{
+		const PxRigidDynamic* PActor = PVehicle->getRigidDynamicActor();
+		const PxTransform PPose = PActor->getGlobalPose();
+
+		InitialState.ChassisLocation = P2UVector(PPose.p);
+		InitialState.ChassisRotation = P2UQuat(PPose.q);
+		InitialState.LinearVelocity = P2UVector(PActor->getLinearVelocity());
+		InitialState.AngularVelocity = P2UVector(PActor->getAngularVelocity());
+		InitialState.EngineRotationSpeed = PVehicle->getVehicleType() != PxVehicleTypes::eNODRIVE ? ((const PxVehicleDrive*)PVehicle)->mDriveDynData.getEngineRotationSpeed() : 0.f;
+
+		const int32 NumWheels = PVehicle->mWheelsSimData.getNbWheels();
+		InitialState.WheelRotationSpeeds.SetNum(NumWheels, false);
+		for (int32 WheelIdx = 0; WheelIdx < NumWheels; ++WheelIdx)
+		{
+			InitialState.WheelRotationSpeeds[WheelIdx] = PVehicle->mWheelsDynData.getWheelRotationSpeed(WheelIdx);
+		}
+	}
+
+	static void RestoreInitialState(PxVehicleWheels* PVehicle, const FPhysXVehicleReplayInitialState& InitialState)
+	{
+		PxRigidDynamic* PActor = PVehicle->getRigidDynamicActor();
+		PActor->setGlobalPose(PxTransform(U2PVector(InitialState.ChassisLocation), U2PQuat(InitialState.ChassisRotation)));
+
+		// Vehicles in the kinematic LOD tier have no velocity of their own
+		if (!(PActor->getRigidBodyFlags() & PxRigidBodyFlag::eKINEMATIC))
+		{
+			PActor->setLinearVelocity(U2PVector(InitialState.LinearVelocity));
+			PActor->setAngularVelocity(U2PVector(InitialState.AngularVelocity));
+		}
+
+		if (PVehicle->getVehicleType() != PxVehicleTypes::eNODRIVE)
+		{
+			((PxVehicleDrive*)PVehicle)->mDriveDynData.setEngineRotationSpeed(InitialState.EngineRotationSpeed);
+		}
+
+		const int32 NumWheels = FMath::Min<int32>(InitialState.WheelRotationSpeeds.Num(), PVehicle->mWheelsSimData.getNbWheels());
+		for (int32 WheelIdx = 0; WheelIdx < NumWheels; ++WheelIdx)
+		{
+			PVehicle->mWheelsDynData.setWheelRotationSpeed(WheelIdx, InitialState.WheelRotationSpeeds[WheelIdx]);
+		}
+	}
+}
+
+FArchive& operator<<(FArchive& Ar, FPhysXVehicleReplayWheel& Wheel)
+{
+	Ar << Wheel.SuspJounce;
+	Ar << Wheel.SuspSpringForce;
+	Ar << Wheel.TireFriction;
+	Ar << Wheel.LongSlip;
+	Ar << Wheel.LatSlip;
+	Ar << Wheel.SteerAngle;
+	Ar << Wheel.RotationSpeed;
+
+	uint8 InAir = Wheel.bInAir ? 1 : 0;
+	Ar << InAir;
+	Wheel.bInAir = InAir != 0;
+
+	return Ar;
+}
+
+FArchive& operator<<(FArchive& Ar, FPhysXVehicleReplayInitialState& InitialState)
+{
+	Ar << InitialState.ChassisLocation;
+	Ar << InitialState.ChassisRotation;
+	Ar << InitialState.LinearVelocity;
+	Ar << InitialState.AngularVelocity;
+	Ar << InitialState.EngineRotationSpeed;
+
+	uint8 NumWheels = (uint8)InitialState.WheelRotationSpeeds.Num();
+	Ar << NumWheels;
+
+	if (Ar.IsLoading())
+	{
+		InitialState.WheelRotationSpeeds.SetNum(NumWheels);
+	}
+
+	for (float& WheelRotationSpeed : InitialState.WheelRotationSpeeds)
+	{
+		Ar << WheelRotationSpeed;
+	}
+
+	return Ar;
+}
+
+FArchive& operator<<(FArchive& Ar, FPhysXVehicleReplayVehicle& Vehicle)
+{
+	Ar << Vehicle.VehicleId;
+	Ar << Vehicle.SteeringInput;
+	Ar << Vehicle.ThrottleInput;
+	Ar << Vehicle.BrakeInput;
+	Ar << Vehicle.HandbrakeInput;
+	Ar << Vehicle.LeftThrustInput;
+	Ar << Vehicle.RightThrustInput;
+
+	int8 TargetGear = (int8)Vehicle.TargetGear;
+	Ar << TargetGear;
+	Vehicle.TargetGear = TargetGear;
+
+	uint8 HasInitialState = Vehicle.bHasInitialState ? 1 : 0;
+	Ar << HasInitialState;
+	Vehicle.bHasInitialState = HasInitialState != 0;
+
+	if (Vehicle.bHasInitialState)
+	{
+		Ar << Vehicle.InitialState;
+	}
+
+	// PhysX vehicles have at most 32 wheels
+	uint8 NumWheels = (uint8)Vehicle.Wheels.Num();
+	Ar << NumWheels;
+
+	if (Ar.IsLoading())
+	{
+		Vehicle.Wheels.SetNum(NumWheels);
+	}
+
+	for (FPhysXVehicleReplayWheel& Wheel : Vehicle.Wheels)
+	{
+		Ar << Wheel;
+	}
+
+	return Ar;
+}
+
+FArchive& operator<<(FArchive& Ar, FPhysXVehicleReplayFrame& Frame)
+{
+	Ar << Frame.FrameNumber;
+	Ar << Frame.DeltaTime;
+
+	uint16 NumVehicles = (uint16)Frame.Vehicles.Num();
+	Ar << NumVehicles;
+
+	if (Ar.IsLoading())
+	{
+		Frame.Vehicles.SetNum(NumVehicles);
+	}
+
+	for (FPhysXVehicleReplayVehicle& Vehicle : Frame.Vehicles)
+	{
+		Ar << Vehicle;
+	}
+
+	return Ar;
+}
+
+/////////////////////////////////////////////////////
+// FPhysXVehicleReplayRecorder
+
+FPhysXVehicleReplayRecorder::FPhysXVehicleReplayRecorder(const FString& Filename)
+	: NumDroppedBlocks(0)
+	, NextFrameNumber(0)
+{
+	Writer = MakeUnique<FPhysXVehicleAsyncWriter>(Filename, PhysXVehicleReplay::WriterBlockSize, PhysXVehicleReplay::WriterMaxBlocks);
+
+	if (Writer->IsValid())
+	{
+		uint32 Magic = PhysXVehicleReplay::FileMagic;
+		uint32 Version = PhysXVehicleReplay::FileVersion;
+
+		FMemoryWriter HeaderWriter(FrameBuffer);
+		HeaderWriter << Magic;
+		HeaderWriter << Version;
+		Writer->Write(FrameBuffer.GetData(), FrameBuffer.Num());
+
+		UE_LOG(LogVehicles, Log, TEXT("Recording vehicle replay to %s"), *Filename);
+	}
+	else
+	{
+		UE_LOG(LogVehicles, Warning, TEXT("Cannot record vehicle replay, failed to open %s"), *Filename);
+	}
+}
+
+FPhysXVehicleReplayRecorder::~FPhysXVehicleReplayRecorder()
+{
+	if (IsRecording())
+	{
+		const FString Filename = Writer->GetFilename();
+
+		// Flushes and joins the writer thread
+		Writer.Reset();
+
+		UE_LOG(LogVehicles, Log, TEXT("Stopped recording vehicle replay %s (%u frames)"), *Filename, NextFrameNumber);
+	}
+}
+
+bool FPhysXVehicleReplayRecorder::IsRecording() const
+{
+	return Writer.IsValid() && Writer->IsValid();
+}
+
+void FPhysXVehicleReplayRecorder::RecordInputs_AssumesLocked(float DeltaTime, const TArray<TWeakObjectPtr<UWheeledVehicleMovementComponent>>& Vehicles)
+{
+	// A dropped block may have held the only copy of some initial states, send them all again. Playback skips the repeats
+	const int32 NewNumDroppedBlocks = Writer->GetNumDroppedBlocks();
+	if (NewNumDroppedBlocks != NumDroppedBlocks)
+	{
+		NumDroppedBlocks = NewNumDroppedBlocks;
+		RecordedInitialStates.Reset();
+	}
+
+	Frame.FrameNumber = NextFrameNumber++;
+	Frame.DeltaTime = DeltaTime;
+	Frame.Vehicles.SetNum(Vehicles.Num(), false);
+
+	for (int32 VehicleIdx = 0; VehicleIdx < Vehicles.Num(); ++VehicleIdx)
+	{
+		UWheeledVehicleMovementComponent* Vehicle = Vehicles[VehicleIdx].Get();
+		FPhysXVehicleReplayVehicle& ReplayVehicle = Frame.Vehicles[VehicleIdx];
+
+		const FReplicatedVehicleState InputState = Vehicle->GetSimulationInputState();
+
+		ReplayVehicle.VehicleId = PhysXVehicleReplay::GetVehicleId(VehicleIds, Vehicle);
+		ReplayVehicle.SteeringInput = InputState.SteeringInput;
+		ReplayVehicle.ThrottleInput = InputState.ThrottleInput;
+		ReplayVehicle.BrakeInput = InputState.BrakeInput;
+		ReplayVehicle.HandbrakeInput = InputState.HandbrakeInput;
+		ReplayVehicle.TargetGear = InputState.CurrentGear;
+		ReplayVehicle.LeftThrustInput = InputState.LeftThrustInput;
+		ReplayVehicle.RightThrustInput = InputState.RightThrustInput;
+
+		bool bAlreadyRecorded = false;
+		RecordedInitialStates.Add(ReplayVehicle.VehicleId, &bAlreadyRecorded);
+		ReplayVehicle.bHasInitialState = !bAlreadyRecorded;
+		if (ReplayVehicle.bHasInitialState)
+		{
+			PhysXVehicleReplay::CaptureInitialState(Vehicle->PVehicle, ReplayVehicle.InitialState);
+		}
+	}
+}
+
+void FPhysXVehicleReplayRecorder::RecordOutputs_AssumesLocked(const TArray<PxVehicleWheels*>& PVehicles, const TArray<PxVehicleWheelQueryResult>& PVehiclesWheelsStates)
+{
+	if (!IsRecording() || !ensure(Frame.Vehicles.Num() == PVehicles.Num()))
+	{
+		return;
+	}
+
+	for (int32 VehicleIdx = 0; VehicleIdx < PVehicles.Num(); ++VehicleIdx)
+	{
+		const PxVehicleWheels* PVehicle = PVehicles[VehicleIdx];
+		const PxVehicleWheelQueryResult& WheelsStates = PVehiclesWheelsStates[VehicleIdx];
+		FPhysXVehicleReplayVehicle& ReplayVehicle = Frame.Vehicles[VehicleIdx];
+
+		ReplayVehicle.Wheels.SetNum(WheelsStates.nbWheelQueryResults, false);
+
+		for (uint32 WheelIdx = 0; WheelIdx < WheelsStates.nbWheelQueryResults; ++WheelIdx)
+		{
+			const PxWheelQueryResult& WheelState = WheelsStates.wheelQueryResults[WheelIdx];
+			FPhysXVehicleReplayWheel& ReplayWheel = ReplayVehicle.Wheels[WheelIdx];
+
+			ReplayWheel.SuspJounce = WheelState.suspJounce;
+			ReplayWheel.SuspSpringForce = WheelState.suspSpringForce;
+			ReplayWheel.TireFriction = WheelState.tireFriction;
+			ReplayWheel.LongSlip = WheelState.longitudinalSlip;
+			ReplayWheel.LatSlip = WheelState.lateralSlip;
+			ReplayWheel.SteerAngle = WheelState.steerAngle;
+			ReplayWheel.RotationSpeed = PVehicle->mWheelsDynData.getWheelRotationSpeed(WheelIdx);
+			ReplayWheel.bInAir = WheelState.isInAir;
+		}
+	}
+
+	// Serialize here so the writer thread never touches simulation data
+	FrameBuffer.Reset();
+	FMemoryWriter FrameWriter(FrameBuffer);
+	FrameWriter << Frame;
+
+	Writer->Write(FrameBuffer.GetData(), FrameBuffer.Num());
+}
+
+/////////////////////////////////////////////////////
+// FPhysXVehicleReplayPlayer
+
+FPhysXVehicleReplayPlayer::FPhysXVehicleReplayPlayer(const FString& InFilename)
+	: Filename(InFilename)
+	, CurrentFrame(0)
+	, NumUnmatchedVehicles(0)
+	, NumMissingFrames(0)
+	, NumDivergedFrames(0)
+	, FirstDivergedFrame(INDEX_NONE)
+	, MaxError(0.f)
+	, FrameStartTime(0.0)
+	, TotalSimulationTime(0.0)
+	, MaxFrameSimulationTime(0.0)
+{
+	TArray<uint8> FileData;
+	if (!FFileHelper::LoadFileToArray(FileData, *Filename))
+	{
+		UE_LOG(LogVehicles, Warning, TEXT("Cannot play vehicle replay, failed to load %s"), *Filename);
+		return;
+	}
+
+	FMemoryReader Reader(FileData);
+
+	uint32 Magic = 0;
+	uint32 Version = 0;
+	Reader << Magic;
+	Reader << Version;
+
+	if (Magic != PhysXVehicleReplay::FileMagic || Version != PhysXVehicleReplay::FileVersion)
+	{
+		UE_LOG(LogVehicles, Warning, TEXT("Cannot play vehicle replay %s, unsupported file (magic 0x%08x, version %u)"), *Filename, Magic, Version);
+		return;
+	}
+
+	while (!Reader.AtEnd())
+	{
+		FPhysXVehicleReplayFrame ReplayFrame;
+		Reader << ReplayFrame;
+
+		if (Reader.IsError())
+		{
+			// Truncated tail, most likely the recording was interrupted
+			break;
+		}
+
+		if (Frames.Num() > 0)
+		{
+			NumMissingFrames += ReplayFrame.FrameNumber - Frames.Last().FrameNumber - 1;
+		}
+
+		Frames.Add(MoveTemp(ReplayFrame));
+	}
+
+	UE_LOG(LogVehicles, Log, TEXT("Playing vehicle replay %s (%d frames, %d dropped while recording)"), *Filename, Frames.Num(), NumMissingFrames);
+}
+
+float FPhysXVehicleReplayPlayer::ApplyInputs_AssumesLocked(float DeltaTime, const TArray<TWeakObjectPtr<UWheeledVehicleMovementComponent>>& Vehicles)
+{
+	if (!IsPlaying())
+	{
+		return DeltaTime;
+	}
+
+	const FPhysXVehicleReplayFrame& ReplayFrame = Frames[CurrentFrame];
+
+	FrameVehicleIndices.Reset();
+	for (const FPhysXVehicleReplayVehicle& ReplayVehicle : ReplayFrame.Vehicles)
+	{
+		int32 VehicleIndex = INDEX_NONE;
+		for (int32 VehicleIdx = 0; VehicleIdx < Vehicles.Num(); ++VehicleIdx)
+		{
+			if (PhysXVehicleReplay::GetVehicleId(VehicleIds, Vehicles[VehicleIdx].Get()) == ReplayVehicle.VehicleId)
+			{
+				VehicleIndex = VehicleIdx;
+				break;
+			}
+		}
+
+		if (VehicleIndex != INDEX_NONE)
+		{
+			FReplicatedVehicleState InputState;
+			InputState.SteeringInput = ReplayVehicle.SteeringInput;
+			InputState.ThrottleInput = ReplayVehicle.ThrottleInput;
+			InputState.BrakeInput = ReplayVehicle.BrakeInput;
+			InputState.HandbrakeInput = ReplayVehicle.HandbrakeInput;
+			InputState.CurrentGear = ReplayVehicle.TargetGear;
+			InputState.LeftThrustInput = ReplayVehicle.LeftThrustInput;
+			InputState.RightThrustInput = ReplayVehicle.RightThrustInput;
+
+			Vehicles[VehicleIndex]->SetSimulationInputState(InputState);
+
+			if (ReplayVehicle.bHasInitialState && !RestoredVehicles.Contains(ReplayVehicle.VehicleId))
+			{
+				PhysXVehicleReplay::RestoreInitialState(Vehicles[VehicleIndex]->PVehicle, ReplayVehicle.InitialState);
+				RestoredVehicles.Add(ReplayVehicle.VehicleId);
+			}
+		}
+		else
+		{
+			++NumUnmatchedVehicles;
+		}
+
+		FrameVehicleIndices.Add(VehicleIndex);
+	}
+
+	FrameStartTime = FPlatformTime::Seconds();
+
+	return ReplayFrame.DeltaTime;
+}
+
+void FPhysXVehicleReplayPlayer::CompareOutputs_AssumesLocked(const TArray<TWeakObjectPtr<UWheeledVehicleMovementComponent>>& Vehicles, const TArray<PxVehicleWheels*>& PVehicles, const TArray<PxVehicleWheelQueryResult>& PVehiclesWheelsStates)
+{
+	if (!IsPlaying())
+	{
+		return;
+	}
+
+	const double FrameSimulationTime = FPlatformTime::Seconds() - FrameStartTime;
+	TotalSimulationTime += FrameSimulationTime;
+	MaxFrameSimulationTime = FMath::Max(MaxFrameSimulationTime, FrameSimulationTime);
+
+	const FPhysXVehicleReplayFrame& ReplayFrame = Frames[CurrentFrame];
+	float FrameError = 0.f;
+
+	for (int32 ReplayVehicleIdx = 0; ReplayVehicleIdx < ReplayFrame.Vehicles.Num(); ++ReplayVehicleIdx)
+	{
+		const int32 VehicleIndex = FrameVehicleIndices.IsValidIndex(ReplayVehicleIdx) ? FrameVehicleIndices[ReplayVehicleIdx] : INDEX_NONE;
+		if (!PVehicles.IsValidIndex(VehicleIndex))
+		{
+			continue;
+		}
+
+		const FPhysXVehicleReplayVehicle& ReplayVehicle = ReplayFrame.Vehicles[ReplayVehicleIdx];
+		const PxVehicleWheels* PVehicle = PVehicles[VehicleIndex];
+		const PxVehicleWheelQueryResult& WheelsStates = PVehiclesWheelsStates[VehicleIndex];
+
+		const int32 NumWheels = FMath::Min<int32>(ReplayVehicle.Wheels.Num(), WheelsStates.nbWheelQueryResults);
+		for (int32 WheelIdx = 0; WheelIdx < NumWheels; ++WheelIdx)
+		{
+			const FPhysXVehicleReplayWheel& ReplayWheel = ReplayVehicle.Wheels[WheelIdx];
+			const PxWheelQueryResult& WheelState = WheelsStates.wheelQueryResults[WheelIdx];
+
+			FrameError = FMath::Max(FrameError, PhysXVehicleReplay::GetRelativeError(ReplayWheel.SuspJounce, WheelState.suspJounce));
+			FrameError = FMath::Max(FrameError, PhysXVehicleReplay::GetRelativeError(ReplayWheel.SuspSpringForce, WheelState.suspSpringForce));
+			FrameError = FMath::Max(FrameError, PhysXVehicleReplay::GetRelativeError(ReplayWheel.TireFriction, WheelState.tireFriction));
+			FrameError = FMath::Max(FrameError, PhysXVehicleReplay::GetRelativeError(ReplayWheel.LongSlip, WheelState.longitudinalSlip));
+			FrameError = FMath::Max(FrameError, PhysXVehicleReplay::GetRelativeError(ReplayWheel.LatSlip, WheelState.lateralSlip));
+			FrameError = FMath::Max(FrameError, PhysXVehicleReplay::GetRelativeError(ReplayWheel.SteerAngle, WheelState.steerAngle));
+			FrameError = FMath::Max(FrameError, PhysXVehicleReplay::GetRelativeError(ReplayWheel.RotationSpeed, PVehicle->mWheelsDynData.getWheelRotationSpeed(WheelIdx)));
+
+			if (ReplayWheel.bInAir != WheelState.isInAir)
+			{
+				FrameError = FMath::Max(FrameError, 1.f);
+			}
+		}
+	}
+
+	if (FrameError > PhysXVehicleReplay::DivergenceTolerance)
+	{
+		if (FirstDivergedFrame == INDEX_NONE)
+		{
+			FirstDivergedFrame = ReplayFrame.FrameNumber;
+			UE_LOG(LogVehicles, Warning, TEXT("Vehicle replay %s diverged at frame %u (error %f)"), *Filename, ReplayFrame.FrameNumber, FrameError);
+		}
+
+		++NumDivergedFrames;
+	}
+
+	MaxError = FMath::Max(MaxError, FrameError);
+
+	++CurrentFrame;
+}
+
+void FPhysXVehicleReplayPlayer::LogReport() const
+{
+	const int32 NumPlayedFrames = FMath::Min(CurrentFrame, Frames.Num());
+	const double AverageFrameTime = NumPlayedFrames > 0 ? TotalSimulationTime / NumPlayedFrames : 0.0;
+
+	UE_LOG(LogVehicles, Log, TEXT("Vehicle replay %s: played %d/%d frames, %d diverged (first %d), max error %f, %d unmatched vehicles, %d frames missing"),
+		*Filename, NumPlayedFrames, Frames.Num(), NumDivergedFrames, FirstDivergedFrame, MaxError, NumUnmatchedVehicles, NumMissingFrames);
+
+	UE_LOG(LogVehicles, Log, TEXT("Vehicle replay %s: simulation total %.3f ms, average %.3f ms/frame, max %.3f ms/frame"),
+		*Filename, TotalSimulationTime * 1000.0, AverageFrameTime * 1000.0, MaxFrameSimulationTime * 1000.0);
+}
+
+#endif // WITH_PHYSX_VEHICLES
+
+PRAGMA_ENABLE_DEPRECATION_WARNINGS
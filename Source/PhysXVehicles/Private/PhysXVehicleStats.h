@@ -0,0 +1,97 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+// Fine grained vehicle profiling: trace events, per stage cycle stats and pipeline counters. Never compiled into shipping builds
+// 细粒度的车辆性能分析：追踪事件、各阶段周期统计和管线计数器，永远不会编译到发行版本中
+#ifndef PHYSX_VEHICLE_PROFILING
+#define PHYSX_VEHICLE_PROFILING (!UE_BUILD_SHIPPING)
+#endif
+
+#if PHYSX_VEHICLE_PROFILING
+
+#define PHYSX_VEHICLE_TRACE_SCOPE(Name)					TRACE_CPUPROFILER_EVENT_SCOPE(Name)
+#define PHYSX_VEHICLE_SCOPE_CYCLE_COUNTER(Stat)			SCOPE_CYCLE_COUNTER(Stat)
+#define PHYSX_VEHICLE_INC_COUNTER(Stat)					INC_DWORD_STAT(Stat)
+#define PHYSX_VEHICLE_INC_COUNTER_BY(Stat, Amount)		INC_DWORD_STAT_BY(Stat, Amount)
+
+#else
+
+#define PHYSX_VEHICLE_TRACE_SCOPE(Name)
+#define PHYSX_VEHICLE_SCOPE_CYCLE_COUNTER(Stat)
+#define PHYSX_VEHICLE_INC_COUNTER(Stat)
+#define PHYSX_VEHICLE_INC_COUNTER_BY(Stat, Amount)
+
+#endif // PHYSX_VEHICLE_PROFILING
+
+// Stats on every tire shader call, which runs per wheel per sub-step. Off by default, the stats themselves would dominate the shader's cost,
+// the PxUpdateVehicles stat already covers the shader as a whole
+// 每次轮胎着色器调用的统计，着色器每个子步每个车轮运行一次。默认关闭，否则统计本身的开销会超过着色器，
+// PxUpdateVehicles 统计已经整体覆盖了着色器
+#ifndef PHYSX_VEHICLE_TIRE_SHADER_PROFILING
+#define PHYSX_VEHICLE_TIRE_SHADER_PROFILING 0
+#endif
+
+#if PHYSX_VEHICLE_PROFILING && PHYSX_VEHICLE_TIRE_SHADER_PROFILING
+
+#define PHYSX_VEHICLE_TIRE_SHADER_SCOPE_CYCLE_COUNTER(Stat)	SCOPE_CYCLE_COUNTER(Stat)
+#define PHYSX_VEHICLE_TIRE_SHADER_INC_COUNTER(Stat)			INC_DWORD_STAT(Stat)
+
+#else
+
+#define PHYSX_VEHICLE_TIRE_SHADER_SCOPE_CYCLE_COUNTER(Stat)
+#define PHYSX_VEHICLE_TIRE_SHADER_INC_COUNTER(Stat)
+
+#endif // PHYSX_VEHICLE_PROFILING && PHYSX_VEHICLE_TIRE_SHADER_PROFILING
+
+// Stats on every suspension query prefilter call, which runs per candidate shape of every wheel query. Off by default for the same reason,
+// the filter is a few mask tests and the Wheels Raycast and Wheels Swept counters already count the queries
+// 每次悬架查询预过滤调用的统计，每个车轮查询的每个候选形状运行一次。出于同样的原因默认关闭，
+// 过滤本身只有几次掩码测试，Wheels Raycast 和 Wheels Swept 计数器已经统计了查询次数
+#ifndef PHYSX_VEHICLE_QUERY_FILTER_PROFILING
+#define PHYSX_VEHICLE_QUERY_FILTER_PROFILING 0
+#endif
+
+#if PHYSX_VEHICLE_PROFILING && PHYSX_VEHICLE_QUERY_FILTER_PROFILING
+
+#define PHYSX_VEHICLE_QUERY_FILTER_SCOPE_CYCLE_COUNTER(Stat)	SCOPE_CYCLE_COUNTER(Stat)
+#define PHYSX_VEHICLE_QUERY_FILTER_INC_COUNTER(Stat)			INC_DWORD_STAT(Stat)
+
+#else
+
+#define PHYSX_VEHICLE_QUERY_FILTER_SCOPE_CYCLE_COUNTER(Stat)
+#define PHYSX_VEHICLE_QUERY_FILTER_INC_COUNTER(Stat)
+
+#endif // PHYSX_VEHICLE_PROFILING && PHYSX_VEHICLE_QUERY_FILTER_PROFILING
+
+#if PHYSX_VEHICLE_PROFILING && STATS
+
+// Wrap a SCOPED_SCENE_*_LOCK to accumulate the time spent waiting for it
+// 包裹 SCOPED_SCENE_*_LOCK 以累计等待锁的时间
+#define PHYSX_VEHICLE_LOCK_WAIT_BEGIN()					const uint32 PhysXVehicleLockWaitStartCycles = FPlatformTime::Cycles()
+#define PHYSX_VEHICLE_LOCK_WAIT_END()					INC_DWORD_STAT_BY(STAT_PhysXVehicle_LockWaitMicroseconds, (uint32)(FPlatformTime::ToSeconds(FPlatformTime::Cycles() - PhysXVehicleLockWaitStartCycles) * 1000000.0))
+
+#else
+
+#define PHYSX_VEHICLE_LOCK_WAIT_BEGIN()
+#define PHYSX_VEHICLE_LOCK_WAIT_END()
+
+#endif // PHYSX_VEHICLE_PROFILING && STATS
+
+DECLARE_STATS_GROUP(TEXT("PhysXVehicleManager"), STATGROUP_PhysXVehicleManager, STATGROUP_Advanced);
+
+// Stats shared by the manager, the movement components and the anim instance, defined in PhysXVehicleManager.cpp
+// 由管理器、移动组件和动画实例共享的统计数据，定义于 PhysXVehicleManager.cpp
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Tick Vehicle"), STAT_PhysXVehicle_TickVehicle, STATGROUP_PhysXVehicleManager, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Update Drag"), STAT_PhysXVehicle_UpdateDrag, STATGROUP_PhysXVehicleManager, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Avoidance"), STAT_PhysXVehicle_Avoidance, STATGROUP_PhysXVehicleManager, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Tire Shader"), STAT_PhysXVehicle_TireShader, STATGROUP_PhysXVehicleManager, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Anim Proxy PreUpdate"), STAT_PhysXVehicle_AnimProxyPreUpdate, STATGROUP_PhysXVehicleManager, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Setup Vehicle"), STAT_PhysXVehicle_SetupVehicle, STATGROUP_PhysXVehicleManager, );
+
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Tire Shader Calls"), STAT_PhysXVehicle_TireShaderCalls, STATGROUP_PhysXVehicleManager, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Lock Wait (us)"), STAT_PhysXVehicle_LockWaitMicroseconds, STATGROUP_PhysXVehicleManager, );
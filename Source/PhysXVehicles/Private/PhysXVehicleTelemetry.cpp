@@ -0,0 +1,82 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "PhysXVehicleTelemetry.h"
+#include "VehicleWheel.h"
+
+PRAGMA_DISABLE_DEPRECATION_WARNINGS
+
+#if WITH_PHYSX_VEHICLES
+
+FPhysXVehicleTelemetry::FPhysXVehicleTelemetry(int32 InNumWheels)
+	: NumWheels(InNumWheels)
+	, Head(0)
+	, NumSamples(0)
+{
+	Samples.AddZeroed(NumWheels * (int32)EVehicleTelemetryChannel::Num * MaxSamples);
+}
+
+void FPhysXVehicleTelemetry::Sample_AssumesLocked(const PxVehicleWheels* PVehicle, const PxVehicleWheelQueryResult& WheelsStates, const TArray<UVehicleWheel*>& Wheels)
+{
+	const int32 NumSampledWheels = FMath::Min<int32>(NumWheels, WheelsStates.nbWheelQueryResults);
+
+	for (int32 WheelIdx = 0; WheelIdx < NumSampledWheels; ++WheelIdx)
+	{
+		const PxWheelQueryResult& WheelState = WheelsStates.wheelQueryResults[WheelIdx];
+		float* WheelSamples = &Samples[GetChannelOffset(WheelIdx, EVehicleTelemetryChannel::SuspJounce) + Head];
+
+		auto SetSample = [WheelSamples](EVehicleTelemetryChannel Channel, float Value)
+		{
+			WheelSamples[(int32)Channel * MaxSamples] = Value;
+		};
+
+		SetSample(EVehicleTelemetryChannel::SuspJounce, WheelState.suspJounce);
+		SetSample(EVehicleTelemetryChannel::SuspForce, WheelState.suspSpringForce);
+		SetSample(EVehicleTelemetryChannel::WheelOmega, PVehicle->mWheelsDynData.getWheelRotationSpeed(WheelIdx));
+		SetSample(EVehicleTelemetryChannel::TireFriction, WheelState.tireFriction);
+		SetSample(EVehicleTelemetryChannel::LongSlip, WheelState.longitudinalSlip);
+		SetSample(EVehicleTelemetryChannel::LatSlip, WheelState.lateralSlip);
+
+		// Forces come from the tire shader, which writes them to the manager's FTireShaderWheelData during the update. PublishTireShaderData
+		// copies them to the wheel's Debug members after the step, before telemetry is sampled
+		const UVehicleWheel* Wheel = Wheels.IsValidIndex(WheelIdx) ? Wheels[WheelIdx] : nullptr;
+		if (Wheel && !WheelState.isInAir && Wheel->DebugTireLoad > KINDA_SMALL_NUMBER)
+		{
+			SetSample(EVehicleTelemetryChannel::TireLoad, Wheel->DebugTireLoad);
+			SetSample(EVehicleTelemetryChannel::NormalizedTireLoad, Wheel->DebugNormalizedTireLoad);
+			SetSample(EVehicleTelemetryChannel::NormLongForce, FMath::Abs(Wheel->DebugLongForce) / Wheel->DebugTireLoad);
+			SetSample(EVehicleTelemetryChannel::NormLatForce, FMath::Abs(Wheel->DebugLatForce) / Wheel->DebugTireLoad);
+		}
+		else
+		{
+			SetSample(EVehicleTelemetryChannel::TireLoad, 0.f);
+			SetSample(EVehicleTelemetryChannel::NormalizedTireLoad, 0.f);
+			SetSample(EVehicleTelemetryChannel::NormLongForce, 0.f);
+			SetSample(EVehicleTelemetryChannel::NormLatForce, 0.f);
+		}
+	}
+
+	Head = (Head + 1) % MaxSamples;
+	NumSamples = FMath::Min(NumSamples + 1, (int32)MaxSamples);
+}
+
+const TCHAR* FPhysXVehicleTelemetry::GetChannelName(EVehicleTelemetryChannel Channel)
+{
+	switch (Channel)
+	{
+	case EVehicleTelemetryChannel::SuspJounce:			return TEXT("jounce");
+	case EVehicleTelemetryChannel::SuspForce:			return TEXT("suspForce");
+	case EVehicleTelemetryChannel::TireLoad:			return TEXT("tireLoad");
+	case EVehicleTelemetryChannel::NormalizedTireLoad:	return TEXT("normTireLoad");
+	case EVehicleTelemetryChannel::WheelOmega:			return TEXT("wheelOmega");
+	case EVehicleTelemetryChannel::TireFriction:		return TEXT("tireFriction");
+	case EVehicleTelemetryChannel::LongSlip:			return TEXT("tireLongSlip");
+	case EVehicleTelemetryChannel::NormLongForce:		return TEXT("normTireLongForce");
+	case EVehicleTelemetryChannel::LatSlip:				return TEXT("tireLatSlip");
+	case EVehicleTelemetryChannel::NormLatForce:		return TEXT("normTireLatForce");
+	default:											return TEXT("");
+	}
+}
+
+#endif // WITH_PHYSX_VEHICLES
+
+PRAGMA_ENABLE_DEPRECATION_WARNINGS
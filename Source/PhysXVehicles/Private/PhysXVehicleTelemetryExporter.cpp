@@ -0,0 +1,353 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "PhysXVehicleTelemetryExporter.h"
+#include "PhysXVehicleAsyncWriter.h"
+#include "PhysXVehicleManager.h"
+#include "VehicleWheel.h"
+#include "PhysxUserData.h"
+#include "PhysXPublic.h"
+#include "PhysicalMaterials/PhysicalMaterial.h"
+#include "Serialization/MemoryWriter.h"
+
+PRAGMA_DISABLE_DEPRECATION_WARNINGS
+
+#if WITH_PHYSX_VEHICLES
+
+namespace PhysXVehicleTelemetryExport
+{
+	// 'PXVT'
+	static const uint32 FileMagic = 0x54565850;
+	static const uint32 FileVersion = 1;
+
+	// Few large blocks: one being filled, one being written and some slack for disk hiccups
+	static const int32 WriterBlockSize = 256 * 1024;
+	static const int32 WriterMaxBlocks = 4;
+
+	// Record type and row count ahead of the columns of a row group
+	static const int32 RowGroupHeaderSize = sizeof(uint8) + sizeof(uint32);
+
+	enum ERecordType : uint8
+	{
+		Record_RowGroup,
+		Record_Surface,
+	};
+
+	enum EColumnType : uint8
+	{
+		ColumnType_UInt,
+		ColumnType_Int,
+		ColumnType_Float,
+	};
+
+	struct FColumnDesc
+	{
+		const ANSICHAR* Name;
+		EColumnType Type;
+	};
+
+	// In EColumn order
+	static const FColumnDesc ColumnDescs[] =
+	{
+		{ "step",		ColumnType_UInt },
+		{ "time",		ColumnType_Float },
+		{ "vehicle",	ColumnType_UInt },
+		{ "wheel",		ColumnType_Int },
+		{ "jounce",		ColumnType_Float },
+		{ "suspForce",	ColumnType_Float },
+		{ "tireLoad",	ColumnType_Float },
+		{ "longSlip",	ColumnType_Float },
+		{ "latSlip",	ColumnType_Float },
+		{ "omega",		ColumnType_Float },
+		{ "friction",	ColumnType_Float },
+		{ "surface",	ColumnType_Int },
+		{ "engineRPM",	ColumnType_Float },
+		{ "gear",		ColumnType_Int },
+	};
+}
+
+FPhysXVehicleTelemetryExporter::FPhysXVehicleTelemetryExporter(const FString& Filename, EVehicleTelemetryExportFormat InFormat)
+	: Format(InFormat)
+	, MaxRowGroupRows(0)
+	, StepNumber(0)
+	, Time(0.0)
+{
+	static_assert(UE_ARRAY_COUNT(PhysXVehicleTelemetryExport::ColumnDescs) == Column_Num, "Must have one description per column");
+
+	Writer = MakeUnique<FPhysXVehicleAsyncWriter>(Filename, PhysXVehicleTelemetryExport::WriterBlockSize, PhysXVehicleTelemetryExport::WriterMaxBlocks);
+
+	if (Writer->IsValid())
+	{
+		if (Format == EVehicleTelemetryExportFormat::Columnar)
+		{
+			// Split on bytes, a row group bigger than a block would grow it and could only be dropped whole
+			MaxRowGroupRows = (PhysXVehicleTelemetryExport::WriterBlockSize - PhysXVehicleTelemetryExport::RowGroupHeaderSize) / (Column_Num * sizeof(FValue));
+			for (TArray<FValue>& Column : Columns)
+			{
+				Column.Reserve(MaxRowGroupRows);
+			}
+		}
+
+		WriteHeader();
+		RegisterSurfaces();
+
+		UE_LOG(LogVehicles, Log, TEXT("Exporting vehicle telemetry to %s"), *Filename);
+	}
+	else
+	{
+		UE_LOG(LogVehicles, Warning, TEXT("Cannot export vehicle telemetry, failed to open %s"), *Filename);
+	}
+}
+
+FPhysXVehicleTelemetryExporter::~FPhysXVehicleTelemetryExporter()
+{
+	if (IsExporting())
+	{
+		if (Format == EVehicleTelemetryExportFormat::Columnar)
+		{
+			WriteRowGroup();
+		}
+
+		const FString Filename = Writer->GetFilename();
+		const int32 NumDroppedBlocks = Writer->GetNumDroppedBlocks();
+
+		// Flushes and joins the writer thread
+		Writer.Reset();
+
+		UE_LOG(LogVehicles, Log, TEXT("Stopped exporting vehicle telemetry %s (%u steps, %d blocks dropped)"), *Filename, StepNumber, NumDroppedBlocks);
+	}
+}
+
+bool FPhysXVehicleTelemetryExporter::IsExporting() const
+{
+	return Writer.IsValid() && Writer->IsValid();
+}
+
+void FPhysXVehicleTelemetryExporter::WriteHeader()
+{
+	Buffer.Reset();
+
+	if (Format == EVehicleTelemetryExportFormat::Csv)
+	{
+		for (int32 ColumnIdx = 0; ColumnIdx < Column_Num; ++ColumnIdx)
+		{
+			const ANSICHAR* Name = PhysXVehicleTelemetryExport::ColumnDescs[ColumnIdx].Name;
+			Buffer.Append((const uint8*)Name, FCStringAnsi::Strlen(Name));
+			Buffer.Add(ColumnIdx + 1 < Column_Num ? ',' : '\n');
+		}
+	}
+	else
+	{
+		FMemoryWriter HeaderWriter(Buffer);
+
+		uint32 Magic = PhysXVehicleTelemetryExport::FileMagic;
+		uint32 Version = PhysXVehicleTelemetryExport::FileVersion;
+		uint16 NumColumns = Column_Num;
+		HeaderWriter << Magic;
+		HeaderWriter << Version;
+		HeaderWriter << NumColumns;
+
+		for (const PhysXVehicleTelemetryExport::FColumnDesc& ColumnDesc : PhysXVehicleTelemetryExport::ColumnDescs)
+		{
+			uint8 Type = ColumnDesc.Type;
+			uint8 NameLength = (uint8)FCStringAnsi::Strlen(ColumnDesc.Name);
+			HeaderWriter << Type;
+			HeaderWriter << NameLength;
+			HeaderWriter.Serialize((void*)ColumnDesc.Name, NameLength);
+		}
+	}
+
+	// Reliable so it is never dropped and lands ahead of the surface records and every block
+	Writer->WriteReliable(Buffer.GetData(), Buffer.Num());
+}
+
+void FPhysXVehicleTelemetryExporter::Export_AssumesLocked(float DeltaTime, const TArray<TWeakObjectPtr<UWheeledVehicleMovementComponent>>& Vehicles, const TArray<PxVehicleWheels*>& PVehicles, const TArray<PxVehicleWheelQueryResult>& PVehiclesWheelsStates)
+{
+	if (!IsExporting())
+	{
+		return;
+	}
+
+	Time += DeltaTime;
+
+	// Csv rows of a step go out in one write so a dropped block never cuts a line in half
+	Buffer.Reset();
+
+	for (int32 VehicleIdx = 0; VehicleIdx < PVehicles.Num(); ++VehicleIdx)
+	{
+		UWheeledVehicleMovementComponent* Vehicle = Vehicles[VehicleIdx].Get();
+		const PxVehicleWheels* PVehicle = PVehicles[VehicleIdx];
+		const PxVehicleWheelQueryResult& WheelsStates = PVehiclesWheelsStates[VehicleIdx];
+
+		FValue Row[Column_Num];
+		Row[Column_Step].UInt = StepNumber;
+		Row[Column_Time].Float = (float)Time;
+		Row[Column_Vehicle].UInt = VehicleIds.FindRef(Vehicle);
+		Row[Column_EngineRPM].Float = Vehicle->GetEngineRotationSpeed();
+		Row[Column_Gear].Int = Vehicle->GetCurrentGear();
+
+		for (uint32 WheelIdx = 0; WheelIdx < WheelsStates.nbWheelQueryResults; ++WheelIdx)
+		{
+			const PxWheelQueryResult& WheelState = WheelsStates.wheelQueryResults[WheelIdx];
+			const UVehicleWheel* Wheel = Vehicle->Wheels.IsValidIndex(WheelIdx) ? Vehicle->Wheels[WheelIdx] : nullptr;
+
+			Row[Column_Wheel].Int = WheelIdx;
+			Row[Column_Jounce].Float = WheelState.suspJounce;
+			Row[Column_SuspForce].Float = WheelState.suspSpringForce;
+			Row[Column_TireLoad].Float = (Wheel && !WheelState.isInAir) ? Wheel->DebugTireLoad : 0.f;
+			Row[Column_LongSlip].Float = WheelState.longitudinalSlip;
+			Row[Column_LatSlip].Float = WheelState.lateralSlip;
+			Row[Column_Omega].Float = PVehicle->mWheelsDynData.getWheelRotationSpeed(WheelIdx);
+			Row[Column_Friction].Float = WheelState.tireFriction;
+			Row[Column_Surface].Int = GetSurfaceId(WheelState.tireSurfaceMaterial);
+
+			AddRow(Row);
+		}
+	}
+
+	if (Format == EVehicleTelemetryExportFormat::Csv)
+	{
+		Writer->Write(Buffer.GetData(), Buffer.Num());
+	}
+
+	++StepNumber;
+}
+
+void FPhysXVehicleTelemetryExporter::AddRow(const FValue (&Row)[Column_Num])
+{
+	if (Format == EVehicleTelemetryExportFormat::Columnar)
+	{
+		for (int32 ColumnIdx = 0; ColumnIdx < Column_Num; ++ColumnIdx)
+		{
+			Columns[ColumnIdx].Add(Row[ColumnIdx]);
+		}
+
+		if (Columns[0].Num() >= MaxRowGroupRows)
+		{
+			WriteRowGroup();
+		}
+		return;
+	}
+
+	ANSICHAR Field[128];
+	for (int32 ColumnIdx = 0; ColumnIdx < Column_Num; ++ColumnIdx)
+	{
+		const FValue& Value = Row[ColumnIdx];
+		int32 FieldLength = 0;
+
+		if (ColumnIdx == Column_Surface)
+		{
+			const FString& SurfaceName = SurfaceNames.IsValidIndex(Value.Int) ? SurfaceNames[Value.Int] : FString();
+			FieldLength = FCStringAnsi::Snprintf(Field, sizeof(Field), "%s", TCHAR_TO_ANSI(*SurfaceName));
+		}
+		else
+		{
+			switch (PhysXVehicleTelemetryExport::ColumnDescs[ColumnIdx].Type)
+			{
+			case PhysXVehicleTelemetryExport::ColumnType_UInt:	FieldLength = FCStringAnsi::Snprintf(Field, sizeof(Field), "%u", Value.UInt); break;
+			case PhysXVehicleTelemetryExport::ColumnType_Int:	FieldLength = FCStringAnsi::Snprintf(Field, sizeof(Field), "%d", Value.Int); break;
+			default:											FieldLength = FCStringAnsi::Snprintf(Field, sizeof(Field), "%g", Value.Float); break;
+			}
+		}
+
+		Buffer.Append((const uint8*)Field, FMath::Clamp(FieldLength, 0, (int32)sizeof(Field) - 1));
+		Buffer.Add(ColumnIdx + 1 < Column_Num ? ',' : '\n');
+	}
+}
+
+void FPhysXVehicleTelemetryExporter::WriteRowGroup()
+{
+	uint32 NumRows = Columns[0].Num();
+	if (NumRows == 0)
+	{
+		return;
+	}
+
+	Buffer.Reset();
+	FMemoryWriter RowGroupWriter(Buffer);
+
+	uint8 RecordType = PhysXVehicleTelemetryExport::Record_RowGroup;
+	RowGroupWriter << RecordType;
+	RowGroupWriter << NumRows;
+
+	for (TArray<FValue>& Column : Columns)
+	{
+		RowGroupWriter.Serialize(Column.GetData(), Column.Num() * sizeof(FValue));
+		Column.Reset();
+	}
+
+	Writer->Write(Buffer.GetData(), Buffer.Num());
+}
+
+void FPhysXVehicleTelemetryExporter::RegisterVehicle(UWheeledVehicleMovementComponent* Vehicle)
+{
+	if (Vehicle && !VehicleIds.Contains(Vehicle))
+	{
+		// Same id as vehicle replays so both files can be joined
+		VehicleIds.Add(Vehicle, GetTypeHash(Vehicle->GetPathName()));
+	}
+}
+
+void FPhysXVehicleTelemetryExporter::RegisterSurfaces()
+{
+	if (!IsExporting())
+	{
+		return;
+	}
+
+	const PxU32 NumMaterials = GPhysXSDK->getNbMaterials();
+	TArray<PxMaterial*> Materials;
+	Materials.SetNumUninitialized(NumMaterials);
+	GPhysXSDK->getMaterials(Materials.GetData(), NumMaterials);
+
+	for (const PxMaterial* Material : Materials)
+	{
+		if (!SurfaceIds.Contains(Material))
+		{
+			const UPhysicalMaterial* PhysMat = FPhysxUserData::Get<UPhysicalMaterial>(Material->userData);
+			AddSurface(Material, PhysMat ? PhysMat->GetName() : FString(TEXT("Unknown")));
+		}
+	}
+}
+
+int32 FPhysXVehicleTelemetryExporter::AddSurface(const PxMaterial* Surface, const FString& SurfaceName)
+{
+	int32 SurfaceId = SurfaceNames.Add(SurfaceName);
+	SurfaceIds.Add(Surface, SurfaceId);
+
+	if (Format == EVehicleTelemetryExportFormat::Columnar)
+	{
+		TArray<uint8> SurfaceRecord;
+		FMemoryWriter SurfaceWriter(SurfaceRecord);
+
+		uint8 RecordType = PhysXVehicleTelemetryExport::Record_Surface;
+		FString Name = SurfaceName;
+		SurfaceWriter << RecordType;
+		SurfaceWriter << SurfaceId;
+		SurfaceWriter << Name;
+
+		// A dropped dictionary entry would leave every row group after it with a dangling surface id
+		Writer->WriteReliable(SurfaceRecord.GetData(), SurfaceRecord.Num());
+	}
+
+	return SurfaceId;
+}
+
+int32 FPhysXVehicleTelemetryExporter::GetSurfaceId(const PxMaterial* Surface)
+{
+	if (Surface == nullptr)
+	{
+		return INDEX_NONE;
+	}
+
+	if (const int32* SurfaceId = SurfaceIds.Find(Surface))
+	{
+		return *SurfaceId;
+	}
+
+	// Created since the last RegisterSurfaces, the physical material is not looked up under the scene lock
+	return AddSurface(Surface, FString(TEXT("Unknown")));
+}
+
+#endif // WITH_PHYSX_VEHICLES
+
+PRAGMA_ENABLE_DEPRECATION_WARNINGS
@@ -0,0 +1,41 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Wheel count known at compile time. Converts to int32, so a loop written against "auto NumWheels" gets a constant trip count the
+ * compiler can unroll and vectorise, and the same body still works with a plain int32 for the other counts
+ */
+// 编译期已知的车轮数量。可转换为 int32，因此针对 "auto NumWheels" 编写的循环会得到常量迭代次数，编译器可以展开并向量化，
+// 同样的循环体对其他车轮数量仍可使用普通的 int32
+template<int32 N>
+struct TPhysXVehicleWheelCount
+{
+	static constexpr int32 Value = N;
+
+	constexpr operator int32() const { return N; }
+};
+
+/**
+ * Call Functor with the wheel count as a TPhysXVehicleWheelCount for 2, 4, 6 and 8 wheels, and as an int32 for any other count
+ */
+// 对 2、4、6、8 个车轮以 TPhysXVehicleWheelCount 形式、对其他车轮数量以 int32 形式将车轮数量传给 Functor
+template<typename FunctorType>
+FORCEINLINE auto DispatchWheelCount(int32 NumWheels, FunctorType&& Functor)
+{
+	switch (NumWheels)
+	{
+	case 2:
+		return Functor(TPhysXVehicleWheelCount<2>());
+	case 4:
+		return Functor(TPhysXVehicleWheelCount<4>());
+	case 6:
+		return Functor(TPhysXVehicleWheelCount<6>());
+	case 8:
+		return Functor(TPhysXVehicleWheelCount<8>());
+	default:
+		return Functor(NumWheels);
+	}
+}
@@ -0,0 +1,137 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "PhysXVehicleWheelInstances.h"
+#include "Engine/World.h"
+#include "Engine/StaticMesh.h"
+#include "GameFramework/Actor.h"
+#include "Components/InstancedStaticMeshComponent.h"
+
+PRAGMA_DISABLE_DEPRECATION_WARNINGS
+
+#if WITH_PHYSX_VEHICLES
+
+FPhysXVehicleWheelInstances::FPhysXVehicleWheelInstances(UWorld* InWorld)
+	: World(InWorld)
+{
+}
+
+FPhysXVehicleWheelInstances::~FPhysXVehicleWheelInstances()
+{
+	UWorld* OwningWorld = World.Get();
+	if (Actor.IsValid() && OwningWorld && !OwningWorld->bIsTearingDown)
+	{
+		Actor->Destroy();
+	}
+}
+
+void FPhysXVehicleWheelInstances::BeginUpdate()
+{
+	for (FMeshInstances& MeshInstances : Meshes)
+	{
+		MeshInstances.Transforms.Reset();
+	}
+}
+
+void FPhysXVehicleWheelInstances::AddWheel(UStaticMesh* Mesh, const FTransform& WorldTransform)
+{
+	FMeshInstances* MeshInstances = Meshes.FindByPredicate([Mesh](const FMeshInstances& Other) { return Other.Mesh == Mesh; });
+	if (MeshInstances == nullptr)
+	{
+		UInstancedStaticMeshComponent* Component = CreateComponent(Mesh);
+		if (Component == nullptr)
+		{
+			return;
+		}
+
+		MeshInstances = &Meshes.AddDefaulted_GetRef();
+		MeshInstances->Mesh = Mesh;
+		MeshInstances->Component = Component;
+	}
+
+	MeshInstances->Transforms.Add(WorldTransform);
+}
+
+void FPhysXVehicleWheelInstances::EndUpdate()
+{
+	for (FMeshInstances& MeshInstances : Meshes)
+	{
+		UInstancedStaticMeshComponent* Component = MeshInstances.Component.Get();
+		if (Component == nullptr)
+		{
+			continue;
+		}
+
+		// Only grow and shrink at the end so no instance index ever shifts, then overwrite them all in one batch
+		const int32 NumTransforms = MeshInstances.Transforms.Num();
+		const bool bShrunk = Component->GetInstanceCount() > NumTransforms;
+		while (Component->GetInstanceCount() > NumTransforms)
+		{
+			Component->RemoveInstance(Component->GetInstanceCount() - 1);
+		}
+
+		for (int32 InstanceIdx = Component->GetInstanceCount(); InstanceIdx < NumTransforms; ++InstanceIdx)
+		{
+			Component->AddInstanceWorldSpace(MeshInstances.Transforms[InstanceIdx]);
+		}
+
+		if (NumTransforms > 0)
+		{
+			Component->BatchUpdateInstancesTransforms(0, MeshInstances.Transforms, true, true, true);
+		}
+		else if (bShrunk)
+		{
+			Component->MarkRenderStateDirty();
+		}
+	}
+}
+
+int32 FPhysXVehicleWheelInstances::GetNumInstances() const
+{
+	int32 NumInstances = 0;
+	for (const FMeshInstances& MeshInstances : Meshes)
+	{
+		NumInstances += MeshInstances.Transforms.Num();
+	}
+
+	return NumInstances;
+}
+
+UInstancedStaticMeshComponent* FPhysXVehicleWheelInstances::CreateComponent(UStaticMesh* Mesh)
+{
+	UWorld* OwningWorld = World.Get();
+	if (OwningWorld == nullptr || Mesh == nullptr)
+	{
+		return nullptr;
+	}
+
+	if (!Actor.IsValid())
+	{
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.ObjectFlags |= RF_Transient;
+		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		Actor = OwningWorld->SpawnActor<AActor>(SpawnParams);
+		if (!Actor.IsValid())
+		{
+			return nullptr;
+		}
+	}
+
+	// Components stay at the origin, instances are placed in world space
+	UInstancedStaticMeshComponent* Component = NewObject<UInstancedStaticMeshComponent>(Actor.Get(), NAME_None, RF_Transient);
+	Component->SetMobility(EComponentMobility::Movable);
+	Component->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	Component->SetCanEverAffectNavigation(false);
+	Component->SetStaticMesh(Mesh);
+
+	if (Actor->GetRootComponent() == nullptr)
+	{
+		Actor->SetRootComponent(Component);
+	}
+	Component->RegisterComponent();
+
+	return Component;
+}
+
+#endif // WITH_PHYSX_VEHICLES
+
+PRAGMA_ENABLE_DEPRECATION_WARNINGS
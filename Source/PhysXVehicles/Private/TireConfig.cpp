@@ -58,8 +58,16 @@ void UTireConfig::SetPerMaterialFrictionScale(UPhysicalMaterial* PhysicalMateria
 }
 
 
+void UTireConfig::SetPacejkaCoefficients(const FPacejkaTireCoefficients& NewCoefficients)
+{
+	PacejkaCoefficients = NewCoefficients;
+	PacejkaTireModel.SetCoefficients(PacejkaCoefficients);
+}
+
 void UTireConfig::PostInitProperties()
 {
+	PacejkaTireModel.SetCoefficients(PacejkaCoefficients);
+
 	if (!HasAnyFlags(RF_ClassDefaultObject))
 	{
 		// Set our TireConfigID - either by finding an available slot or creating a new one
@@ -82,6 +90,13 @@ void UTireConfig::PostInitProperties()
 	Super::PostInitProperties();
 }
 
+void UTireConfig::PostLoad()
+{
+	Super::PostLoad();
+
+	PacejkaTireModel.SetCoefficients(PacejkaCoefficients);
+}
+
 void UTireConfig::BeginDestroy()
 {
 	if (!HasAnyFlags(RF_ClassDefaultObject))
@@ -109,6 +124,7 @@ void UTireConfig::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedE
 {
 	Super::PostEditChangeProperty(PropertyChangedEvent);
 
+	PacejkaTireModel.SetCoefficients(PacejkaCoefficients);
 	NotifyTireFrictionUpdated();
 }
 #endif //WITH_EDITOR
@@ -0,0 +1,188 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "TireModel.h"
+#include "WheeledVehicleMovementComponent.h"
+#include "Math/VectorRegister.h"
+
+PRAGMA_DISABLE_DEPRECATION_WARNINGS
+
+FPacejkaTireCoefficients::FPacejkaTireCoefficients()
+	: B0(1.5f), B1(0.f), B2(1100.f), B3(0.f), B4(300.f), B5(0.f), B6(0.f), B7(0.f), B8(-2.f), B9(0.f), B10(0.f), B11(0.f), B12(0.f), B13(0.f)
+	, A0(1.4f), A1(0.f), A2(1100.f), A3(1100.f), A4(10.f), A6(0.f), A7(-2.f), A8(0.f), A9(0.f), A11(0.f), A12(0.f)
+{
+}
+
+void ITireModel::Evaluate(const FTireShaderInput& Input, FTireShaderOutput& Output) const
+{
+	FTireModelBatch Batch;
+	Batch.Num = 1;
+	Batch.TireFriction = &Input.TireFriction;
+	Batch.LongSlip = &Input.LongSlip;
+	Batch.LatSlip = &Input.LatSlip;
+	Batch.TireLoad = &Input.TireLoad;
+	Batch.WheelRadius = &Input.WheelRadius;
+	Batch.WheelTorque = &Output.WheelTorque;
+	Batch.LongForce = &Output.LongForce;
+	Batch.LatForce = &Output.LatForce;
+
+	EvaluateBatch(Batch);
+}
+
+FPacejkaTireModel::FPacejkaTireModel()
+{
+}
+
+void FPacejkaTireModel::SetCoefficients(const FPacejkaTireCoefficients& InCoefficients)
+{
+	Coefficients = InCoefficients;
+}
+
+const FPacejkaTireModel& FPacejkaTireModel::GetDefault()
+{
+	static const FPacejkaTireModel DefaultModel;
+	return DefaultModel;
+}
+
+void FPacejkaTireModel::EvaluateBatch(const FTireModelBatch& Batch) const
+{
+	int32 Index = 0;
+	for (; Index + 4 <= Batch.Num; Index += 4)
+	{
+		EvaluateFour(Batch, Index);
+	}
+
+	if (Index < Batch.Num)
+	{
+		// Pad the remainder to four unloaded, unslipping tires so every tire goes through the same code
+		float TireFriction[4] = { 1.f, 1.f, 1.f, 1.f };
+		float LongSlip[4] = { 0.f, 0.f, 0.f, 0.f };
+		float LatSlip[4] = { 0.f, 0.f, 0.f, 0.f };
+		float TireLoad[4] = { 0.f, 0.f, 0.f, 0.f };
+		float WheelRadius[4] = { 0.f, 0.f, 0.f, 0.f };
+		float WheelTorque[4];
+		float LongForce[4];
+		float LatForce[4];
+
+		const int32 NumRemaining = Batch.Num - Index;
+		for (int32 Lane = 0; Lane < NumRemaining; ++Lane)
+		{
+			TireFriction[Lane] = Batch.TireFriction[Index + Lane];
+			LongSlip[Lane] = Batch.LongSlip[Index + Lane];
+			LatSlip[Lane] = Batch.LatSlip[Index + Lane];
+			TireLoad[Lane] = Batch.TireLoad[Index + Lane];
+			WheelRadius[Lane] = Batch.WheelRadius[Index + Lane];
+		}
+
+		const FTireModelBatch Padded = { 4, TireFriction, LongSlip, LatSlip, TireLoad, WheelRadius, WheelTorque, LongForce, LatForce };
+		EvaluateFour(Padded, 0);
+
+		for (int32 Lane = 0; Lane < NumRemaining; ++Lane)
+		{
+			Batch.WheelTorque[Index + Lane] = WheelTorque[Lane];
+			Batch.LongForce[Index + Lane] = LongForce[Lane];
+			Batch.LatForce[Index + Lane] = LatForce[Lane];
+		}
+	}
+}
+
+/** Arctangent, minimax polynomial on [0, 1] and atan(x) = pi/2 - atan(1/x) beyond. Absolute error below 1e-5 */
+static FORCEINLINE VectorRegister VectorATanFast(const VectorRegister& X)
+{
+	const VectorRegister AbsX = VectorAbs(X);
+	const VectorRegister bInvert = VectorCompareGT(AbsX, GlobalVectorConstants::FloatOne);
+	const VectorRegister T = VectorSelect(bInvert, VectorReciprocalAccurate(AbsX), AbsX);
+	const VectorRegister T2 = VectorMultiply(T, T);
+
+	VectorRegister Poly = VectorSetFloat1(-0.01172120f);
+	Poly = VectorMultiplyAdd(Poly, T2, VectorSetFloat1(0.05265332f));
+	Poly = VectorMultiplyAdd(Poly, T2, VectorSetFloat1(-0.11643287f));
+	Poly = VectorMultiplyAdd(Poly, T2, VectorSetFloat1(0.19354346f));
+	Poly = VectorMultiplyAdd(Poly, T2, VectorSetFloat1(-0.33262347f));
+	Poly = VectorMultiplyAdd(Poly, T2, VectorSetFloat1(0.99997726f));
+	Poly = VectorMultiply(Poly, T);
+
+	const VectorRegister AbsResult = VectorSelect(bInvert, VectorSubtract(GlobalVectorConstants::PiByTwo, Poly), Poly);
+	return VectorSelect(VectorCompareGT(GlobalVectorConstants::FloatZero, X), VectorNegate(AbsResult), AbsResult);
+}
+
+/** D * sin(C * atan(BX - E * (BX - atan(BX)))) */
+static FORCEINLINE VectorRegister VectorMagicFormula(const VectorRegister& BX, const VectorRegister& C, const VectorRegister& D, const VectorRegister& E)
+{
+	const VectorRegister Inner = VectorSubtract(BX, VectorMultiply(E, VectorSubtract(BX, VectorATanFast(BX))));
+	const VectorRegister Angle = VectorMultiply(C, VectorATanFast(Inner));
+
+	VectorRegister Sin, Cos;
+	VectorSinCos(&Sin, &Cos, &Angle);
+	return VectorMultiply(D, Sin);
+}
+
+void FPacejkaTireModel::EvaluateFour(const FTireModelBatch& Batch, int32 Index) const
+{
+	const FPacejkaTireCoefficients& P = Coefficients;
+
+	// PhysX forces are in kg cm/s^2, the formula takes kN and gives N
+	const VectorRegister ToKiloNewtons = VectorSetFloat1(1.e-5f);
+	const VectorRegister FromNewtons = VectorSetFloat1(100.f);
+	const VectorRegister MinLoad = VectorSetFloat1(1.e-3f);
+	const VectorRegister MinPeak = VectorSetFloat1(KINDA_SMALL_NUMBER);
+
+	const VectorRegister Friction = VectorLoad(Batch.TireFriction + Index);
+	const VectorRegister Fz = VectorMax(VectorMultiply(VectorLoad(Batch.TireLoad + Index), ToKiloNewtons), MinLoad);
+	const VectorRegister Fz2 = VectorMultiply(Fz, Fz);
+	const VectorRegister LongSlipPercent = VectorMultiply(VectorLoad(Batch.LongSlip + Index), VectorSetFloat1(100.f));
+	const VectorRegister SlipAngleDegrees = VectorMultiply(VectorLoad(Batch.LatSlip + Index), VectorSetFloat1(180.f / PI));
+
+	// Longitudinal. The surface friction scales the peak, the slip stiffness stays with the tire
+	const VectorRegister Cx = VectorSetFloat1(P.B0);
+	const VectorRegister D0x = VectorMultiply(Fz, VectorMultiplyAdd(VectorSetFloat1(P.B1), Fz, VectorSetFloat1(P.B2)));
+	VectorRegister BCDx = VectorMultiplyAdd(VectorSetFloat1(P.B3), Fz2, VectorMultiply(VectorSetFloat1(P.B4), Fz));
+	if (P.B5 != 0.f)
+	{
+		BCDx = VectorMultiply(BCDx, MakeVectorRegister(
+			FMath::Exp(-P.B5 * VectorGetComponent(Fz, 0)), FMath::Exp(-P.B5 * VectorGetComponent(Fz, 1)),
+			FMath::Exp(-P.B5 * VectorGetComponent(Fz, 2)), FMath::Exp(-P.B5 * VectorGetComponent(Fz, 3))));
+	}
+	const VectorRegister Bx = VectorMultiply(BCDx, VectorReciprocalAccurate(VectorMax(VectorMultiply(Cx, D0x), MinPeak)));
+	const VectorRegister Hx = VectorMultiplyAdd(VectorSetFloat1(P.B9), Fz, VectorSetFloat1(P.B10));
+	const VectorRegister Vx = VectorMultiplyAdd(VectorSetFloat1(P.B11), Fz, VectorSetFloat1(P.B12));
+	const VectorRegister ShiftedLongSlip = VectorAdd(LongSlipPercent, Hx);
+	const VectorRegister SignLongSlip = VectorSelect(VectorCompareGT(GlobalVectorConstants::FloatZero, ShiftedLongSlip), GlobalVectorConstants::FloatMinusOne, GlobalVectorConstants::FloatOne);
+	const VectorRegister Ex = VectorMultiply(
+		VectorMultiplyAdd(VectorSetFloat1(P.B6), Fz2, VectorMultiplyAdd(VectorSetFloat1(P.B7), Fz, VectorSetFloat1(P.B8))),
+		VectorSubtract(GlobalVectorConstants::FloatOne, VectorMultiply(VectorSetFloat1(P.B13), SignLongSlip)));
+	const VectorRegister Dx = VectorMultiply(D0x, Friction);
+	const VectorRegister Fx = VectorAdd(VectorMagicFormula(VectorMultiply(Bx, ShiftedLongSlip), Cx, Dx, Ex), Vx);
+
+	// Lateral, sin(2 atan(u)) = 2u / (1 + u^2)
+	const VectorRegister Cy = VectorSetFloat1(P.A0);
+	const VectorRegister D0y = VectorMultiply(Fz, VectorMultiplyAdd(VectorSetFloat1(P.A1), Fz, VectorSetFloat1(P.A2)));
+	const VectorRegister U = VectorMultiply(Fz, VectorSetFloat1(P.A4 != 0.f ? 1.f / P.A4 : 0.f));
+	const VectorRegister BCDy = VectorMultiply(VectorSetFloat1(2.f * P.A3), VectorMultiply(U, VectorReciprocalAccurate(VectorMultiplyAdd(U, U, GlobalVectorConstants::FloatOne))));
+	const VectorRegister By = VectorMultiply(BCDy, VectorReciprocalAccurate(VectorMax(VectorMultiply(Cy, D0y), MinPeak)));
+	const VectorRegister Hy = VectorMultiplyAdd(VectorSetFloat1(P.A8), Fz, VectorSetFloat1(P.A9));
+	const VectorRegister Vy = VectorMultiplyAdd(VectorSetFloat1(P.A11), Fz, VectorSetFloat1(P.A12));
+	const VectorRegister Ey = VectorMultiplyAdd(VectorSetFloat1(P.A6), Fz, VectorSetFloat1(P.A7));
+	const VectorRegister Dy = VectorMultiply(D0y, Friction);
+	const VectorRegister Fy = VectorAdd(VectorMagicFormula(VectorMultiply(By, VectorAdd(SlipAngleDegrees, Hy)), Cy, Dy, Ey), Vy);
+
+	// Combined slip: scale both forces back onto the friction ellipse when their sum leaves it
+	const VectorRegister NormalizedFx = VectorMultiply(Fx, VectorReciprocalAccurate(VectorMax(Dx, MinPeak)));
+	const VectorRegister NormalizedFy = VectorMultiply(Fy, VectorReciprocalAccurate(VectorMax(Dy, MinPeak)));
+	const VectorRegister EllipseSquared = VectorMultiplyAdd(NormalizedFx, NormalizedFx, VectorMultiply(NormalizedFy, NormalizedFy));
+	const VectorRegister EllipseScale = VectorSelect(VectorCompareGT(EllipseSquared, GlobalVectorConstants::FloatOne), VectorReciprocalSqrtAccurate(EllipseSquared), GlobalVectorConstants::FloatOne);
+
+	// Unloaded tires make no force
+	const VectorRegister bLoaded = VectorCompareGT(VectorLoad(Batch.TireLoad + Index), GlobalVectorConstants::FloatZero);
+	const VectorRegister Scale = VectorSelect(bLoaded, VectorMultiply(EllipseScale, FromNewtons), GlobalVectorConstants::FloatZero);
+
+	// Same sign convention as the default model: the lateral force opposes the slip angle, the wheel torque opposes the drive
+	const VectorRegister LongForce = VectorMultiply(Fx, Scale);
+	const VectorRegister LatForce = VectorNegate(VectorMultiply(Fy, Scale));
+	const VectorRegister WheelTorque = VectorNegate(VectorMultiply(LongForce, VectorLoad(Batch.WheelRadius + Index)));
+
+	VectorStore(LongForce, Batch.LongForce + Index);
+	VectorStore(LatForce, Batch.LatForce + Index);
+	VectorStore(WheelTorque, Batch.WheelTorque + Index);
+}
+
+PRAGMA_ENABLE_DEPRECATION_WARNINGS
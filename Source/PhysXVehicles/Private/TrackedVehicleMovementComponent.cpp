@@ -0,0 +1,256 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "TrackedVehicleMovementComponent.h"
+#include "Components/PrimitiveComponent.h"
+#include "GameFramework/Controller.h"
+#include "PhysXVehicleDriveSetup.h"
+#include "VehicleSimSetup.h"
+
+#include "PhysXPublic.h"
+
+PRAGMA_DISABLE_DEPRECATION_WARNINGS
+
+UTrackedVehicleMovementComponent::UTrackedVehicleMovementComponent(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
+{
+#if PHYSICS_INTERFACE_PHYSX
+	// grab default values from physx
+	GetDefaultVehicleEngineSetup(EngineSetup);
+	GetDefaultVehicleTransmissionSetup(TransmissionSetup);
+
+	// Initialize WheelSetups array with 4 road wheels per track
+	WheelSetups.SetNum(8);
+#endif // WITH_PHYSX
+
+	RawLeftThrustInput = 0.0f;
+	RawRightThrustInput = 0.0f;
+
+	// Does not override GenerateTireForces, so the default tire model runs natively. Subclasses overriding it set this back
+	bCallGenerateTireForces = false;
+}
+
+#if WITH_EDITOR
+void UTrackedVehicleMovementComponent::PostEditChangeProperty(struct FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+	const FName PropertyName = PropertyChangedEvent.Property ? PropertyChangedEvent.Property->GetFName() : NAME_None;
+
+	if (PropertyName == TEXT("DownRatio"))
+	{
+		for (int32 GearIdx = 0; GearIdx < TransmissionSetup.ForwardGears.Num(); ++GearIdx)
+		{
+			FVehicleGearData & GearData = TransmissionSetup.ForwardGears[GearIdx];
+			GearData.DownRatio = FMath::Min(GearData.DownRatio, GearData.UpRatio);
+		}
+	}
+	else if (PropertyName == TEXT("UpRatio"))
+	{
+		for (int32 GearIdx = 0; GearIdx < TransmissionSetup.ForwardGears.Num(); ++GearIdx)
+		{
+			FVehicleGearData & GearData = TransmissionSetup.ForwardGears[GearIdx];
+			GearData.UpRatio = FMath::Max(GearData.DownRatio, GearData.UpRatio);
+		}
+	}
+}
+#endif
+
+void UTrackedVehicleMovementComponent::SetTrackThrustInput(float LeftThrust, float RightThrust)
+{
+	// Kept apart from throttle and steering, whose auto reverse would swap the tracks when backing up
+	const float NewLeftThrust = FMath::Clamp(LeftThrust, -1.0f, 1.0f);
+	const float NewRightThrust = FMath::Clamp(RightThrust, -1.0f, 1.0f);
+	if (NewLeftThrust != RawLeftThrustInput || NewRightThrust != RawRightThrustInput)
+	{
+		RawLeftThrustInput = NewLeftThrust;
+		RawRightThrustInput = NewRightThrust;
+
+		// Only on change, unlike the other inputs it is not sent every tick
+		ServerUpdateTrackThrust(RawLeftThrustInput, RawRightThrustInput);
+	}
+}
+
+void UTrackedVehicleMovementComponent::UpdateState(float DeltaTime)
+{
+	Super::UpdateState(DeltaTime);
+
+	AController* Controller = GetController();
+	if (!(Controller && Controller->IsLocalController()))
+	{
+		// use replicated values for remote pawns
+		RawLeftThrustInput = ReplicatedState.LeftThrustInput;
+		RawRightThrustInput = ReplicatedState.RightThrustInput;
+	}
+}
+
+/// @cond DOXYGEN_WARNINGS
+
+bool UTrackedVehicleMovementComponent::ServerUpdateTrackThrust_Validate(float InLeftThrust, float InRightThrust)
+{
+	return true;
+}
+
+void UTrackedVehicleMovementComponent::ServerUpdateTrackThrust_Implementation(float InLeftThrust, float InRightThrust)
+{
+	RawLeftThrustInput = FMath::Clamp(InLeftThrust, -1.0f, 1.0f);
+	RawRightThrustInput = FMath::Clamp(InRightThrust, -1.0f, 1.0f);
+
+	// update state of inputs
+	ReplicatedState.LeftThrustInput = RawLeftThrustInput;
+	ReplicatedState.RightThrustInput = RawRightThrustInput;
+}
+
+/// @endcond
+
+FReplicatedVehicleState UTrackedVehicleMovementComponent::GetSimulationInputState() const
+{
+	FReplicatedVehicleState State = Super::GetSimulationInputState();
+	State.LeftThrustInput = RawLeftThrustInput;
+	State.RightThrustInput = RawRightThrustInput;
+	return State;
+}
+
+void UTrackedVehicleMovementComponent::SetSimulationInputState(const FReplicatedVehicleState& InState)
+{
+	Super::SetSimulationInputState(InState);
+	RawLeftThrustInput = InState.LeftThrustInput;
+	RawRightThrustInput = InState.RightThrustInput;
+}
+
+#if WITH_PHYSX_VEHICLES
+
+void UTrackedVehicleMovementComponent::SetupVehicleDrive(PxVehicleWheelsSimData* PWheelsSimData)
+{
+	// Left and right wheels come in pairs
+	const int32 NumWheels = WheelSetups.Num();
+	if (NumWheels < 2 || NumWheels > PX_MAX_NB_WHEELS || (NumWheels % 2) != 0)
+	{
+		PVehicle = nullptr;
+		PVehicleDrive = nullptr;
+		return;
+	}
+
+	// Setup drive data
+	PxVehicleDriveSimData DriveData;
+	if (!CanUseCompiledSimSetup() || !CompiledSimSetup->GetDriveSimData(PxVehicleTypes::eDRIVETANK, DriveData))
+	{
+		SetupVehicleDriveSimData(EngineSetup, TransmissionSetup, DriveData);
+	}
+
+	// Create the vehicle
+	PxVehicleDriveTank* PVehicleDriveTank = PxVehicleDriveTank::allocate(NumWheels);
+	check(PVehicleDriveTank);
+
+	FPhysicsCommand::ExecuteWrite(UpdatedPrimitive->GetBodyInstance()->ActorHandle, [&](const FPhysicsActorHandle& Actor)
+	{
+#if WITH_CHAOS || WITH_IMMEDIATE_PHYSX
+		PxRigidActor* PRigidActor = nullptr;
+#else
+		PxRigidActor* PRigidActor = Actor.SyncActor;
+#endif
+
+		if (PRigidActor)
+		{
+			if (PxRigidDynamic* PRigidDynamic = PRigidActor->is<PxRigidDynamic>())
+			{
+				PVehicleDriveTank->setup(GPhysXSDK, PRigidDynamic, *PWheelsSimData, DriveData, NumWheels);
+				PVehicleDriveTank->setDriveModel(PxVehicleDriveTankControlModel::eSPECIAL);
+				PVehicleDriveTank->setToRestState();
+
+				// cleanup
+				PWheelsSimData->free();
+			}
+		}
+	});
+
+	// cache values
+	PVehicle = PVehicleDriveTank;
+	PVehicleDrive = PVehicleDriveTank;
+
+	SetUseAutoGears(TransmissionSetup.bUseGearAutoBox);
+}
+
+void UTrackedVehicleMovementComponent::UpdateSimulation_AssumesLocked(float DeltaTime)
+{
+	if (PVehicleDrive == NULL)
+		return;
+
+	// Use the track thrust as set, otherwise mix throttle and steering into it. The engine revs for the busier track
+	const bool bUseTrackThrust = RawLeftThrustInput != 0.0f || RawRightThrustInput != 0.0f;
+	const float LeftThrust = bUseTrackThrust ? RawLeftThrustInput : FMath::Clamp(ThrottleInput + SteeringInput, -1.0f, 1.0f);
+	const float RightThrust = bUseTrackThrust ? RawRightThrustInput : FMath::Clamp(ThrottleInput - SteeringInput, -1.0f, 1.0f);
+	const float Accel = FMath::Max(FMath::Abs(LeftThrust), FMath::Abs(RightThrust));
+
+	// Only brake a track as much as it isn't driven, otherwise the auto brake at standstill would stop the tank turning on the spot
+	const float LeftBrake = FMath::Max(BrakeInput * (1.0f - FMath::Abs(LeftThrust)), HandbrakeInput);
+	const float RightBrake = FMath::Max(BrakeInput * (1.0f - FMath::Abs(RightThrust)), HandbrakeInput);
+
+	PxVehicleDriveTankRawInputData RawInputData(PxVehicleDriveTankControlModel::eSPECIAL);
+	RawInputData.setAnalogAccel(Accel);
+	RawInputData.setAnalogLeftThrust(LeftThrust);
+	RawInputData.setAnalogRightThrust(RightThrust);
+	RawInputData.setAnalogLeftBrake(LeftBrake);
+	RawInputData.setAnalogRightBrake(RightBrake);
+
+	if (!PVehicleDrive->mDriveDynData.getUseAutoGears())
+	{
+		RawInputData.setGearUp(bRawGearUpInput);
+		RawInputData.setGearDown(bRawGearDownInput);
+	}
+
+	PxVehiclePadSmoothingData SmoothData = {
+		{ ThrottleInputRate.RiseRate, BrakeInputRate.RiseRate, BrakeInputRate.RiseRate, ThrottleInputRate.RiseRate, ThrottleInputRate.RiseRate },
+		{ ThrottleInputRate.FallRate, BrakeInputRate.FallRate, BrakeInputRate.FallRate, ThrottleInputRate.FallRate, ThrottleInputRate.FallRate }
+	};
+
+	PxVehicleDriveTank* PVehicleDriveTank = (PxVehicleDriveTank*)PVehicleDrive;
+	PxVehicleDriveTankSmoothAnalogRawInputsAndSetAnalogInputs(SmoothData, RawInputData, DeltaTime, *PVehicleDriveTank);
+}
+
+#endif // WITH_PHYSX_VEHICLES
+
+
+void UTrackedVehicleMovementComponent::UpdateEngineSetup(const FVehicleEngineData& NewEngineSetup)
+{
+#if PHYSICS_INTERFACE_PHYSX
+	if (PVehicleDrive)
+	{
+		PxVehicleEngineData EngineData;
+		GetVehicleEngineSetup(NewEngineSetup, EngineData);
+
+		PxVehicleDriveTank* PVehicleDriveTank = (PxVehicleDriveTank*)PVehicleDrive;
+		PVehicleDriveTank->mDriveSimData.setEngineData(EngineData);
+	}
+#endif // WITH_PHYSX
+}
+
+void UTrackedVehicleMovementComponent::UpdateTransmissionSetup(const FVehicleTransmissionData& NewTransmissionSetup)
+{
+#if PHYSICS_INTERFACE_PHYSX
+	if (PVehicleDrive)
+	{
+		PxVehicleGearsData GearData;
+		GetVehicleGearSetup(NewTransmissionSetup, GearData);
+
+		PxVehicleAutoBoxData AutoBoxData;
+		GetVehicleAutoBoxSetup(NewTransmissionSetup, AutoBoxData);
+
+		PxVehicleDriveTank* PVehicleDriveTank = (PxVehicleDriveTank*)PVehicleDrive;
+		PVehicleDriveTank->mDriveSimData.setGearsData(GearData);
+		PVehicleDriveTank->mDriveSimData.setAutoBoxData(AutoBoxData);
+	}
+#endif // WITH_PHYSX
+}
+
+void UTrackedVehicleMovementComponent::ComputeConstants()
+{
+	Super::ComputeConstants();
+	MaxEngineRPM = EngineSetup.MaxRPM;
+}
+
+uint32 UTrackedVehicleMovementComponent::GetSimSetupSourceHash() const
+{
+	uint32 Hash = Super::GetSimSetupSourceHash();
+	Hash = UVehicleSimSetup::HashProperties(FVehicleEngineData::StaticStruct(), &EngineSetup, Hash);
+	return UVehicleSimSetup::HashProperties(FVehicleTransmissionData::StaticStruct(), &TransmissionSetup, Hash);
+}
+
+PRAGMA_ENABLE_DEPRECATION_WARNINGS
@@ -9,6 +9,8 @@
 #include "WheeledVehicleMovementComponent.h"
 #include "WheeledVehicle.h"
 #include "AnimationRuntime.h"
+#include "PhysXVehicleStats.h"
+#include "PhysXVehicleManager.h"
 
 PRAGMA_DISABLE_DEPRECATION_WARNINGS
 
@@ -78,28 +80,23 @@ void FVehicleAnimInstanceProxy::SetWheeledVehicleMovementComponent(const UWheele
 
 void FVehicleAnimInstanceProxy::PreUpdate(UAnimInstance* InAnimInstance, float DeltaSeconds)
 {
+	PHYSX_VEHICLE_SCOPE_CYCLE_COUNTER(STAT_PhysXVehicle_AnimProxyPreUpdate);
+	PHYSX_VEHICLE_TRACE_SCOPE(PhysXVehicle_AnimProxyPreUpdate);
+
 	Super::PreUpdate(InAnimInstance, DeltaSeconds);
 
 	const UVehicleAnimInstance* VehicleAnimInstance = CastChecked<UVehicleAnimInstance>(InAnimInstance);
 	if(const UWheeledVehicleMovementComponent* WheeledVehicleMovementComponent = VehicleAnimInstance->GetWheeledVehicleMovementComponent())
 	{
-		for (int32 WheelIndex = 0; WheelIndex < WheelInstances.Num(); ++ WheelIndex)
+#if WITH_PHYSX_VEHICLES
+		// The manager publishes the wheels' anim data packed after each physics step on the game thread, copy it as is without a lock
+		if (const FPhysXVehicleManager* VehicleManager = WheeledVehicleMovementComponent->OwningVehicleManager)
 		{
-			FWheelAnimData& WheelInstance = WheelInstances[WheelIndex];
-			if (WheeledVehicleMovementComponent->Wheels.IsValidIndex(WheelIndex))
-			{
-				if (const UVehicleWheel* VehicleWheel = WheeledVehicleMovementComponent->Wheels[WheelIndex])
-				{
-					WheelInstance.RotOffset.Pitch = VehicleWheel->GetRotationAngle();
-					WheelInstance.RotOffset.Yaw = VehicleWheel->GetSteerAngle();
-					WheelInstance.RotOffset.Roll = 0.f;
-
-					WheelInstance.LocOffset.X = 0.f;
-					WheelInstance.LocOffset.Y = 0.f;
-					WheelInstance.LocOffset.Z = VehicleWheel->GetSuspensionOffset();
-				}
-			}
+			const int32 VehicleIndex = WheeledVehicleMovementComponent->VehicleManagerIndex;
+			const int32 NumWheels = FMath::Min(WheelInstances.Num(), VehicleManager->GetNumWheels(VehicleIndex));
+			FMemory::Memcpy(WheelInstances.GetData(), VehicleManager->GetWheelAnimData(VehicleIndex), NumWheels * sizeof(FWheelAnimData));
 		}
+#endif // WITH_PHYSX
 	}
 }
 
@@ -0,0 +1,149 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "VehicleSimSetup.h"
+#include "EngineDefines.h"
+#include "UObject/UnrealType.h"
+#include "PhysXPublic.h"
+
+PRAGMA_DISABLE_DEPRECATION_WARNINGS
+
+#if PHYSICS_INTERFACE_PHYSX
+
+// Everything PxVehicleWheelsSimData needs per wheel, all plain data
+// PxVehicleWheelsSimData 每个车轮所需的全部数据，均为普通数据
+struct FCompiledWheelRecord
+{
+	PxVehicleWheelData			WheelData;
+	PxVehicleTireData			TireData;
+	PxVehicleSuspensionData		SuspensionData;
+	PxVec3						SuspTravelDirection;
+	PxVec3						WheelCentreOffset;
+	PxVec3						SuspForceAppPointOffset;
+	PxVec3						TireForceAppPointOffset;
+};
+
+#endif // WITH_PHYSX
+
+UVehicleSimSetup::UVehicleSimSetup()
+{
+	NumWheels = 0;
+	ChassisMass = 0.f;
+	VehicleType = INDEX_NONE;
+	PhysXVersion = 0;
+	WheelRecordSize = 0;
+	SourceHash = 0;
+}
+
+bool UVehicleSimSetup::IsCompatible(int32 InNumWheels, float InMass, uint32 InSourceHash) const
+{
+#if PHYSICS_INTERFACE_PHYSX
+	return NumWheels == InNumWheels
+		&& ChassisMass == InMass
+		&& SourceHash == InSourceHash
+		&& PhysXVersion == (int32)PX_PHYSICS_VERSION
+		&& WheelRecordSize == sizeof(FCompiledWheelRecord)
+		&& WheelRecords.Num() == NumWheels * WheelRecordSize
+		&& WheelRestingPositions.Num() == NumWheels;
+#else
+	return false;
+#endif // WITH_PHYSX
+}
+
+uint32 UVehicleSimSetup::HashProperties(const UStruct* Struct, const void* Data, uint32 Hash)
+{
+	FString ValueText;
+	for (TFieldIterator<FProperty> It(Struct); It; ++It)
+	{
+		const FProperty* Property = *It;
+		if (Property->HasAnyPropertyFlags(CPF_Transient))
+		{
+			continue;
+		}
+
+		for (int32 Idx = 0; Idx < Property->ArrayDim; ++Idx)
+		{
+			ValueText.Reset();
+			Property->ExportTextItem(ValueText, Property->ContainerPtrToValuePtr<void>(Data, Idx), nullptr, nullptr, PPF_None);
+			Hash = HashCombine(Hash, GetTypeHash(Property->GetFName()));
+			Hash = HashCombine(Hash, GetTypeHash(ValueText));
+		}
+	}
+
+	return Hash;
+}
+
+#if PHYSICS_INTERFACE_PHYSX
+
+void UVehicleSimSetup::Compile(const PxVehicleWheels& PVehicle, const TArray<FVector>& InWheelRestingPositions, float InChassisMass, uint32 InSourceHash)
+{
+	const PxVehicleWheelsSimData& PWheelsSimData = PVehicle.mWheelsSimData;
+
+	NumWheels = PWheelsSimData.getNbWheels();
+	ChassisMass = InChassisMass;
+	VehicleType = PVehicle.getVehicleType();
+	WheelRestingPositions = InWheelRestingPositions;
+	PhysXVersion = (int32)PX_PHYSICS_VERSION;
+	WheelRecordSize = sizeof(FCompiledWheelRecord);
+	SourceHash = InSourceHash;
+
+	WheelRecords.SetNumZeroed(NumWheels * WheelRecordSize);
+	FCompiledWheelRecord* Records = (FCompiledWheelRecord*)WheelRecords.GetData();
+	for (int32 WheelIdx = 0; WheelIdx < NumWheels; ++WheelIdx)
+	{
+		FCompiledWheelRecord& Record = Records[WheelIdx];
+		Record.WheelData = PWheelsSimData.getWheelData(WheelIdx);
+		Record.TireData = PWheelsSimData.getTireData(WheelIdx);
+		Record.SuspensionData = PWheelsSimData.getSuspensionData(WheelIdx);
+		Record.SuspTravelDirection = PWheelsSimData.getSuspTravelDirection(WheelIdx);
+		Record.WheelCentreOffset = PWheelsSimData.getWheelCentreOffset(WheelIdx);
+		Record.SuspForceAppPointOffset = PWheelsSimData.getSuspForceAppPointOffset(WheelIdx);
+		Record.TireForceAppPointOffset = PWheelsSimData.getTireForceAppPointOffset(WheelIdx);
+	}
+
+	const void* PDriveSimData = nullptr;
+	int32 DriveSimDataSize = 0;
+	switch (VehicleType)
+	{
+	case PxVehicleTypes::eDRIVE4W:
+		PDriveSimData = &((const PxVehicleDrive4W&)PVehicle).mDriveSimData;
+		DriveSimDataSize = sizeof(PxVehicleDriveSimData4W);
+		break;
+	case PxVehicleTypes::eDRIVENW:
+		PDriveSimData = &((const PxVehicleDriveNW&)PVehicle).mDriveSimData;
+		DriveSimDataSize = sizeof(PxVehicleDriveSimDataNW);
+		break;
+	case PxVehicleTypes::eDRIVETANK:
+		PDriveSimData = &((const PxVehicleDriveTank&)PVehicle).mDriveSimData;
+		DriveSimDataSize = sizeof(PxVehicleDriveSimData);
+		break;
+	default:
+		break;
+	}
+
+	DriveSimData.SetNumUninitialized(DriveSimDataSize);
+	if (PDriveSimData)
+	{
+		FMemory::Memcpy(DriveSimData.GetData(), PDriveSimData, DriveSimDataSize);
+	}
+}
+
+void UVehicleSimSetup::ApplyWheelsSimData(PxVehicleWheelsSimData& PWheelsSimData) const
+{
+	const int32 NumRecords = FMath::Min<int32>(NumWheels, PWheelsSimData.getNbWheels());
+	const FCompiledWheelRecord* Records = (const FCompiledWheelRecord*)WheelRecords.GetData();
+	for (int32 WheelIdx = 0; WheelIdx < NumRecords; ++WheelIdx)
+	{
+		const FCompiledWheelRecord& Record = Records[WheelIdx];
+		PWheelsSimData.setWheelData(WheelIdx, Record.WheelData);
+		PWheelsSimData.setTireData(WheelIdx, Record.TireData);
+		PWheelsSimData.setSuspensionData(WheelIdx, Record.SuspensionData);
+		PWheelsSimData.setSuspTravelDirection(WheelIdx, Record.SuspTravelDirection);
+		PWheelsSimData.setWheelCentreOffset(WheelIdx, Record.WheelCentreOffset);
+		PWheelsSimData.setSuspForceAppPointOffset(WheelIdx, Record.SuspForceAppPointOffset);
+		PWheelsSimData.setTireForceAppPointOffset(WheelIdx, Record.TireForceAppPointOffset);
+	}
+}
+
+#endif // WITH_PHYSX
+
+PRAGMA_ENABLE_DEPRECATION_WARNINGS
@@ -39,13 +39,15 @@ UVehicleWheel::UVehicleWheel(const FObjectInitializer& ObjectInitializer)
 	SuspensionNaturalFrequency = 7.0f;
 	SuspensionDampingRatio = 1.0f;
 	SweepType = EWheelSweepType::SimpleAndComplex;
+	TireModel = ETireModelType::Default;
+	NativeTireModel = nullptr;
 }
 
 #if WITH_PHYSX_VEHICLES
 FPhysXVehicleManager* UVehicleWheel::GetVehicleManager() const
 {
-	UWorld* World = GEngine->GetWorldFromContextObject(VehicleSim, EGetWorldErrorMode::LogAndReturnNull);
-	return World ? FPhysXVehicleManager::GetVehicleManagerFromScene(World->GetPhysicsScene()) : nullptr;
+	// The manager keeps the vehicle's registration and slot up to date, see FPhysXVehicleManager::AddVehicle
+	return VehicleSim ? VehicleSim->OwningVehicleManager : nullptr;
 }
 #endif // WITH_PHYSX
 
@@ -55,7 +57,7 @@ float UVehicleWheel::GetSteerAngle() const
 	if (FPhysXVehicleManager* VehicleManager = GetVehicleManager())
 	{
 		SCOPED_SCENE_READ_LOCK(VehicleManager->GetScene());
-		return FMath::RadiansToDegrees(VehicleManager->GetWheelsStates_AssumesLocked(VehicleSim)[WheelIndex].steerAngle);
+		return FMath::RadiansToDegrees(VehicleManager->GetWheelsStates_AssumesLocked(VehicleSim->VehicleManagerIndex)[WheelIndex].steerAngle);
 	}
 #endif // WITH_PHYSX
 	return 0.0f;
@@ -83,7 +85,7 @@ float UVehicleWheel::GetSuspensionOffset() const
 	{
 		SCOPED_SCENE_READ_LOCK(VehicleManager->GetScene());
 
-		return VehicleManager->GetWheelsStates_AssumesLocked(VehicleSim)[WheelIndex].suspJounce;
+		return VehicleManager->GetWheelsStates_AssumesLocked(VehicleSim->VehicleManagerIndex)[WheelIndex].suspJounce;
 	}
 #endif // WITH_PHYSX
 	return 0.0f;
@@ -96,7 +98,7 @@ bool UVehicleWheel::IsInAir() const
 	{
 		SCOPED_SCENE_READ_LOCK(VehicleManager->GetScene());
 
-		return VehicleManager->GetWheelsStates_AssumesLocked(VehicleSim)[WheelIndex].isInAir;
+		return VehicleManager->GetWheelsStates_AssumesLocked(VehicleSim->VehicleManagerIndex)[WheelIndex].isInAir;
 	}
 #endif // WITH_PHYSX
 	return false;
@@ -110,10 +112,21 @@ void UVehicleWheel::Init( UWheeledVehicleMovementComponent* InVehicleSim, int32
 	VehicleSim = InVehicleSim;
 	WheelIndex = InWheelIndex;
 
+	if (TireModel == ETireModelType::Pacejka)
+	{
+		NativeTireModel = TireConfig ? &TireConfig->GetPacejkaTireModel() : &FPacejkaTireModel::GetDefault();
+	}
+	else
+	{
+		NativeTireModel = nullptr;
+	}
+
 #if WITH_PHYSX_VEHICLES
 	WheelShape = NULL;
 
-	FPhysXVehicleManager* VehicleManager = FPhysXVehicleManager::GetVehicleManagerFromScene(VehicleSim->GetWorld()->GetPhysicsScene());
+	// The vehicle is registered with the manager before its wheels are created
+	FPhysXVehicleManager* VehicleManager = GetVehicleManager();
+	check(VehicleManager);
 	SCOPED_SCENE_READ_LOCK(VehicleManager->GetScene());
 
 	const int32 WheelShapeIdx = VehicleSim->PVehicle->mWheelsSimData.getWheelShapeMapping( WheelIndex );
@@ -129,6 +142,8 @@ void UVehicleWheel::Init( UWheeledVehicleMovementComponent* InVehicleSim, int32
 
 void UVehicleWheel::Shutdown()
 {
+	NativeTireModel = nullptr;
+
 #if WITH_PHYSX_VEHICLES
 	WheelShape = NULL;
 #endif // WITH_PHYSX
@@ -146,6 +161,13 @@ void UVehicleWheel::Tick( float DeltaTime )
 	Velocity = ( Location - OldLocation ) / DeltaTime;
 }
 
+void UVehicleWheel::SetWorldState( const FVector& InLocation, const FVector& InVelocity )
+{
+	OldLocation = Location;
+	Location = InLocation;
+	Velocity = InVelocity;
+}
+
 FVector UVehicleWheel::GetPhysicsLocation()
 {
 #if WITH_PHYSX_VEHICLES
@@ -153,10 +175,8 @@ FVector UVehicleWheel::GetPhysicsLocation()
 	{
 		if (FPhysXVehicleManager* VehicleManager = GetVehicleManager())
 		{
-			SCOPED_SCENE_READ_LOCK(VehicleManager->GetScene());
-
-			PxVec3 PLocation = VehicleSim->PVehicle->getRigidDynamicActor()->getGlobalPose().transform(WheelShape->getLocalPose()).p;
-			return P2UVector(PLocation);
+			// Filled by the manager's bulk wheel update, no lock needed
+			return VehicleManager->GetWheelWorldTransform(VehicleSim->VehicleManagerIndex, WheelIndex).GetLocation();
 		}
 	}
 #endif // WITH_PHYSX
@@ -183,13 +203,15 @@ UPhysicalMaterial* UVehicleWheel::GetContactSurfaceMaterial()
 	UPhysicalMaterial* PhysMaterial = NULL;
 
 #if WITH_PHYSX_VEHICLES
-	FPhysXVehicleManager* VehicleManager = FPhysXVehicleManager::GetVehicleManagerFromScene(VehicleSim->GetWorld()->GetPhysicsScene());
-	SCOPED_SCENE_READ_LOCK(VehicleManager->GetScene());
-
-	const PxMaterial* ContactSurface = VehicleManager->GetWheelsStates_AssumesLocked(VehicleSim)[WheelIndex].tireSurfaceMaterial;
-	if (ContactSurface)
+	if (FPhysXVehicleManager* VehicleManager = GetVehicleManager())
 	{
-		PhysMaterial = FPhysxUserData::Get<UPhysicalMaterial>(ContactSurface->userData);
+		SCOPED_SCENE_READ_LOCK(VehicleManager->GetScene());
+
+		const PxMaterial* ContactSurface = VehicleManager->GetWheelsStates_AssumesLocked(VehicleSim->VehicleManagerIndex)[WheelIndex].tireSurfaceMaterial;
+		if (ContactSurface)
+		{
+			PhysMaterial = FPhysxUserData::Get<UPhysicalMaterial>(ContactSurface->userData);
+		}
 	}
 #endif // WITH_PHYSX
 
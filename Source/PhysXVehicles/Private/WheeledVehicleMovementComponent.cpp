@@ -22,10 +22,15 @@
 #include "GameFramework/PawnMovementComponent.h"
 #include "Logging/MessageLog.h"
 #include "TireConfig.h"
+#include "TireModel.h"
+#include "VehicleSimSetup.h"
 #include "DisplayDebugHelpers.h"
+#include "HAL/IConsoleManager.h"
 
 #include "PhysXPublic.h"
 #include "PhysXVehicleManager.h"
+#include "PhysXVehicleStats.h"
+#include "PhysXVehicleWheelCount.h"
 
 #include "AI/Navigation/AvoidanceManager.h"
 #include "PhysicalMaterials/PhysicalMaterial.h"
@@ -36,6 +41,8 @@
 PRAGMA_DISABLE_DEPRECATION_WARNINGS
 
 #if PHYSICS_INTERFACE_PHYSX
+static void ComputeDefaultTireForces(const void* TireData, const FTireShaderInput& Input, FTireShaderOutput& Output);
+
 /**
  * PhysX shader for tire friction forces
  * tireFriction - friction value of the tire contact.
@@ -62,7 +69,11 @@ void PTireShader(const void* shaderData, const PxF32 tireFriction,
 	const PxF32 gravity, const PxF32 recipGravity,
 	PxF32& wheelTorque, PxF32& tireLongForceMag, PxF32& tireLatForceMag, PxF32& tireAlignMoment)
 {
-	UVehicleWheel* Wheel = (UVehicleWheel*)shaderData;
+	PHYSX_VEHICLE_TIRE_SHADER_SCOPE_CYCLE_COUNTER(STAT_PhysXVehicle_TireShader);
+	PHYSX_VEHICLE_TIRE_SHADER_INC_COUNTER(STAT_PhysXVehicle_TireShaderCalls);
+
+	// The manager's block for this wheel, published to the UVehicleWheel once PxVehicleUpdates returns
+	FTireShaderWheelData& WheelData = *(FTireShaderWheelData*)shaderData;
 
 	FTireShaderInput Input;
 
@@ -80,19 +91,31 @@ void PTireShader(const void* shaderData, const PxF32 tireFriction,
 
 	FTireShaderOutput Output(0.0f);
 
-	Wheel->VehicleSim->GenerateTireForces( Wheel, Input, Output );
+	// Native models run here without calling back into the component. PhysX shades one wheel at a time, so this is a batch of one
+	if ( WheelData.TireModel )
+	{
+		WheelData.TireModel->Evaluate( Input, Output );
+	}
+	else if ( WheelData.Wheel )
+	{
+		WheelData.Wheel->VehicleSim->GenerateTireForces( WheelData.Wheel, Input, Output );
+	}
+	else
+	{
+		ComputeDefaultTireForces( WheelData.TireData, Input, Output );
+	}
 
 	wheelTorque = Output.WheelTorque;
 	tireLongForceMag = Output.LongForce;
 	tireLatForceMag = Output.LatForce;
 	
-	Wheel->DebugLongSlip = longSlip;
-	Wheel->DebugLatSlip = latSlip;
-	Wheel->DebugNormalizedTireLoad = normalisedTireLoad;
-	Wheel->DebugTireLoad = tireLoad;
-	Wheel->DebugWheelTorque = wheelTorque;
-	Wheel->DebugLongForce = tireLongForceMag;
-	Wheel->DebugLatForce = tireLatForceMag;
+	WheelData.LongSlip = longSlip;
+	WheelData.LatSlip = latSlip;
+	WheelData.NormalizedTireLoad = normalisedTireLoad;
+	WheelData.TireLoad = tireLoad;
+	WheelData.WheelTorque = wheelTorque;
+	WheelData.LongForce = tireLongForceMag;
+	WheelData.LatForce = tireLatForceMag;
 }
 
 #endif // WITH_PHYSX
@@ -139,9 +162,24 @@ UWheeledVehicleMovementComponent::UWheeledVehicleMovementComponent(const FObject
     ThresholdLongitudinalSpeed = 5.f;
     LowForwardSpeedSubStepCount = 3;
     HighForwardSpeedSubStepCount = 1;
+	bUseSuspensionSweeps = false;
+	InstancedWheelMesh = nullptr;
+	InstancedWheelsDistance = 5000.f;
+	KinematicLODDistance = 0.f;
+	bCallGenerateTireForces = true;
+	CompiledSimSetup = nullptr;
+	bUsingInstancedWheels = false;
+	bSavedNoSkeletonUpdate = false;
+	bBodyHeldForCreation = false;
+	bUseCompiledSimSetup = false;
 	
 	bReverseAsBrake = true;	//Treats reverse button as break for a more arcade feel (also automatically goes into reverse)
 
+#if WITH_PHYSX
+	OwningVehicleManager = nullptr;
+	VehicleManagerIndex = INDEX_NONE;
+#endif // WITH_PHYSX
+
 #if PHYSICS_INTERFACE_PHYSX
 	// tire load filtering
 	PxVehicleTireLoadFilterData PTireLoadFilterDef;
@@ -173,6 +211,72 @@ void UWheeledVehicleMovementComponent::SetUpdatedComponent(USceneComponent* NewU
 	}
 }
 
+void UWheeledVehicleMovementComponent::SetUseInstancedWheels(bool bEnable)
+{
+	if (bUsingInstancedWheels == bEnable)
+	{
+		return;
+	}
+
+	USkeletalMeshComponent* MeshComp = Cast<USkeletalMeshComponent>(UpdatedComponent);
+	if (MeshComp == nullptr)
+	{
+		return;
+	}
+
+	bUsingInstancedWheels = bEnable;
+
+	for (const FWheelSetup& WheelSetup : WheelSetups)
+	{
+		if (bEnable)
+		{
+			MeshComp->HideBoneByName(WheelSetup.BoneName, PBO_None);
+		}
+		else
+		{
+			MeshComp->UnHideBoneByName(WheelSetup.BoneName);
+		}
+	}
+
+	if (bEnable)
+	{
+		// Evaluate once more so the hidden wheel bones are applied, then freeze the skeleton. The chassis still follows its body
+		MeshComp->RefreshBoneTransforms();
+		bSavedNoSkeletonUpdate = MeshComp->bNoSkeletonUpdate;
+		MeshComp->bNoSkeletonUpdate = true;
+	}
+	else
+	{
+		MeshComp->bNoSkeletonUpdate = bSavedNoSkeletonUpdate;
+	}
+}
+
+void UWheeledVehicleMovementComponent::CompileSimSetup()
+{
+#if WITH_PHYSX_VEHICLES
+	if (CompiledSimSetup == nullptr || PVehicle == nullptr)
+	{
+		return;
+	}
+
+	TArray<FVector> WheelRestingPositions;
+	for (const FWheelSetup& WheelSetup : WheelSetups)
+	{
+		WheelRestingPositions.Add(GetWheelRestingPosition(WheelSetup));
+	}
+
+	{
+		FPhysXVehicleManager* MyVehicleManager = FPhysXVehicleManager::GetVehicleManagerFromScene(GetWorld()->GetPhysicsScene());
+		SCOPED_SCENE_READ_LOCK(MyVehicleManager->GetScene());
+
+		CompiledSimSetup->Compile(*PVehicle, WheelRestingPositions, Mass, GetSimSetupSourceHash());
+	}
+
+	CompiledSimSetup->MarkPackageDirty();
+	UE_LOG(LogVehicles, Log, TEXT("Compiled the sim setup of %s into %s"), *GetPathName(), *CompiledSimSetup->GetPathName());
+#endif // WITH_PHYSX_VEHICLES
+}
+
 #if WITH_PHYSX_VEHICLES
 
 void UWheeledVehicleMovementComponent::ShowDebugInfo(AHUD* HUD, UCanvas* Canvas, const FDebugDisplayInfo& DisplayInfo, float& YL, float& YPos)
@@ -228,6 +332,38 @@ bool UWheeledVehicleMovementComponent::CanCreateVehicle() const
 	return true;
 }
 
+/** SetupVehicle times of vehicles that derived their sim data [0] and of vehicles that copied a compiled sim setup [1] */
+struct FVehicleSetupTimes
+{
+	int32 NumSetups = 0;
+	double TotalSeconds = 0.0;
+	double MaxSeconds = 0.0;
+};
+
+static FVehicleSetupTimes GVehicleSetupTimes[2];
+
+static FAutoConsoleCommand GVehicleSetupTimesCommand(
+	TEXT("p.Vehicle.SetupTimes"),
+	TEXT("Log the average and worst SetupVehicle time of vehicles spawned from a compiled sim setup and of those deriving their sim data. Usage: p.Vehicle.SetupTimes [reset]"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		if (Args.Num() > 0 && Args[0] == TEXT("reset"))
+		{
+			GVehicleSetupTimes[0] = FVehicleSetupTimes();
+			GVehicleSetupTimes[1] = FVehicleSetupTimes();
+			return;
+		}
+
+		static const TCHAR* PathNames[] = { TEXT("derived"), TEXT("compiled sim setup") };
+		for (int32 PathIdx = 0; PathIdx < 2; ++PathIdx)
+		{
+			const FVehicleSetupTimes& SetupTimes = GVehicleSetupTimes[PathIdx];
+			UE_LOG(LogVehicles, Display, TEXT("Vehicle setup, %s: %d vehicles, average %.3f ms, worst %.3f ms"), PathNames[PathIdx], SetupTimes.NumSetups,
+				SetupTimes.NumSetups > 0 ? SetupTimes.TotalSeconds * 1000.0 / SetupTimes.NumSetups : 0.0, SetupTimes.MaxSeconds * 1000.0);
+		}
+	})
+);
+
 void UWheeledVehicleMovementComponent::CreateVehicle()
 {
 	ComputeConstants();
@@ -241,8 +377,22 @@ void UWheeledVehicleMovementComponent::CreateVehicle()
 			if (ensure(UpdatedPrimitive != nullptr))
 			{
 				check(UpdatedPrimitive->GetBodyInstance()->IsDynamic());
-				
-				SetupVehicle();
+
+				{
+					PHYSX_VEHICLE_SCOPE_CYCLE_COUNTER(STAT_PhysXVehicle_SetupVehicle);
+					const double SetupStartTime = FPlatformTime::Seconds();
+
+					SetupVehicle();
+
+					const double SetupSeconds = FPlatformTime::Seconds() - SetupStartTime;
+					FVehicleSetupTimes& SetupTimes = GVehicleSetupTimes[CanUseCompiledSimSetup() ? 1 : 0];
+					SetupTimes.NumSetups++;
+					SetupTimes.TotalSeconds += SetupSeconds;
+					SetupTimes.MaxSeconds = FMath::Max(SetupTimes.MaxSeconds, SetupSeconds);
+
+					UE_LOG( LogVehicles, Verbose, TEXT("Set up vehicle %s in %.3f ms%s"),
+						*GetPathName(), SetupSeconds * 1000.0, CanUseCompiledSimSetup() ? TEXT(" from its compiled sim setup") : TEXT("") );
+				}
 
 				if ( PVehicle != NULL )
 				{
@@ -283,7 +433,7 @@ void UWheeledVehicleMovementComponent::SetupVehicleShapes()
 				UVehicleWheel* Wheel = WheelSetup.WheelClass.GetDefaultObject();
 				check(Wheel);
 
-				const FVector WheelOffset = GetWheelRestingPosition(WheelSetup);
+				const FVector WheelOffset = bUseCompiledSimSetup ? CompiledSimSetup->WheelRestingPositions[WheelIdx] : GetWheelRestingPosition(WheelSetup);
 				const PxTransform PLocalPose = PxTransform(U2PVector(WheelOffset));
 				PxShape* PWheelShape = NULL;
 
@@ -434,11 +584,11 @@ void UWheeledVehicleMovementComponent::SetupWheelMassProperties_AssumesLocked(co
 		return;
 	}
 
-	// Prealloc data for the sprung masses
-	TArray<PxVec3> WheelOffsets;
+	// Prealloc data for the sprung masses, inline for up to 8 wheels
+	TArray<PxVec3, TInlineAllocator<8>> WheelOffsets;
 	WheelOffsets.Init(PxVec3(), NumWheels);
 
-	TArray<float> SprungMasses;
+	TArray<float, TInlineAllocator<8>> SprungMasses;
 	SprungMasses.Init(0.f, NumWheels);
 
 	// Calculate wheel offsets first, necessary for sprung masses
@@ -508,36 +658,53 @@ void UWheeledVehicleMovementComponent::SetupWheels(PxVehicleWheelsSimData* PWhee
 
 			const int32 NumWheels = FMath::Min(32, WheelSetups.Num());
 
-			for(int32 WheelIdx = 0; WheelIdx < NumWheels; ++WheelIdx)
+			if(CanUseCompiledSimSetup())
 			{
-				UVehicleWheel* Wheel = WheelSetups[WheelIdx].WheelClass.GetDefaultObject();
-
-				// init wheel data
-				PxVehicleWheelData PWheelData;
-				PWheelData.mRadius = Wheel->ShapeRadius;
-				PWheelData.mWidth = Wheel->ShapeWidth;
-				PWheelData.mMaxSteer = WheelSetups[WheelIdx].bDisableSteering ? 0.f : FMath::DegreesToRadians(Wheel->SteerAngle);
-				PWheelData.mMaxBrakeTorque = M2ToCm2(Wheel->MaxBrakeTorque);
-				PWheelData.mMaxHandBrakeTorque = Wheel->bAffectedByHandbrake ? M2ToCm2(Wheel->MaxHandBrakeTorque) : 0.0f;
-
-				PWheelData.mDampingRate = M2ToCm2(Wheel->DampingRate);
-				PWheelData.mMass = Wheel->Mass;
-				PWheelData.mMOI = 0.5f * PWheelData.mMass * FMath::Square(PWheelData.mRadius);
-
-				// init tire data
-				PxVehicleTireData PTireData;
-				PTireData.mType = Wheel->TireConfig ? Wheel->TireConfig->GetTireConfigID() : FPhysXVehicleManager::GetDefaultTireConfig()->GetTireConfigID();
-				//PTireData.mCamberStiffnessPerUnitGravity = 0.0f;
-				PTireData.mLatStiffX = Wheel->LatStiffMaxLoad;
-				PTireData.mLatStiffY = Wheel->LatStiffValue;
-				PTireData.mLongitudinalStiffnessPerUnitGravity = Wheel->LongStiffValue;
-
-				// finalize sim data
-				PWheelsSimData->setWheelData(WheelIdx, PWheelData);
-				PWheelsSimData->setTireData(WheelIdx, PTireData);
+				// Wheel, tire and suspension data as compiled, only the tire types are runtime IDs
+				CompiledSimSetup->ApplyWheelsSimData(*PWheelsSimData);
+
+				for(int32 WheelIdx = 0; WheelIdx < NumWheels; ++WheelIdx)
+				{
+					UVehicleWheel* Wheel = WheelSetups[WheelIdx].WheelClass.GetDefaultObject();
+
+					PxVehicleTireData PTireData = PWheelsSimData->getTireData(WheelIdx);
+					PTireData.mType = Wheel->TireConfig ? Wheel->TireConfig->GetTireConfigID() : FPhysXVehicleManager::GetDefaultTireConfig()->GetTireConfigID();
+					PWheelsSimData->setTireData(WheelIdx, PTireData);
+				}
 			}
+			else
+			{
+				for(int32 WheelIdx = 0; WheelIdx < NumWheels; ++WheelIdx)
+				{
+					UVehicleWheel* Wheel = WheelSetups[WheelIdx].WheelClass.GetDefaultObject();
+
+					// init wheel data
+					PxVehicleWheelData PWheelData;
+					PWheelData.mRadius = Wheel->ShapeRadius;
+					PWheelData.mWidth = Wheel->ShapeWidth;
+					PWheelData.mMaxSteer = WheelSetups[WheelIdx].bDisableSteering ? 0.f : FMath::DegreesToRadians(Wheel->SteerAngle);
+					PWheelData.mMaxBrakeTorque = M2ToCm2(Wheel->MaxBrakeTorque);
+					PWheelData.mMaxHandBrakeTorque = Wheel->bAffectedByHandbrake ? M2ToCm2(Wheel->MaxHandBrakeTorque) : 0.0f;
+
+					PWheelData.mDampingRate = M2ToCm2(Wheel->DampingRate);
+					PWheelData.mMass = Wheel->Mass;
+					PWheelData.mMOI = 0.5f * PWheelData.mMass * FMath::Square(PWheelData.mRadius);
+
+					// init tire data
+					PxVehicleTireData PTireData;
+					PTireData.mType = Wheel->TireConfig ? Wheel->TireConfig->GetTireConfigID() : FPhysXVehicleManager::GetDefaultTireConfig()->GetTireConfigID();
+					//PTireData.mCamberStiffnessPerUnitGravity = 0.0f;
+					PTireData.mLatStiffX = Wheel->LatStiffMaxLoad;
+					PTireData.mLatStiffY = Wheel->LatStiffValue;
+					PTireData.mLongitudinalStiffnessPerUnitGravity = Wheel->LongStiffValue;
+
+					// finalize sim data
+					PWheelsSimData->setWheelData(WheelIdx, PWheelData);
+					PWheelsSimData->setTireData(WheelIdx, PTireData);
+				}
 
-			SetupWheelMassProperties_AssumesLocked(NumWheels, PWheelsSimData, PVehicleActor);
+				SetupWheelMassProperties_AssumesLocked(NumWheels, PWheelsSimData, PVehicleActor);
+			}
 
 			const int32 NumShapes = PVehicleActor->getNbShapes();
 			const int32 NumChassisShapes = NumShapes - NumWheels;
@@ -553,7 +720,7 @@ void UWheeledVehicleMovementComponent::SetupWheels(PxVehicleWheelsSimData* PWhee
 					const int32 WheelShapeIndex = NumChassisShapes + WheelIdx;
 
 					PWheelsSimData->setWheelShapeMapping(WheelIdx, WheelShapeIndex);
-					PWheelsSimData->setSceneQueryFilterData(WheelIdx, Shapes[WheelShapeIndex]->getQueryFilterData());
+					PWheelsSimData->setSceneQueryFilterData(WheelIdx, FPhysXVehicleManager::PackSuspensionQueryFilterData(Shapes[WheelShapeIndex]->getQueryFilterData()));
 				}
 			}
 			else
@@ -673,15 +840,299 @@ void PxVehicleComputeTireForceDefault
 #endif // WITH_PHYSX
 
 
-void UWheeledVehicleMovementComponent::GenerateTireForces( UVehicleWheel* Wheel, const FTireShaderInput& Input, FTireShaderOutput& Output )
+ ////////////////////////////////////////////////////////////////////////////
+//Fast math version of the default tire force shader function.
+//Same model, with minimax polynomials (FMath::SinCos) in place of tan and cos,
+//reciprocal square roots in place of the square roots and divisions, and the
+//smoothing functions in Horner form. See p.Vehicle.BenchmarkTireModel for
+//its cost and error against the reference above.
+////////////////////////////////////////////////////////////////////////////
+
+#ifndef PHYSX_VEHICLE_FAST_TIRE_MATH
+#define PHYSX_VEHICLE_FAST_TIRE_MATH 1
+#endif
+
+#if PHYSICS_INTERFACE_PHYSX && PHYSX_VEHICLE_FAST_TIRE_MATH
+
+static TAutoConsoleVariable<int32> CVarVehicleFastTireMath(
+	TEXT("p.Vehicle.FastTireMath"),
+	0,
+	TEXT("Evaluate the default tire model with polynomial approximations of tan, cos and sqrt. Record a replay with 0 and play it back with 1 to check handling does not change."),
+	ECVF_Default);
+
+PX_FORCE_INLINE PxF32 smoothingFunction1Fast(const PxF32 K)
 {
-#if WITH_PHYSX_VEHICLES
-	const void* realShaderData = &PVehicle->mWheelsSimData.getTireData(Wheel->WheelIndex);
+	return PxMin(1.0f, K*(1.0f + K*(-ONE_THIRD + K*ONE_TWENTYSEVENTH)));
+}
+PX_FORCE_INLINE PxF32 smoothingFunction2Fast(const PxF32 K)
+{
+	return K*(1.0f + K*(-1.0f + K*(ONE_THIRD - K*ONE_TWENTYSEVENTH)));
+}
+
+void PxVehicleComputeTireForceFast
+(const void* tireShaderData, 
+ const PxF32 tireFriction,
+ const PxF32 longSlip, const PxF32 latSlip, const PxF32 camber,
+ const PxF32 wheelOmega, const PxF32 wheelRadius, const PxF32 recipWheelRadius,
+ const PxF32 restTireLoad, const PxF32 normalisedTireLoad, const PxF32 tireLoad,
+ const PxF32 gravity, const PxF32 recipGravity,
+ PxF32& wheelTorque, PxF32& tireLongForceMag, PxF32& tireLatForceMag, PxF32& tireAlignMoment)
+{
+	PX_UNUSED(wheelOmega);
+	PX_UNUSED(recipWheelRadius);
+
+	const PxVehicleTireData& tireData=*((PxVehicleTireData*)tireShaderData);
+
+	PX_ASSERT(tireFriction>0);
+	PX_ASSERT(tireLoad>0);
+
+	wheelTorque=0.0f;
+	tireLongForceMag=0.0f;
+	tireLatForceMag=0.0f;
+	tireAlignMoment=0.0f;
+
+	//If long slip/lat slip/camber are all zero than there will be zero tire force.
+	if (FMath::IsNearlyZero(latSlip) && FMath::IsNearlyZero(longSlip) && FMath::IsNearlyZero(camber))
+	{
+		return;
+	}
+
+	const PxF32 maxForce=tireFriction*tireLoad;
+	const PxF32 recipMaxForce=1.0f/maxForce;
+
+	const PxF32 latStiff=restTireLoad*tireData.mLatStiffY*smoothingFunction1Fast(normalisedTireLoad*3.0f/tireData.mLatStiffX);
+	const PxF32 longStiff=tireData.mLongitudinalStiffnessPerUnitGravity*gravity;
+	const PxF32 recipLongStiff=tireData.getRecipLongitudinalStiffnessPerUnitGravity()*recipGravity;
+	const PxF32 camberStiff=tireData.mCamberStiffnessPerUnitGravity*gravity;
+
+	//Slip angles stay within (-pi/2, pi/2), where the polynomial sine and cosine hold their accuracy.
+	float sinSlip, cosSlip;
+	FMath::SinCos(&sinSlip, &cosSlip, latSlip - camber*camberStiff/latStiff);
+	const PxF32 TEff = sinSlip/cosSlip;
+
+	const PxF32 latTerm=latStiff*TEff;
+	const PxF32 longTerm=longStiff*longSlip;
+	const PxF32 KSquared=latTerm*latTerm + longTerm*longTerm;
+	const PxF32 K = KSquared > 0.0f ? KSquared*FMath::InvSqrt(KSquared)*recipMaxForce : 0.0f;
+	const PxF32 FBar = smoothingFunction1Fast(K);
+	const PxF32 MBar = smoothingFunction2Fast(K);
+	PxF32 nu=1;
+	if(K <= 2.0f*PxPi)
+	{
+		//K/2 stays within [0, pi].
+		float sinHalfK, cosHalfK;
+		FMath::SinCos(&sinHalfK, &cosHalfK, K*0.5f);
+		const PxF32 latOverlLong=latStiff*recipLongStiff;
+		nu = 0.5f*(1.0f + latOverlLong - (1.0f - latOverlLong)*cosHalfK);
+	}
+	const PxF32 nuTEff=nu*TEff;
+	const PxF32 FZero = maxForce*FMath::InvSqrt(longSlip*longSlip + nuTEff*nuTEff);
+	const PxF32 fz = longSlip*FBar*FZero;
+	const PxF32 fx = -nuTEff*FBar*FZero;
+	const PxF32 pneumaticTrail=1.0f;
+	const PxF32	fMy= nuTEff * pneumaticTrail * MBar * FZero;
+
+	wheelTorque=-fz*wheelRadius;
+	tireLongForceMag=fz;
+	tireLatForceMag=fx;
+	tireAlignMoment=fMy;
+}
+
+#endif // PHYSICS_INTERFACE_PHYSX && PHYSX_VEHICLE_FAST_TIRE_MATH
+
+#if PHYSICS_INTERFACE_PHYSX
+
+static void BenchmarkTireModel(int32 Iterations)
+{
+	// PhysX default tire (its reciprocals are only kept up to date by PxVehicleWheelsSimData::setTireData otherwise), loaded like a
+	// wheel of a 1500 kg, four wheeled vehicle
+	const PxVehicleTireData TireData;
+	const float Gravity = 980.f;
+	const float RestTireLoad = 1500.f * Gravity * 0.25f;
+	const float WheelRadius = GetDefault<UVehicleWheel>()->ShapeRadius;
+
+	// Sweep the ranges the shader sees: long slip in [-1, 1], lat slip within (-pi/2, pi/2) and loads up to three times rest
+	const int32 NumLongSlips = 41;
+	const int32 NumLatSlips = 41;
+	const int32 NumLoads = 6;
+
+	struct FTireSample
+	{
+		float LongSlip;
+		float LatSlip;
+		float NormalizedLoad;
+	};
+
+	TArray<FTireSample> Samples;
+	Samples.Reserve(NumLongSlips * NumLatSlips * NumLoads);
+	for (int32 LongIdx = 0; LongIdx < NumLongSlips; ++LongIdx)
+	{
+		for (int32 LatIdx = 0; LatIdx < NumLatSlips; ++LatIdx)
+		{
+			for (int32 LoadIdx = 0; LoadIdx < NumLoads; ++LoadIdx)
+			{
+				FTireSample& Sample = Samples.AddDefaulted_GetRef();
+				Sample.LongSlip = FMath::Lerp(-1.f, 1.f, (float)LongIdx / (NumLongSlips - 1));
+				Sample.LatSlip = FMath::Lerp(-1.5f, 1.5f, (float)LatIdx / (NumLatSlips - 1));
+				Sample.NormalizedLoad = FMath::Lerp(0.25f, 3.f, (float)LoadIdx / (NumLoads - 1));
+			}
+		}
+	}
+
+#if PHYSX_VEHICLE_FAST_TIRE_MATH
+	// Errors are relative to the force the friction allows, the largest any output can reach
+	float MaxLongError = 0.f;
+	float MaxLatError = 0.f;
+	float MaxAlignError = 0.f;
+	for (const FTireSample& Sample : Samples)
+	{
+		const float TireLoad = RestTireLoad * Sample.NormalizedLoad;
+
+		float RefTorque, RefLong, RefLat, RefAlign;
+		PxVehicleComputeTireForceDefault(&TireData, 1.f, Sample.LongSlip, Sample.LatSlip, 0.f, 0.f, WheelRadius, 1.f / WheelRadius,
+			RestTireLoad, Sample.NormalizedLoad, TireLoad, Gravity, 1.f / Gravity, RefTorque, RefLong, RefLat, RefAlign);
+
+		float FastTorque, FastLong, FastLat, FastAlign;
+		PxVehicleComputeTireForceFast(&TireData, 1.f, Sample.LongSlip, Sample.LatSlip, 0.f, 0.f, WheelRadius, 1.f / WheelRadius,
+			RestTireLoad, Sample.NormalizedLoad, TireLoad, Gravity, 1.f / Gravity, FastTorque, FastLong, FastLat, FastAlign);
+
+		MaxLongError = FMath::Max(MaxLongError, FMath::Abs(FastLong - RefLong) / TireLoad);
+		MaxLatError = FMath::Max(MaxLatError, FMath::Abs(FastLat - RefLat) / TireLoad);
+		MaxAlignError = FMath::Max(MaxAlignError, FMath::Abs(FastAlign - RefAlign) / TireLoad);
+	}
+#endif // PHYSX_VEHICLE_FAST_TIRE_MATH
+
+	auto TimeTireModel = [&](auto ComputeTireForce)
+	{
+		float Sink = 0.f;
+		const double StartTime = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+		{
+			for (const FTireSample& Sample : Samples)
+			{
+				float Torque, LongForce, LatForce, AlignMoment;
+				ComputeTireForce(&TireData, 1.f, Sample.LongSlip, Sample.LatSlip, 0.f, 0.f, WheelRadius, 1.f / WheelRadius,
+					RestTireLoad, Sample.NormalizedLoad, RestTireLoad * Sample.NormalizedLoad, Gravity, 1.f / Gravity, Torque, LongForce, LatForce, AlignMoment);
+				Sink += Torque + LongForce + LatForce + AlignMoment;
+			}
+		}
+		const double Seconds = FPlatformTime::Seconds() - StartTime;
+
+		// Keep the results alive so the calls are not optimized away
+		static volatile float GTireModelBenchmarkSink;
+		GTireModelBenchmarkSink = Sink;
 
+		return Seconds * 1.e9 / ((double)Iterations * Samples.Num());
+	};
+
+	const double ReferenceNs = TimeTireModel(&PxVehicleComputeTireForceDefault);
+
+	// The Pacejka model takes the same samples as one batch in structure of arrays form
+	TArray<float> TireFriction, LongSlip, LatSlip, TireLoad, WheelRadii, WheelTorque, LongForce, LatForce;
+	TireFriction.Init(1.f, Samples.Num());
+	WheelRadii.Init(WheelRadius, Samples.Num());
+	WheelTorque.SetNumZeroed(Samples.Num());
+	LongForce.SetNumZeroed(Samples.Num());
+	LatForce.SetNumZeroed(Samples.Num());
+	LongSlip.Reserve(Samples.Num());
+	LatSlip.Reserve(Samples.Num());
+	TireLoad.Reserve(Samples.Num());
+	for (const FTireSample& Sample : Samples)
+	{
+		LongSlip.Add(Sample.LongSlip);
+		LatSlip.Add(Sample.LatSlip);
+		TireLoad.Add(RestTireLoad * Sample.NormalizedLoad);
+	}
+
+	FTireModelBatch Batch;
+	Batch.Num = Samples.Num();
+	Batch.TireFriction = TireFriction.GetData();
+	Batch.LongSlip = LongSlip.GetData();
+	Batch.LatSlip = LatSlip.GetData();
+	Batch.TireLoad = TireLoad.GetData();
+	Batch.WheelRadius = WheelRadii.GetData();
+	Batch.WheelTorque = WheelTorque.GetData();
+	Batch.LongForce = LongForce.GetData();
+	Batch.LatForce = LatForce.GetData();
+
+	const FPacejkaTireModel& PacejkaTireModel = FPacejkaTireModel::GetDefault();
+	const double PacejkaStartTime = FPlatformTime::Seconds();
+	for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+	{
+		PacejkaTireModel.EvaluateBatch(Batch);
+	}
+	const double PacejkaNs = (FPlatformTime::Seconds() - PacejkaStartTime) * 1.e9 / ((double)Iterations * Samples.Num());
+
+	// The tire shader hands the model one tire at a time, through ITireModel::Evaluate as a batch of one
+	TArray<FTireShaderInput> Inputs;
+	Inputs.SetNumZeroed(Samples.Num());
+	for (int32 SampleIdx = 0; SampleIdx < Samples.Num(); ++SampleIdx)
+	{
+		FTireShaderInput& Input = Inputs[SampleIdx];
+		Input.TireFriction = 1.f;
+		Input.LongSlip = Samples[SampleIdx].LongSlip;
+		Input.LatSlip = Samples[SampleIdx].LatSlip;
+		Input.WheelRadius = WheelRadius;
+		Input.RecipWheelRadius = 1.f / WheelRadius;
+		Input.RestTireLoad = RestTireLoad;
+		Input.TireLoad = RestTireLoad * Samples[SampleIdx].NormalizedLoad;
+		Input.NormalizedTireLoad = Samples[SampleIdx].NormalizedLoad;
+		Input.Gravity = Gravity;
+		Input.RecipGravity = 1.f / Gravity;
+	}
+
+	const ITireModel& TireModel = PacejkaTireModel;
+	float EvaluateSink = 0.f;
+	const double EvaluateStartTime = FPlatformTime::Seconds();
+	for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+	{
+		for (const FTireShaderInput& Input : Inputs)
+		{
+			FTireShaderOutput Output(0.f);
+			TireModel.Evaluate(Input, Output);
+			EvaluateSink += Output.WheelTorque + Output.LongForce + Output.LatForce;
+		}
+	}
+	const double EvaluateNs = (FPlatformTime::Seconds() - EvaluateStartTime) * 1.e9 / ((double)Iterations * Samples.Num());
+
+	static volatile float GTireModelEvaluateSink;
+	GTireModelEvaluateSink = EvaluateSink;
+
+	UE_LOG(LogVehicles, Display, TEXT("Tire model benchmark, %d samples x %d iterations: reference %.1f ns/call, batched Pacejka %.1f ns/tire (%.2fx), Pacejka per tire %.1f ns/call (%.2fx)"),
+		Samples.Num(), Iterations, ReferenceNs, PacejkaNs, PacejkaNs > 0.0 ? ReferenceNs / PacejkaNs : 0.0,
+		EvaluateNs, EvaluateNs > 0.0 ? ReferenceNs / EvaluateNs : 0.0);
+
+#if PHYSX_VEHICLE_FAST_TIRE_MATH
+	const double FastNs = TimeTireModel(&PxVehicleComputeTireForceFast);
+
+	UE_LOG(LogVehicles, Display, TEXT("Tire model benchmark, %d samples x %d iterations: reference %.1f ns/call, fast math %.1f ns/call (%.2fx)"),
+		Samples.Num(), Iterations, ReferenceNs, FastNs, FastNs > 0.0 ? ReferenceNs / FastNs : 0.0);
+	UE_LOG(LogVehicles, Display, TEXT("Tire model fast math max error, fraction of tire load: long force %g, lat force %g, align moment %g"),
+		MaxLongError, MaxLatError, MaxAlignError);
+#endif // PHYSX_VEHICLE_FAST_TIRE_MATH
+}
+
+static FAutoConsoleCommand GVehicleBenchmarkTireModelCommand(
+	TEXT("p.Vehicle.BenchmarkTireModel"),
+	TEXT("Time the reference and fast math default tire models and the Pacejka model, batched and per tire, over the slip and load ranges, and log the largest fast math force error. Usage: p.Vehicle.BenchmarkTireModel [Iterations]"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		BenchmarkTireModel(Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 100);
+	})
+);
+
+static void ComputeDefaultTireForces(const void* TireData, const FTireShaderInput& Input, FTireShaderOutput& Output)
+{
 	float Dummy;
 
-	PxVehicleComputeTireForceDefault(
-		realShaderData, Input.TireFriction,
+#if PHYSX_VEHICLE_FAST_TIRE_MATH
+	const auto ComputeTireForce = CVarVehicleFastTireMath.GetValueOnAnyThread() != 0 ? &PxVehicleComputeTireForceFast : &PxVehicleComputeTireForceDefault;
+#else
+	const auto ComputeTireForce = &PxVehicleComputeTireForceDefault;
+#endif
+
+	ComputeTireForce(
+		TireData, Input.TireFriction,
 		Input.LongSlip, Input.LatSlip,
 		0.0f, Input.WheelOmega, Input.WheelRadius, Input.RecipWheelRadius,
 		Input.RestTireLoad, Input.NormalizedTireLoad, Input.TireLoad,
@@ -696,6 +1147,15 @@ void UWheeledVehicleMovementComponent::GenerateTireForces( UVehicleWheel* Wheel,
 	//UE_LOG( LogVehicles, Warning, TEXT("Friction = %f	LongSlip = %f	LatSlip = %f"), Input.TireFriction, Input.LongSlip, Input.LatSlip );	
 	//UE_LOG( LogVehicles, Warning, TEXT("WheelTorque= %f	LongForce = %f	LatForce = %f"), Output.WheelTorque, Output.LongForce, Output.LatForce );
 	//UE_LOG( LogVehicles, Warning, TEXT("RestLoad= %f	NormLoad = %f	TireLoad = %f"),Input.RestTireLoad, Input.NormalizedTireLoad, Input.TireLoad );
+}
+
+#endif // PHYSICS_INTERFACE_PHYSX
+
+
+void UWheeledVehicleMovementComponent::GenerateTireForces( UVehicleWheel* Wheel, const FTireShaderInput& Input, FTireShaderOutput& Output )
+{
+#if WITH_PHYSX_VEHICLES
+	ComputeDefaultTireForces( &PVehicle->mWheelsSimData.getTireData(Wheel->WheelIndex), Input, Output );
 #endif // WITH_PHYSX_VEHICLES
 }
 
@@ -734,6 +1194,35 @@ FVector UWheeledVehicleMovementComponent::GetWheelRestingPosition( const FWheelS
 	return Offset;
 }
 
+uint32 UWheeledVehicleMovementComponent::GetSimSetupSourceHash() const
+{
+	uint32 Hash = GetTypeHash(Mass);
+	for (const FWheelSetup& WheelSetup : WheelSetups)
+	{
+		Hash = UVehicleSimSetup::HashProperties(FWheelSetup::StaticStruct(), &WheelSetup, Hash);
+		if (WheelSetup.WheelClass)
+		{
+			Hash = UVehicleSimSetup::HashProperties(WheelSetup.WheelClass, WheelSetup.WheelClass->GetDefaultObject(), Hash);
+		}
+	}
+
+	if (UpdatedPrimitive)
+	{
+		if (const FBodyInstance* BodyInst = UpdatedPrimitive->GetBodyInstance())
+		{
+			Hash = HashCombine(Hash, GetTypeHash(BodyInst->COMNudge));
+		}
+	}
+
+	if (const USkinnedMeshComponent* Mesh = Cast<USkinnedMeshComponent>(UpdatedPrimitive))
+	{
+		Hash = HashCombine(Hash, GetTypeHash(GetPathNameSafe(Mesh->SkeletalMesh)));
+		Hash = HashCombine(Hash, GetTypeHash(GetPathNameSafe(Mesh->GetPhysicsAsset())));
+	}
+
+	return Hash;
+}
+
 FVector UWheeledVehicleMovementComponent::GetLocalCOM() const
 {
 	FVector LocalCOM = FVector::ZeroVector;
@@ -813,31 +1302,47 @@ void UWheeledVehicleMovementComponent::OnCreatePhysicsState()
 	{
 		FPhysScene* PhysScene = World->GetPhysicsScene();
 
-		if ( PhysScene && FPhysXVehicleManager::GetVehicleManagerFromScene(PhysScene) )
+		FPhysXVehicleManager* VehicleManager = PhysScene ? FPhysXVehicleManager::GetVehicleManagerFromScene(PhysScene) : nullptr;
+		if ( VehicleManager )
 		{
+			// The wheel bodies stop colliding and simulating right away, even when the vehicle itself waits in the queue
 			FixupSkeletalMesh();
-			CreateVehicle();
 
-			if ( PVehicle )
+			if ( VehicleManager->QueueVehicleCreation( this ) )
 			{
-				FPhysXVehicleManager* VehicleManager = FPhysXVehicleManager::GetVehicleManagerFromScene(PhysScene);
-				VehicleManager->AddVehicle( this );
+				HoldBodyForCreation( true );
+			}
+			else
+			{
+				FinishCreatePhysicsState();
+			}
+		}
+	}
+}
 
-				CreateWheels();
+void UWheeledVehicleMovementComponent::FinishCreatePhysicsState()
+{
+	HoldBodyForCreation( false );
+	CreateVehicle();
 
-				//LogVehicleSettings( PVehicle );
-				SCOPED_SCENE_WRITE_LOCK(VehicleManager->GetScene());
-				PVehicle->getRigidDynamicActor()->wakeUp();
+	if ( PVehicle )
+	{
+		FPhysXVehicleManager* VehicleManager = FPhysXVehicleManager::GetVehicleManagerFromScene(GetWorld()->GetPhysicsScene());
+		VehicleManager->AddVehicle( this );
 
-				// Need to bind to the notify delegate on the mesh incase physics state is changed
-				if(USkeletalMeshComponent* MeshComp = Cast<USkeletalMeshComponent>(GetMesh()))
-				{
-					MeshOnPhysicsStateChangeHandle = MeshComp->RegisterOnPhysicsCreatedDelegate(FOnSkelMeshPhysicsCreated::CreateUObject(this, &UWheeledVehicleMovementComponent::RecreatePhysicsState));
-					if(UVehicleAnimInstance* VehicleAnimInstance = Cast<UVehicleAnimInstance>(MeshComp->GetAnimInstance()))
-					{
-						VehicleAnimInstance->SetWheeledVehicleMovementComponent(this);
-					}
-				}
+		CreateWheels();
+
+		//LogVehicleSettings( PVehicle );
+		SCOPED_SCENE_WRITE_LOCK(VehicleManager->GetScene());
+		PVehicle->getRigidDynamicActor()->wakeUp();
+
+		// Need to bind to the notify delegate on the mesh incase physics state is changed
+		if(USkeletalMeshComponent* MeshComp = Cast<USkeletalMeshComponent>(GetMesh()))
+		{
+			MeshOnPhysicsStateChangeHandle = MeshComp->RegisterOnPhysicsCreatedDelegate(FOnSkelMeshPhysicsCreated::CreateUObject(this, &UWheeledVehicleMovementComponent::RecreatePhysicsState));
+			if(UVehicleAnimInstance* VehicleAnimInstance = Cast<UVehicleAnimInstance>(MeshComp->GetAnimInstance()))
+			{
+				VehicleAnimInstance->SetWheeledVehicleMovementComponent(this);
 			}
 		}
 	}
@@ -849,6 +1354,7 @@ void UWheeledVehicleMovementComponent::OnDestroyPhysicsState()
 
 	if ( PVehicle )
 	{
+		SetUseInstancedWheels( false );
 		DestroyWheels();
 
 		FPhysXVehicleManager* VehicleManager = FPhysXVehicleManager::GetVehicleManagerFromScene(GetWorld()->GetPhysicsScene());
@@ -869,6 +1375,40 @@ void UWheeledVehicleMovementComponent::OnDestroyPhysicsState()
 			UpdatedComponent->RecreatePhysicsState();
 		}
 	}
+	else if ( UWorld* World = GetWorld() )
+	{
+		// Still waiting in the vehicle manager's creation queue
+		if ( FPhysScene* PhysScene = World->GetPhysicsScene() )
+		{
+			if ( FPhysXVehicleManager* VehicleManager = FPhysXVehicleManager::GetVehicleManagerFromScene(PhysScene) )
+			{
+				VehicleManager->CancelVehicleCreation( this );
+			}
+		}
+
+		HoldBodyForCreation( false );
+	}
+}
+
+void UWheeledVehicleMovementComponent::HoldBodyForCreation(bool bHold)
+{
+	FBodyInstance* BodyInstance = UpdatedPrimitive ? UpdatedPrimitive->GetBodyInstance() : nullptr;
+	if ( bHold )
+	{
+		if ( BodyInstance && BodyInstance->IsInstanceSimulatingPhysics() )
+		{
+			BodyInstance->SetInstanceSimulatePhysics( false );
+			bBodyHeldForCreation = true;
+		}
+	}
+	else if ( bBodyHeldForCreation )
+	{
+		bBodyHeldForCreation = false;
+		if ( BodyInstance )
+		{
+			BodyInstance->SetInstanceSimulatePhysics( true );
+		}
+	}
 }
 
 bool UWheeledVehicleMovementComponent::ShouldCreatePhysicsState() const
@@ -920,10 +1460,13 @@ void UWheeledVehicleMovementComponent::CreateWheels()
 	// Initialize the wheels
 	for ( int32 WheelIdx = 0; WheelIdx < Wheels.Num(); ++WheelIdx )
 	{
-		PVehicle->mWheelsDynData.setTireForceShaderData( WheelIdx, Wheels[WheelIdx] );
-
 		Wheels[WheelIdx]->Init( this, WheelIdx );
 	}
+
+	// The tire shader reads the manager's copy of what it needs from the wheels
+	FPhysXVehicleManager* VehicleManager = FPhysXVehicleManager::GetVehicleManagerFromScene( GetWorld()->GetPhysicsScene() );
+	check(VehicleManager);
+	VehicleManager->BindTireShaderData( this );
 }
 
 void UWheeledVehicleMovementComponent::DestroyWheels()
@@ -938,6 +1481,9 @@ void UWheeledVehicleMovementComponent::DestroyWheels()
 
 void UWheeledVehicleMovementComponent::TickVehicle( float DeltaTime )
 {
+	PHYSX_VEHICLE_SCOPE_CYCLE_COUNTER(STAT_PhysXVehicle_TickVehicle);
+	PHYSX_VEHICLE_TRACE_SCOPE(PhysXVehicle_TickVehicle);
+
 	if (AvoidanceLockTimer > 0.0f)
 	{
 		AvoidanceLockTimer -= DeltaTime;
@@ -964,6 +1510,9 @@ void UWheeledVehicleMovementComponent::TickVehicle( float DeltaTime )
 
 void UWheeledVehicleMovementComponent::UpdateDrag(float DeltaTime)
 {
+	PHYSX_VEHICLE_SCOPE_CYCLE_COUNTER(STAT_PhysXVehicle_UpdateDrag);
+	PHYSX_VEHICLE_TRACE_SCOPE(PhysXVehicle_UpdateDrag);
+
 	if (PVehicle && UpdatedPrimitive)
 	{
 		float ForwardSpeed = GetForwardSpeed();
@@ -984,8 +1533,53 @@ void UWheeledVehicleMovementComponent::UpdateDrag(float DeltaTime)
 	}
 }
 
+void UWheeledVehicleMovementComponent::TickVehicle_AssumesLocked( float DeltaTime, const PxTransform& ChassisPose )
+{
+	PHYSX_VEHICLE_SCOPE_CYCLE_COUNTER(STAT_PhysXVehicle_TickVehicle);
+	PHYSX_VEHICLE_TRACE_SCOPE(PhysXVehicle_TickVehicle);
+
+	if (AvoidanceLockTimer > 0.0f)
+	{
+		AvoidanceLockTimer -= DeltaTime;
+	}
+
+	if (PVehicle == nullptr || UpdatedComponent == nullptr)
+	{
+		return;
+	}
+
+	if (Cast<APawn>(UpdatedComponent->GetOwner()))
+	{
+		UpdateSimulation_AssumesLocked(DeltaTime);
+	}
+
+	PHYSX_VEHICLE_SCOPE_CYCLE_COUNTER(STAT_PhysXVehicle_UpdateDrag);
+
+	// PxVehicleSetBasisVectors made X the forward axis
+	PxRigidDynamic* PActor = PVehicle->getRigidDynamicActor();
+	const PxVec3 PForward = ChassisPose.q.getBasisVector0();
+
+	const float ForwardSpeed = PActor->getLinearVelocity().dot(PForward);
+	if (FMath::Abs(ForwardSpeed) > 1.f)
+	{
+		// Signed like UpdateDrag, so drag always opposes the direction of travel
+		const float SpeedSquared = ForwardSpeed * FMath::Abs(ForwardSpeed);
+		const float ChassisDragArea = ChassisHeight * ChassisWidth;
+		const float AirDensity = 1.25 / (100 * 100 * 100); //kg/cm^3
+		const float DragMag = 0.5f * AirDensity * SpeedSquared * DragCoefficient * ChassisDragArea;
+		DebugDragMagnitude = DragMag;
+
+		if (!(PActor->getRigidBodyFlags() & PxRigidBodyFlag::eKINEMATIC))
+		{
+			PActor->addForce(-PForward * DragMag, PxForceMode::eFORCE);
+		}
+	}
+}
+
 void UWheeledVehicleMovementComponent::PreTick(float DeltaTime)
 {
+	PHYSX_VEHICLE_TRACE_SCOPE(PhysXVehicle_PreTickVehicle);
+
 	// movement updates and replication
 	if (PVehicle && UpdatedComponent)
 	{
@@ -1009,6 +1603,9 @@ void UWheeledVehicleMovementComponent::SetupVehicle()
 		return;
 	}
 
+	// Hashing the sources exports every wheel class default, do it once for the shape, wheel and drive setup below
+	bUseCompiledSimSetup = CompiledSimSetup && CompiledSimSetup->IsCompatible(WheelSetups.Num(), Mass, GetSimSetupSourceHash());
+
 	if (WheelSetups.Num() == 0)
 	{
 		PVehicle = nullptr;
@@ -1043,6 +1640,16 @@ void UWheeledVehicleMovementComponent::SetupVehicleDrive(PxVehicleWheelsSimData*
 }
 
 void UWheeledVehicleMovementComponent::UpdateSimulation( float DeltaTime )
+{
+	FBodyInstance* Instance = UpdatedPrimitive->GetBodyInstance();
+
+	FPhysicsCommand::ExecuteWrite(Instance->GetActorReferenceWithWelding(), [&](const FPhysicsActorHandle& Actor)
+	{
+		UpdateSimulation_AssumesLocked(DeltaTime);
+	});
+}
+
+void UWheeledVehicleMovementComponent::UpdateSimulation_AssumesLocked( float DeltaTime )
 {
 }
 
@@ -1080,6 +1687,16 @@ void UWheeledVehicleMovementComponent::SetAvoidanceVelocityLock(class UAvoidance
 }
 
 void UWheeledVehicleMovementComponent::UpdateState( float DeltaTime )
+{
+	FVehicleInputPacket Packet;
+	if (GatherInputPacket(DeltaTime, Packet))
+	{
+		Packet.InterpInputs(DeltaTime);
+		ApplyInputPacket(Packet);
+	}
+}
+
+bool UWheeledVehicleMovementComponent::GatherInputPacket(float DeltaTime, FVehicleInputPacket& OutPacket)
 {
 	// update input values
 	AController* Controller = GetController();
@@ -1088,10 +1705,12 @@ void UWheeledVehicleMovementComponent::UpdateState( float DeltaTime )
 	// Should we remove input instead of relying on replicated state in that case?
 	if (Controller && Controller->IsLocalController())
 	{
+		const float ForwardSpeed = GetForwardSpeed();
+
 		if(bReverseAsBrake)
 		{
 			//for reverse as state we want to automatically shift between reverse and first gear
-			if (FMath::Abs(GetForwardSpeed()) < WrongDirectionThreshold)	//we only shift between reverse and first if the car is slow enough. This isn't 100% correct since we really only care about engine speed, but good enough
+			if (FMath::Abs(ForwardSpeed) < WrongDirectionThreshold)	//we only shift between reverse and first if the car is slow enough. This isn't 100% correct since we really only care about engine speed, but good enough
 			{
 				if (RawThrottleInput < -KINDA_SMALL_NUMBER && GetCurrentGear() >= 0 && GetTargetGear() >= 0)
 				{
@@ -1107,22 +1726,17 @@ void UWheeledVehicleMovementComponent::UpdateState( float DeltaTime )
 		
 		if (bUseRVOAvoidance)
 		{
+			PHYSX_VEHICLE_SCOPE_CYCLE_COUNTER(STAT_PhysXVehicle_Avoidance);
+			PHYSX_VEHICLE_TRACE_SCOPE(PhysXVehicle_Avoidance);
 			CalculateAvoidanceVelocity(DeltaTime);
 			UpdateAvoidance(DeltaTime);
-		}
 
-		SteeringInput = SteeringInputRate.InterpInputValue(DeltaTime, SteeringInput, CalcSteeringInput());
-		ThrottleInput = ThrottleInputRate.InterpInputValue( DeltaTime, ThrottleInput, CalcThrottleInput() );
-		BrakeInput = BrakeInputRate.InterpInputValue(DeltaTime, BrakeInput, CalcBrakeInput());
-		HandbrakeInput = HandbrakeInputRate.InterpInputValue(DeltaTime, HandbrakeInput, CalcHandbrakeInput());
-
-		// and send to server
-		ServerUpdateState(SteeringInput, ThrottleInput, BrakeInput, HandbrakeInput, GetCurrentGear());
-
-		if (PawnOwner && PawnOwner->IsNetMode(NM_Client))
-		{
-			MarkForClientCameraUpdate();
+			ApplyAvoidanceToRawSteering();
+			ApplyAvoidanceToRawThrottle();
 		}
+
+		PackInput(ForwardSpeed, OutPacket);
+		return true;
 	}
 	else
 	{
@@ -1132,9 +1746,117 @@ void UWheeledVehicleMovementComponent::UpdateState( float DeltaTime )
 		BrakeInput = ReplicatedState.BrakeInput;
 		HandbrakeInput = ReplicatedState.HandbrakeInput;
 		SetTargetGear(ReplicatedState.CurrentGear, true);
+		return false;
+	}
+}
+
+void UWheeledVehicleMovementComponent::ApplyInputPacket(const FVehicleInputPacket& Packet)
+{
+	SteeringInput = Packet.SteeringInput;
+	ThrottleInput = Packet.ThrottleInput;
+	BrakeInput = Packet.BrakeInput;
+	HandbrakeInput = Packet.HandbrakeInput;
+
+	// and send to server
+	ServerUpdateState(SteeringInput, ThrottleInput, BrakeInput, HandbrakeInput, GetCurrentGear());
+
+	if (PawnOwner && PawnOwner->IsNetMode(NM_Client))
+	{
+		MarkForClientCameraUpdate();
+	}
+}
+
+void UWheeledVehicleMovementComponent::PackInput(float ForwardSpeed, FVehicleInputPacket& OutPacket) const
+{
+	OutPacket.RawSteeringInput = RawSteeringInput;
+	OutPacket.RawThrottleInput = RawThrottleInput;
+	OutPacket.RawBrakeInput = RawBrakeInput;
+	OutPacket.bRawHandbrakeInput = bRawHandbrakeInput;
+	OutPacket.bReverseAsBrake = bReverseAsBrake;
+	OutPacket.ForwardSpeed = ForwardSpeed;
+	OutPacket.TargetGear = GetTargetGear();
+	OutPacket.IdleBrakeInput = IdleBrakeInput;
+	OutPacket.StopThreshold = StopThreshold;
+	OutPacket.WrongDirectionThreshold = WrongDirectionThreshold;
+	OutPacket.SteeringInputRate = SteeringInputRate;
+	OutPacket.ThrottleInputRate = ThrottleInputRate;
+	OutPacket.BrakeInputRate = BrakeInputRate;
+	OutPacket.HandbrakeInputRate = HandbrakeInputRate;
+	OutPacket.SteeringInput = SteeringInput;
+	OutPacket.ThrottleInput = ThrottleInput;
+	OutPacket.BrakeInput = BrakeInput;
+	OutPacket.HandbrakeInput = HandbrakeInput;
+}
+
+float FVehicleInputPacket::CalcThrottleInput() const
+{
+	if(bReverseAsBrake)
+	{
+		//If the user is changing direction we should really be braking first and not applying any gas, so wait until they've changed gears
+		if ((RawThrottleInput > 0.f && TargetGear < 0) || (RawThrottleInput < 0.f && TargetGear > 0))
+		{
+			return 0.f;
+		}
+	}
+
+	return FMath::Abs(RawThrottleInput);
+}
+
+float FVehicleInputPacket::CalcBrakeInput() const
+{
+	if(bReverseAsBrake)
+	{
+		float NewBrakeInput = 0.0f;
+
+		// if player wants to move forwards...
+		if (RawThrottleInput > 0.f)
+		{
+			// if vehicle is moving backwards, then press brake
+			if (ForwardSpeed < -WrongDirectionThreshold)
+			{
+				NewBrakeInput = 1.0f;
+			}
+		}
+
+		// if player wants to move backwards...
+		else if (RawThrottleInput < 0.f)
+		{
+			// if vehicle is moving forwards, then press brake
+			if (ForwardSpeed > WrongDirectionThreshold)
+			{
+				NewBrakeInput = 1.0f;			// Seems a bit severe to have 0 or 1 braking. Better control can be had by allowing continuous brake input values
+			}
+		}
+
+		// if player isn't pressing forward or backwards...
+		else
+		{
+			if (ForwardSpeed < StopThreshold && ForwardSpeed > -StopThreshold)	//auto break 
+			{
+				NewBrakeInput = 1.f;
+			}
+			else
+			{
+				NewBrakeInput = IdleBrakeInput;
+			}
+		}
+
+		return FMath::Clamp<float>(NewBrakeInput, 0.0, 1.0);
+	}
+	else
+	{
+		return FMath::Abs(RawBrakeInput);
 	}
 }
 
+void FVehicleInputPacket::InterpInputs(float DeltaTime)
+{
+	SteeringInput = SteeringInputRate.InterpInputValue(DeltaTime, SteeringInput, RawSteeringInput);
+	ThrottleInput = ThrottleInputRate.InterpInputValue(DeltaTime, ThrottleInput, CalcThrottleInput());
+	BrakeInput = BrakeInputRate.InterpInputValue(DeltaTime, BrakeInput, CalcBrakeInput());
+	HandbrakeInput = HandbrakeInputRate.InterpInputValue(DeltaTime, HandbrakeInput, bRawHandbrakeInput ? 1.0f : 0.0f);
+}
+
 /// @cond DOXYGEN_WARNINGS
 
 bool UWheeledVehicleMovementComponent::ServerUpdateState_Validate(float InSteeringInput, float InThrottleInput, float InBrakeInput, float InHandbrakeInput, int32 InCurrentGear)
@@ -1164,73 +1886,49 @@ void UWheeledVehicleMovementComponent::ServerUpdateState_Implementation(float In
 
 /// @endcond
 
-float UWheeledVehicleMovementComponent::CalcSteeringInput()
+void UWheeledVehicleMovementComponent::ApplyAvoidanceToRawSteering()
 {
-	if (bUseRVOAvoidance)
+	const float AngleDiff = AvoidanceVelocity.HeadingAngle() - GetVelocityForRVOConsideration().HeadingAngle();
+	if (AngleDiff > 0.0f)
 	{
-		const float AngleDiff = AvoidanceVelocity.HeadingAngle() - GetVelocityForRVOConsideration().HeadingAngle();
-		if (AngleDiff > 0.0f)
-		{
-			RawSteeringInput = FMath::Clamp(RawSteeringInput + RVOSteeringStep, 0.0f, 1.0f);
-		}
-		else if (AngleDiff < 0.0f)
-		{
-			RawSteeringInput = FMath::Clamp(RawSteeringInput - RVOSteeringStep, -1.0f, 0.0f);
-		}
+		RawSteeringInput = FMath::Clamp(RawSteeringInput + RVOSteeringStep, 0.0f, 1.0f);
 	}
-
-	return RawSteeringInput;
-}
-
-float UWheeledVehicleMovementComponent::CalcBrakeInput()
-{	
-	if(bReverseAsBrake)
+	else if (AngleDiff < 0.0f)
 	{
-	const float ForwardSpeed = GetForwardSpeed();
+		RawSteeringInput = FMath::Clamp(RawSteeringInput - RVOSteeringStep, -1.0f, 0.0f);
+	}
+}
 
-	float NewBrakeInput = 0.0f;
+void UWheeledVehicleMovementComponent::ApplyAvoidanceToRawThrottle()
+{
+	const float AvoidanceSpeedSq = AvoidanceVelocity.SizeSquared();
+	const float DesiredSpeedSq = GetVelocityForRVOConsideration().SizeSquared();
 
-	// if player wants to move forwards...
-		if (RawThrottleInput > 0.f)
+	if (AvoidanceSpeedSq > DesiredSpeedSq)
 	{
-		// if vehicle is moving backwards, then press brake
-			if (ForwardSpeed < -WrongDirectionThreshold)
-		{
-				NewBrakeInput = 1.0f;
-		}
-
+		RawThrottleInput = FMath::Clamp(RawThrottleInput + RVOThrottleStep, -1.0f, 1.0f);
 	}
-
-	// if player wants to move backwards...
-		else if (RawThrottleInput < 0.f)
+	else if (AvoidanceSpeedSq < DesiredSpeedSq)
 	{
-		// if vehicle is moving forwards, then press brake
-		if (ForwardSpeed > WrongDirectionThreshold)
-		{
-			NewBrakeInput = 1.0f;			// Seems a bit severe to have 0 or 1 braking. Better control can be had by allowing continuous brake input values
-			}
+		RawThrottleInput = FMath::Clamp(RawThrottleInput - RVOThrottleStep, -1.0f, 1.0f);
 	}
+}
 
-	// if player isn't pressing forward or backwards...
-	else
+float UWheeledVehicleMovementComponent::CalcSteeringInput()
+{
+	if (bUseRVOAvoidance)
 	{
-		if (ForwardSpeed < StopThreshold && ForwardSpeed > -StopThreshold)	//auto break 
-		{
-			NewBrakeInput = 1.f;
-		}
-		else
-		{
-			NewBrakeInput = IdleBrakeInput;
-		}
+		ApplyAvoidanceToRawSteering();
 	}
 
-	return FMath::Clamp<float>(NewBrakeInput, 0.0, 1.0);
-	}
-	else
-	{
-		return FMath::Abs(RawBrakeInput);
-	}
-	
+	return RawSteeringInput;
+}
+
+float UWheeledVehicleMovementComponent::CalcBrakeInput()
+{
+	FVehicleInputPacket Packet;
+	PackInput(GetForwardSpeed(), Packet);
+	return Packet.CalcBrakeInput();
 }
 
 float UWheeledVehicleMovementComponent::CalcHandbrakeInput()
@@ -1242,29 +1940,12 @@ float UWheeledVehicleMovementComponent::CalcThrottleInput()
 {
 	if (bUseRVOAvoidance)
 	{
-		const float AvoidanceSpeedSq = AvoidanceVelocity.SizeSquared();
-		const float DesiredSpeedSq = GetVelocityForRVOConsideration().SizeSquared();
-
-		if (AvoidanceSpeedSq > DesiredSpeedSq)
-		{
-			RawThrottleInput = FMath::Clamp(RawThrottleInput + RVOThrottleStep, -1.0f, 1.0f);
-		}
-		else if (AvoidanceSpeedSq < DesiredSpeedSq)
-		{
-			RawThrottleInput = FMath::Clamp(RawThrottleInput - RVOThrottleStep, -1.0f, 1.0f);
-		}		
-	}
-
-	if(bReverseAsBrake)
-	{
-	//If the user is changing direction we should really be braking first and not applying any gas, so wait until they've changed gears
-		if ((RawThrottleInput > 0.f && GetTargetGear() < 0) || (RawThrottleInput < 0.f && GetTargetGear() > 0))
-		{
-			return 0.f;
-		}
+		ApplyAvoidanceToRawThrottle();
 	}
 
-	return FMath::Abs(RawThrottleInput);
+	FVehicleInputPacket Packet;
+	PackInput(0.f, Packet);
+	return Packet.CalcThrottleInput();
 }
 
 #if WITH_PHYSX_VEHICLES
@@ -1463,6 +2144,28 @@ int32 UWheeledVehicleMovementComponent::GetTargetGear() const
 	return 0;
 }
 
+FReplicatedVehicleState UWheeledVehicleMovementComponent::GetSimulationInputState() const
+{
+	FReplicatedVehicleState State;
+	State.SteeringInput = SteeringInput;
+	State.ThrottleInput = ThrottleInput;
+	State.BrakeInput = BrakeInput;
+	State.HandbrakeInput = HandbrakeInput;
+	State.CurrentGear = GetTargetGear();
+	State.LeftThrustInput = 0.0f;
+	State.RightThrustInput = 0.0f;
+	return State;
+}
+
+void UWheeledVehicleMovementComponent::SetSimulationInputState(const FReplicatedVehicleState& InState)
+{
+	SteeringInput = InState.SteeringInput;
+	ThrottleInput = InState.ThrottleInput;
+	BrakeInput = InState.BrakeInput;
+	HandbrakeInput = InState.HandbrakeInput;
+	SetTargetGear(InState.CurrentGear, true);
+}
+
 bool UWheeledVehicleMovementComponent::GetUseAutoGears() const
 {
 #if WITH_PHYSX_VEHICLES
@@ -1489,40 +2192,18 @@ void UWheeledVehicleMovementComponent::Serialize(FArchive& Ar)
 
 
 #if WITH_PHYSX_VEHICLES
-void DrawTelemetryGraph( uint32 Channel, const PxVehicleGraph& PGraph, UCanvas* Canvas, float GraphX, float GraphY, float GraphWidth, float GraphHeight, float& OutX )
-{
-
-	//This is very hacky and we should really access this data from physx instead of copying their default values
-	//Copied in order of enum 
-	/*	eJOUNCE = 0,
-	eSUSPFORCE,
-	eTIRELOAD,
-	eNORMALIZED_TIRELOAD,
-	eWHEEL_OMEGA,
-	eTIRE_FRICTION,
-	eTIRE_LONG_SLIP,
-	eNORM_TIRE_LONG_FORCE,
-	eTIRE_LAT_SLIP,
-	eNORM_TIRE_LAT_FORCE,
-	eNORM_TIRE_ALIGNING_MOMENT,
-	eMAX_NB_WHEEL_CHANNELS
-	*/
-
-	float GraphMinY[] = { -2.f, 0.f, 0.f, 0.f, -50.f, 0.f, -0.2f, 0.f, -1.f, 0.f, 0.f };
-	float GraphMaxY[] = { 0.f, 20000.0f, 20000.0f, 3.f, 250.f, 1.1f, 0.2f, 2.f, 1.f, 2.f, 2.f };
+void DrawTelemetryGraph( const FPhysXVehicleTelemetry& Telemetry, uint32 WheelIdx, EVehicleTelemetryChannel Channel, UCanvas* Canvas, float GraphX, float GraphY, float GraphWidth, float GraphHeight, float& OutX )
+{
+	// Display ranges match the PhysX telemetry graph defaults, in EVehicleTelemetryChannel order
+	float GraphMinY[] = { -2.f, 0.f, 0.f, 0.f, -50.f, 0.f, -0.2f, 0.f, -1.f, 0.f };
+	float GraphMaxY[] = { 0.f, 20000.0f, 20000.0f, 3.f, 250.f, 1.1f, 0.2f, 2.f, 1.f, 2.f };
 	static_assert(sizeof(GraphMinY) == sizeof(GraphMaxY), "GraphMinY must be the same size as GraphMaxY");
-	static_assert(sizeof(GraphMinY) / sizeof(GraphMinY[0]) == PxVehicleWheelGraphChannel::eMAX_NB_WHEEL_CHANNELS, "Must have same number of entries as enum");
-
-	const float MinY = GraphMinY[Channel];
-	const float MaxY = GraphMaxY[Channel];
-
-	PxF32 PGraphXY[2*PxVehicleGraph::eMAX_NB_SAMPLES];
-	PxVec3 PGraphColor[PxVehicleGraph::eMAX_NB_SAMPLES];
-	char PGraphTitle[PxVehicleGraph::eMAX_NB_TITLE_CHARS];
+	static_assert(sizeof(GraphMinY) / sizeof(GraphMinY[0]) == (uint32)EVehicleTelemetryChannel::Num, "Must have same number of entries as enum");
 
-	PGraph.computeGraphChannel( Channel, PGraphXY, PGraphColor, PGraphTitle );
+	const float MinY = GraphMinY[(uint32)Channel];
+	const float MaxY = GraphMaxY[(uint32)Channel];
 
-	FString Label = ANSI_TO_TCHAR(PGraphTitle) + FString::Printf(TEXT("[%.2f,%.2f]"), MinY, MaxY);
+	FString Label = FPhysXVehicleTelemetry::GetChannelName(Channel) + FString::Printf(TEXT("[%.2f,%.2f]"), MinY, MaxY);
 	Canvas->SetDrawColor( FColor( 255, 255, 0 ) );
 	UFont* Font = GEngine->GetSmallFont();
 	Canvas->DrawText( Font, Label, GraphX, GraphY );
@@ -1538,17 +2219,19 @@ void DrawTelemetryGraph( uint32 Channel, const PxVehicleGraph& PGraph, UCanvas*
 	Canvas->DrawItem( TileItem );
 	
 	Canvas->SetDrawColor( FColor( 0, 32, 0, 128 ) );	
-	for ( uint32 i = 2; i < 2 * PxVehicleGraph::eMAX_NB_SAMPLES; i += 2 )
-	{
-		float x1 = PGraphXY[i-2];
-		float y1 = PGraphXY[i-1];
-		float x2 = PGraphXY[i];
-		float y2 = PGraphXY[i+1];
 
-		x1 = FMath::Clamp( x1 + 0.50f, 0.0f, 1.0f );
-		x2 = FMath::Clamp( x2 + 0.50f, 0.0f, 1.0f );
-		y1 = 1.0f - FMath::Clamp( y1 + 0.50f, 0.0f, 1.0f );
-		y2 = 1.0f - FMath::Clamp( y2 + 0.50f, 0.0f, 1.0f );
+	// Oldest sample on the left, newest on the right
+	const int32 NumSamples = Telemetry.GetNumSamples();
+	const float SampleStep = 1.0f / (FPhysXVehicleTelemetry::MaxSamples - 1);
+	const float StartX = 1.0f - (NumSamples - 1) * SampleStep;
+	const float InvRangeY = 1.0f / (MaxY - MinY);
+
+	for ( int32 i = 1; i < NumSamples; ++i )
+	{
+		const float x1 = StartX + (i - 1) * SampleStep;
+		const float x2 = StartX + i * SampleStep;
+		const float y1 = 1.0f - FMath::Clamp( (Telemetry.GetSample( WheelIdx, Channel, i - 1 ) - MinY) * InvRangeY, 0.0f, 1.0f );
+		const float y2 = 1.0f - FMath::Clamp( (Telemetry.GetSample( WheelIdx, Channel, i ) - MinY) * InvRangeY, 0.0f, 1.0f );
 
 		FCanvasLineItem LineItem( FVector2D( GraphX + x1 * GraphWidth, LineGraphY + y1 * LineGraphHeight ), FVector2D( GraphX + x2 * GraphWidth, LineGraphY + y2 * LineGraphHeight ) );
 		LineItem.SetColor( FLinearColor( 1.0f, 0.5f, 0.0f, 1.0f ) );
@@ -1573,28 +2256,22 @@ bool UWheeledVehicleMovementComponent::CheckSlipThreshold(float AbsLongSlipThres
 	PxWheelQueryResult * WheelsStates = MyVehicleManager->GetWheelsStates_AssumesLocked(this);
 	check(WheelsStates);
 
-	PxReal MaxLongSlip = 0.f;
-	PxReal MaxLatSlip = 0.f;
-
-	// draw wheel data
-	for (uint32 w = 0; w < PVehicle->mWheelsSimData.getNbWheels(); ++w)
+	// No early out, so the common wheel counts unroll into straight compares
+	return DispatchWheelCount(PVehicle->mWheelsSimData.getNbWheels(), [WheelsStates, AbsLongSlipThreshold, AbsLatSlipThreshold](auto NumWheels)
 	{
-		const PxReal AbsLongSlip = FMath::Abs(WheelsStates[w].longitudinalSlip);
-		const PxReal AbsLatSlip = FMath::Abs(WheelsStates[w].lateralSlip);
-
-		if (AbsLongSlip > AbsLongSlipThreshold)
+		bool bOverThreshold = false;
+		for (int32 w = 0; w < NumWheels; ++w)
 		{
-			return true;
-		}
+			const PxReal AbsLongSlip = FMath::Abs(WheelsStates[w].longitudinalSlip);
+			const PxReal AbsLatSlip = FMath::Abs(WheelsStates[w].lateralSlip);
 
-		if (AbsLatSlip > AbsLatSlipThreshold)
-		{
-			return true;
+			bOverThreshold |= (AbsLongSlip > AbsLongSlipThreshold) | (AbsLatSlip > AbsLatSlipThreshold);
 		}
-	}
-#endif // WITH_PHYSX
-
+		return bOverThreshold;
+	});
+#else
 	return false;
+#endif // WITH_PHYSX
 }
 
 float UWheeledVehicleMovementComponent::GetMaxSpringForce() const
@@ -1611,15 +2288,15 @@ float UWheeledVehicleMovementComponent::GetMaxSpringForce() const
 	PxWheelQueryResult * WheelsStates = MyVehicleManager->GetWheelsStates_AssumesLocked(this);
 	check(WheelsStates);
 
-	PxReal MaxSpringCompression = 0.f;
-
-	// draw wheel data
-	for (uint32 w = 0; w < PVehicle->mWheelsSimData.getNbWheels(); ++w)
+	return DispatchWheelCount(PVehicle->mWheelsSimData.getNbWheels(), [WheelsStates](auto NumWheels)
 	{
-		MaxSpringCompression = WheelsStates[w].suspSpringForce > MaxSpringCompression ? WheelsStates[w].suspSpringForce : MaxSpringCompression;
-	}
-
-	return MaxSpringCompression;
+		PxReal MaxSpringCompression = 0.f;
+		for (int32 w = 0; w < NumWheels; ++w)
+		{
+			MaxSpringCompression = FMath::Max(MaxSpringCompression, WheelsStates[w].suspSpringForce);
+		}
+		return MaxSpringCompression;
+	});
 #else
 	return 0.0f;
 #endif // WITH_PHYSX
@@ -1724,30 +2401,31 @@ void UWheeledVehicleMovementComponent::DrawDebug(UCanvas* Canvas, float& YL, flo
 	}
 
 	// draw wheel graphs
-	PxVehicleTelemetryData* TelemetryData = MyVehicleManager->GetTelemetryData_AssumesLocked();
+	const FPhysXVehicleTelemetry* Telemetry = MyVehicleManager->GetTelemetry_AssumesLocked(this);
 
-	if (TelemetryData)
+	if (Telemetry)
 	{
 		const float GraphWidth(100.0f), GraphHeight(100.0f);
 
-		int GraphChannels[] = {
-			PxVehicleWheelGraphChannel::eWHEEL_OMEGA,
-			PxVehicleWheelGraphChannel::eSUSPFORCE,
-			PxVehicleWheelGraphChannel::eTIRE_LONG_SLIP,
-			PxVehicleWheelGraphChannel::eNORM_TIRE_LONG_FORCE,
-			PxVehicleWheelGraphChannel::eTIRE_LAT_SLIP,
-			PxVehicleWheelGraphChannel::eNORM_TIRE_LAT_FORCE,
-			PxVehicleWheelGraphChannel::eNORMALIZED_TIRELOAD,
-			PxVehicleWheelGraphChannel::eTIRE_FRICTION
+		EVehicleTelemetryChannel GraphChannels[] = {
+			EVehicleTelemetryChannel::WheelOmega,
+			EVehicleTelemetryChannel::SuspForce,
+			EVehicleTelemetryChannel::LongSlip,
+			EVehicleTelemetryChannel::NormLongForce,
+			EVehicleTelemetryChannel::LatSlip,
+			EVehicleTelemetryChannel::NormLatForce,
+			EVehicleTelemetryChannel::NormalizedTireLoad,
+			EVehicleTelemetryChannel::TireFriction
 		};
 
-		for (uint32 w = 0; w < PVehicle->mWheelsSimData.getNbWheels(); ++w)
+		const uint32 NumGraphWheels = FMath::Min<uint32>(PVehicle->mWheelsSimData.getNbWheels(), Telemetry->GetNumWheels());
+		for (uint32 w = 0; w < NumGraphWheels; ++w)
 		{
 			float CurX = 4;
 			for (uint32 i = 0; i < UE_ARRAY_COUNT(GraphChannels); ++i)
 			{
 				float OutX = GraphWidth;
-				DrawTelemetryGraph(GraphChannels[i], TelemetryData->getWheelGraph(w), Canvas, CurX, YPos, GraphWidth, GraphHeight, OutX);
+				DrawTelemetryGraph(*Telemetry, w, GraphChannels[i], Canvas, CurX, YPos, GraphWidth, GraphHeight, OutX);
 				CurX += OutX + 10.f;
 			}
 
@@ -1849,7 +2527,6 @@ void UWheeledVehicleMovementComponent::DrawDebugLines()
 	DrawDebugLine(World, P2UVector(T.p), P2UVector(T.p + T.rotate(PxVec3(0, 0, ChassisSize))), FColor::Blue);
 
 	SCOPED_SCENE_READ_LOCK(MyVehicleManager->GetScene());
-	PxVehicleTelemetryData* TelemetryData = MyVehicleManager->GetTelemetryData_AssumesLocked();
 	
 	PxWheelQueryResult* WheelsStates = MyVehicleManager->GetWheelsStates_AssumesLocked(this);
 	check(WheelsStates);
@@ -1884,15 +2561,15 @@ void UWheeledVehicleMovementComponent::DrawDebugLines()
 		const FVector ContactPoint = P2UVector( WheelsStates[w].tireContactPoint );
 		DrawDebugBox( World, ContactPoint, FVector(4.0f), FQuat::Identity, SuspensionColor );
 
-		if ( TelemetryData )
+		if ( !WheelsStates[w].isInAir )
 		{
-			// Draw all tire force app points.
-			const PxVec3& PAppPoint = TelemetryData->getTireforceAppPoints()[w];
+			// Draw all tire force app points. Offsets are relative to the center of mass frame
+			const PxVec3 PAppPoint = T.transform( PVehicle->mWheelsSimData.getTireForceAppPointOffset(w) );
 			const FVector AppPoint = P2UVector( PAppPoint );
 			DrawDebugBox( World, AppPoint, FVector(5.0f), FQuat::Identity, FColor( 255, 0, 255 ) );
 
 			// Draw all susp force app points.
-			const PxVec3& PAppPoint2 = TelemetryData->getSuspforceAppPoints()[w];
+			const PxVec3 PAppPoint2 = T.transform( PVehicle->mWheelsSimData.getSuspForceAppPointOffset(w) );
 			const FVector AppPoint2 = P2UVector( PAppPoint2 );
 			DrawDebugBox( World, AppPoint2, FVector(5.0f), FQuat::Identity, FColor( 0, 255, 255 ) );
 		}
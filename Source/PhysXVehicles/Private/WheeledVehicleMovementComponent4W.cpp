@@ -2,6 +2,8 @@
 
 #include "WheeledVehicleMovementComponent4W.h"
 #include "Components/PrimitiveComponent.h"
+#include "PhysXVehicleDriveSetup.h"
+#include "VehicleSimSetup.h"
 
 #include "PhysXPublic.h"
 
@@ -21,47 +23,12 @@ UWheeledVehicleMovementComponent4W::UWheeledVehicleMovementComponent4W(const FOb
 	DifferentialSetup.FrontBias = DefDifferentialSetup.mFrontBias;
 	DifferentialSetup.RearBias = DefDifferentialSetup.mRearBias;
 
-	PxVehicleEngineData DefEngineData;
-	EngineSetup.MOI = DefEngineData.mMOI;
-	EngineSetup.MaxRPM = OmegaToRPM(DefEngineData.mMaxOmega);
-	EngineSetup.DampingRateFullThrottle = DefEngineData.mDampingRateFullThrottle;
-	EngineSetup.DampingRateZeroThrottleClutchEngaged = DefEngineData.mDampingRateZeroThrottleClutchEngaged;
-	EngineSetup.DampingRateZeroThrottleClutchDisengaged = DefEngineData.mDampingRateZeroThrottleClutchDisengaged;
-
-	// Convert from PhysX curve to ours
-	FRichCurve* TorqueCurveData = EngineSetup.TorqueCurve.GetRichCurve();
-	for(PxU32 KeyIdx=0; KeyIdx<DefEngineData.mTorqueCurve.getNbDataPairs(); KeyIdx++)
-	{
-		float Input = DefEngineData.mTorqueCurve.getX(KeyIdx) * EngineSetup.MaxRPM;
-		float Output = DefEngineData.mTorqueCurve.getY(KeyIdx) * DefEngineData.mPeakTorque;
-		TorqueCurveData->AddKey(Input, Output);
-	}
-
-	PxVehicleClutchData DefClutchData;
-	TransmissionSetup.ClutchStrength = DefClutchData.mStrength;
+	GetDefaultVehicleEngineSetup(EngineSetup);
+	GetDefaultVehicleTransmissionSetup(TransmissionSetup);
 
 	PxVehicleAckermannGeometryData DefAckermannSetup;
 	AckermannAccuracy = DefAckermannSetup.mAccuracy;
 
-	PxVehicleGearsData DefGearSetup;
-	TransmissionSetup.GearSwitchTime = DefGearSetup.mSwitchTime;
-	TransmissionSetup.ReverseGearRatio = DefGearSetup.mRatios[PxVehicleGearsData::eREVERSE];
-	TransmissionSetup.FinalRatio = DefGearSetup.mFinalRatio;
-
-	PxVehicleAutoBoxData DefAutoBoxSetup;
-	TransmissionSetup.NeutralGearUpRatio = DefAutoBoxSetup.mUpRatios[PxVehicleGearsData::eNEUTRAL];
-	TransmissionSetup.GearAutoBoxLatency = DefAutoBoxSetup.getLatency();
-	TransmissionSetup.bUseGearAutoBox = true;
-
-	for (uint32 i = PxVehicleGearsData::eFIRST; i < DefGearSetup.mNbRatios; i++)
-	{
-		FVehicleGearData GearData;
-		GearData.DownRatio = DefAutoBoxSetup.mDownRatios[i];
-		GearData.UpRatio = DefAutoBoxSetup.mUpRatios[i];
-		GearData.Ratio = DefGearSetup.mRatios[i];
-		TransmissionSetup.ForwardGears.Add(GearData);
-	}
-	
 	// Init steering speed curve
 	FRichCurve* SteeringCurveData = SteeringCurve.GetRichCurve();
 	SteeringCurveData->AddKey(0.f, 1.f);
@@ -72,6 +39,9 @@ UWheeledVehicleMovementComponent4W::UWheeledVehicleMovementComponent4W(const FOb
 	// Initialize WheelSetups array with 4 wheels
 	WheelSetups.SetNum(4);
 #endif // WITH_PHYSX
+
+	// Does not override GenerateTireForces, so the default tire model runs natively. Subclasses overriding it set this back
+	bCallGenerateTireForces = false;
 }
 
 #if WITH_EDITOR
@@ -161,7 +131,7 @@ float FVehicleEngineData::FindPeakTorque() const
 }
 
 #if PHYSICS_INTERFACE_PHYSX
-static void GetVehicleEngineSetup(const FVehicleEngineData& Setup, PxVehicleEngineData& PxSetup)
+void GetVehicleEngineSetup(const FVehicleEngineData& Setup, PxVehicleEngineData& PxSetup)
 {
 	PxSetup.mMOI = M2ToCm2(Setup.MOI);
 	PxSetup.mMaxOmega = RPMToOmega(Setup.MaxRPM);
@@ -185,7 +155,7 @@ static void GetVehicleEngineSetup(const FVehicleEngineData& Setup, PxVehicleEngi
 	}
 }
 
-static void GetVehicleGearSetup(const FVehicleTransmissionData& Setup, PxVehicleGearsData& PxSetup)
+void GetVehicleGearSetup(const FVehicleTransmissionData& Setup, PxVehicleGearsData& PxSetup)
 {
 	PxSetup.mSwitchTime = Setup.GearSwitchTime;
 	PxSetup.mRatios[PxVehicleGearsData::eREVERSE] = Setup.ReverseGearRatio;
@@ -197,7 +167,7 @@ static void GetVehicleGearSetup(const FVehicleTransmissionData& Setup, PxVehicle
 	PxSetup.mNbRatios = Setup.ForwardGears.Num() + PxVehicleGearsData::eFIRST;
 }
 
-static void GetVehicleAutoBoxSetup(const FVehicleTransmissionData& Setup, PxVehicleAutoBoxData& PxSetup)
+void GetVehicleAutoBoxSetup(const FVehicleTransmissionData& Setup, PxVehicleAutoBoxData& PxSetup)
 {
 	for (int32 i = 0; i < Setup.ForwardGears.Num(); i++)
 	{
@@ -209,6 +179,81 @@ static void GetVehicleAutoBoxSetup(const FVehicleTransmissionData& Setup, PxVehi
 	PxSetup.setLatency(Setup.GearAutoBoxLatency);
 }
 
+void GetVehicleSteerLookup(const FRuntimeFloatCurve& SteeringCurve, PxFixedSizeLookupTable<8>& PxSteerLookup)
+{
+	// Convert from our curve to PxFixedSizeLookupTable
+	TArray<FRichCurveKey> SteerKeys = SteeringCurve.GetRichCurveConst()->GetCopyOfKeys();
+	const int32 MaxSteeringSamples = FMath::Min(8, SteerKeys.Num());
+	for(int32 KeyIdx = 0; KeyIdx < MaxSteeringSamples; KeyIdx++)
+	{
+		FRichCurveKey& Key = SteerKeys[KeyIdx];
+		PxSteerLookup.addPair(KmHToCmS(Key.Time), FMath::Clamp(Key.Value, 0.f, 1.f));
+	}
+}
+
+void GetDefaultVehicleEngineSetup(FVehicleEngineData& Setup)
+{
+	PxVehicleEngineData DefEngineData;
+	Setup.MOI = DefEngineData.mMOI;
+	Setup.MaxRPM = OmegaToRPM(DefEngineData.mMaxOmega);
+	Setup.DampingRateFullThrottle = DefEngineData.mDampingRateFullThrottle;
+	Setup.DampingRateZeroThrottleClutchEngaged = DefEngineData.mDampingRateZeroThrottleClutchEngaged;
+	Setup.DampingRateZeroThrottleClutchDisengaged = DefEngineData.mDampingRateZeroThrottleClutchDisengaged;
+
+	// Convert from PhysX curve to ours
+	FRichCurve* TorqueCurveData = Setup.TorqueCurve.GetRichCurve();
+	for (PxU32 KeyIdx = 0; KeyIdx < DefEngineData.mTorqueCurve.getNbDataPairs(); KeyIdx++)
+	{
+		float Input = DefEngineData.mTorqueCurve.getX(KeyIdx) * Setup.MaxRPM;
+		float Output = DefEngineData.mTorqueCurve.getY(KeyIdx) * DefEngineData.mPeakTorque;
+		TorqueCurveData->AddKey(Input, Output);
+	}
+}
+
+void GetDefaultVehicleTransmissionSetup(FVehicleTransmissionData& Setup)
+{
+	PxVehicleClutchData DefClutchData;
+	Setup.ClutchStrength = DefClutchData.mStrength;
+
+	PxVehicleGearsData DefGearSetup;
+	Setup.GearSwitchTime = DefGearSetup.mSwitchTime;
+	Setup.ReverseGearRatio = DefGearSetup.mRatios[PxVehicleGearsData::eREVERSE];
+	Setup.FinalRatio = DefGearSetup.mFinalRatio;
+
+	PxVehicleAutoBoxData DefAutoBoxSetup;
+	Setup.NeutralGearUpRatio = DefAutoBoxSetup.mUpRatios[PxVehicleGearsData::eNEUTRAL];
+	Setup.GearAutoBoxLatency = DefAutoBoxSetup.getLatency();
+	Setup.bUseGearAutoBox = true;
+
+	for (uint32 i = PxVehicleGearsData::eFIRST; i < DefGearSetup.mNbRatios; i++)
+	{
+		FVehicleGearData GearData;
+		GearData.DownRatio = DefAutoBoxSetup.mDownRatios[i];
+		GearData.UpRatio = DefAutoBoxSetup.mUpRatios[i];
+		GearData.Ratio = DefGearSetup.mRatios[i];
+		Setup.ForwardGears.Add(GearData);
+	}
+}
+
+void SetupVehicleDriveSimData(const FVehicleEngineData& EngineSetup, const FVehicleTransmissionData& TransmissionSetup, PxVehicleDriveSimData& DriveData)
+{
+	PxVehicleEngineData EngineData;
+	GetVehicleEngineSetup(EngineSetup, EngineData);
+	DriveData.setEngineData(EngineData);
+
+	PxVehicleClutchData ClutchData;
+	ClutchData.mStrength = M2ToCm2(TransmissionSetup.ClutchStrength);
+	DriveData.setClutchData(ClutchData);
+
+	PxVehicleGearsData GearData;
+	GetVehicleGearSetup(TransmissionSetup, GearData);
+	DriveData.setGearsData(GearData);
+
+	PxVehicleAutoBoxData AutoBoxData;
+	GetVehicleAutoBoxSetup(TransmissionSetup, AutoBoxData);
+	DriveData.setAutoBoxData(AutoBoxData);
+}
+
 void SetupDriveHelper(const UWheeledVehicleMovementComponent4W* VehicleData, const PxVehicleWheelsSimData* PWheelsSimData, PxVehicleDriveSimData4W& DriveData)
 {
 	PxVehicleDifferential4WData DifferentialSetup;
@@ -261,7 +306,10 @@ void UWheeledVehicleMovementComponent4W::SetupVehicleDrive(PxVehicleWheelsSimDat
 
 	// Setup drive data
 	PxVehicleDriveSimData4W DriveData;
-	SetupDriveHelper(this, PWheelsSimData, DriveData);
+	if (!CanUseCompiledSimSetup() || !CompiledSimSetup->GetDriveSimData(PxVehicleTypes::eDRIVE4W, DriveData))
+	{
+		SetupDriveHelper(this, PWheelsSimData, DriveData);
+	}
 
 	// Create the vehicle
 	PxVehicleDrive4W* PVehicleDrive4W = PxVehicleDrive4W::allocate(4);
@@ -295,45 +343,33 @@ void UWheeledVehicleMovementComponent4W::SetupVehicleDrive(PxVehicleWheelsSimDat
 	SetUseAutoGears(TransmissionSetup.bUseGearAutoBox);
 }
 
-void UWheeledVehicleMovementComponent4W::UpdateSimulation(float DeltaTime)
+void UWheeledVehicleMovementComponent4W::UpdateSimulation_AssumesLocked(float DeltaTime)
 {
 	if (PVehicleDrive == NULL)
 		return;
 
-	FBodyInstance* Instance = UpdatedPrimitive->GetBodyInstance();
+	PxVehicleDrive4WRawInputData RawInputData;
+	RawInputData.setAnalogAccel(ThrottleInput);
+	RawInputData.setAnalogSteer(SteeringInput);
+	RawInputData.setAnalogBrake(BrakeInput);
+	RawInputData.setAnalogHandbrake(HandbrakeInput);
 
-	FPhysicsCommand::ExecuteWrite(Instance->GetActorReferenceWithWelding(), [&](const FPhysicsActorHandle& Actor)
+	if(!PVehicleDrive->mDriveDynData.getUseAutoGears())
 	{
-		PxVehicleDrive4WRawInputData RawInputData;
-		RawInputData.setAnalogAccel(ThrottleInput);
-		RawInputData.setAnalogSteer(SteeringInput);
-		RawInputData.setAnalogBrake(BrakeInput);
-		RawInputData.setAnalogHandbrake(HandbrakeInput);
-
-		if(!PVehicleDrive->mDriveDynData.getUseAutoGears())
-		{
-			RawInputData.setGearUp(bRawGearUpInput);
-			RawInputData.setGearDown(bRawGearDownInput);
-		}
+		RawInputData.setGearUp(bRawGearUpInput);
+		RawInputData.setGearDown(bRawGearDownInput);
+	}
 
-		// Convert from our curve to PxFixedSizeLookupTable
-		PxFixedSizeLookupTable<8> SpeedSteerLookup;
-		TArray<FRichCurveKey> SteerKeys = SteeringCurve.GetRichCurve()->GetCopyOfKeys();
-		const int32 MaxSteeringSamples = FMath::Min(8, SteerKeys.Num());
-		for(int32 KeyIdx = 0; KeyIdx < MaxSteeringSamples; KeyIdx++)
-		{
-			FRichCurveKey& Key = SteerKeys[KeyIdx];
-			SpeedSteerLookup.addPair(KmHToCmS(Key.Time), FMath::Clamp(Key.Value, 0.f, 1.f));
-		}
+	PxFixedSizeLookupTable<8> SpeedSteerLookup;
+	GetVehicleSteerLookup(SteeringCurve, SpeedSteerLookup);
 
-		PxVehiclePadSmoothingData SmoothData = {
-			{ ThrottleInputRate.RiseRate, BrakeInputRate.RiseRate, HandbrakeInputRate.RiseRate, SteeringInputRate.RiseRate, SteeringInputRate.RiseRate },
-			{ ThrottleInputRate.FallRate, BrakeInputRate.FallRate, HandbrakeInputRate.FallRate, SteeringInputRate.FallRate, SteeringInputRate.FallRate }
-		};
+	PxVehiclePadSmoothingData SmoothData = {
+		{ ThrottleInputRate.RiseRate, BrakeInputRate.RiseRate, HandbrakeInputRate.RiseRate, SteeringInputRate.RiseRate, SteeringInputRate.RiseRate },
+		{ ThrottleInputRate.FallRate, BrakeInputRate.FallRate, HandbrakeInputRate.FallRate, SteeringInputRate.FallRate, SteeringInputRate.FallRate }
+	};
 
-		PxVehicleDrive4W* PVehicleDrive4W = (PxVehicleDrive4W*)PVehicleDrive;
-		PxVehicleDrive4WSmoothAnalogRawInputsAndSetAnalogInputs(SmoothData, SpeedSteerLookup, RawInputData, DeltaTime, false, *PVehicleDrive4W);
-	});
+	PxVehicleDrive4W* PVehicleDrive4W = (PxVehicleDrive4W*)PVehicleDrive;
+	PxVehicleDrive4WSmoothAnalogRawInputsAndSetAnalogInputs(SmoothData, SpeedSteerLookup, RawInputData, DeltaTime, false, *PVehicleDrive4W);
 }
 
 #endif // WITH_PHYSX_VEHICLES
@@ -427,4 +463,13 @@ void UWheeledVehicleMovementComponent4W::ComputeConstants()
 	MaxEngineRPM = EngineSetup.MaxRPM;
 }
 
+uint32 UWheeledVehicleMovementComponent4W::GetSimSetupSourceHash() const
+{
+	uint32 Hash = Super::GetSimSetupSourceHash();
+	Hash = UVehicleSimSetup::HashProperties(FVehicleEngineData::StaticStruct(), &EngineSetup, Hash);
+	Hash = UVehicleSimSetup::HashProperties(FVehicleDifferential4WData::StaticStruct(), &DifferentialSetup, Hash);
+	Hash = UVehicleSimSetup::HashProperties(FVehicleTransmissionData::StaticStruct(), &TransmissionSetup, Hash);
+	return HashCombine(Hash, GetTypeHash(AckermannAccuracy));
+}
+
 PRAGMA_ENABLE_DEPRECATION_WARNINGS
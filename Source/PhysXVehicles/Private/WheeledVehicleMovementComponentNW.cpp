@@ -0,0 +1,245 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "WheeledVehicleMovementComponentNW.h"
+#include "Components/PrimitiveComponent.h"
+#include "PhysXVehicleDriveSetup.h"
+#include "VehicleSimSetup.h"
+
+#include "PhysXPublic.h"
+
+PRAGMA_DISABLE_DEPRECATION_WARNINGS
+
+UWheeledVehicleMovementComponentNW::UWheeledVehicleMovementComponentNW(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
+{
+#if PHYSICS_INTERFACE_PHYSX
+	// grab default values from physx
+	GetDefaultVehicleEngineSetup(EngineSetup);
+	GetDefaultVehicleTransmissionSetup(TransmissionSetup);
+
+	// Init steering speed curve
+	FRichCurve* SteeringCurveData = SteeringCurve.GetRichCurve();
+	SteeringCurveData->AddKey(0.f, 1.f);
+	SteeringCurveData->AddKey(20.f, 0.9f);
+	SteeringCurveData->AddKey(60.f, 0.8f);
+	SteeringCurveData->AddKey(120.f, 0.7f);
+
+	// Initialize WheelSetups array with 3 axles
+	WheelSetups.SetNum(6);
+#endif // WITH_PHYSX
+
+	// Does not override GenerateTireForces, so the default tire model runs natively. Subclasses overriding it set this back
+	bCallGenerateTireForces = false;
+}
+
+#if WITH_EDITOR
+void UWheeledVehicleMovementComponentNW::PostEditChangeProperty(struct FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+	const FName PropertyName = PropertyChangedEvent.Property ? PropertyChangedEvent.Property->GetFName() : NAME_None;
+
+	if (PropertyName == TEXT("DownRatio"))
+	{
+		for (int32 GearIdx = 0; GearIdx < TransmissionSetup.ForwardGears.Num(); ++GearIdx)
+		{
+			FVehicleGearData & GearData = TransmissionSetup.ForwardGears[GearIdx];
+			GearData.DownRatio = FMath::Min(GearData.DownRatio, GearData.UpRatio);
+		}
+	}
+	else if (PropertyName == TEXT("UpRatio"))
+	{
+		for (int32 GearIdx = 0; GearIdx < TransmissionSetup.ForwardGears.Num(); ++GearIdx)
+		{
+			FVehicleGearData & GearData = TransmissionSetup.ForwardGears[GearIdx];
+			GearData.UpRatio = FMath::Max(GearData.DownRatio, GearData.UpRatio);
+		}
+	}
+	else if (PropertyName == TEXT("SteeringCurve"))
+	{
+		//make sure values are capped between 0 and 1
+		TArray<FRichCurveKey> SteerKeys = SteeringCurve.GetRichCurve()->GetCopyOfKeys();
+		for (int32 KeyIdx = 0; KeyIdx < SteerKeys.Num(); ++KeyIdx)
+		{
+			float NewValue = FMath::Clamp(SteerKeys[KeyIdx].Value, 0.f, 1.f);
+			SteeringCurve.GetRichCurve()->UpdateOrAddKey(SteerKeys[KeyIdx].Time, NewValue);
+		}
+	}
+}
+#endif
+
+#if PHYSICS_INTERFACE_PHYSX
+
+static void GetVehicleDifferentialNWSetup(const FVehicleDifferentialNWData& Setup, int32 NumWheels, PxVehicleDifferentialNWData& PxSetup)
+{
+	if (Setup.DrivenWheels.Num() == 0)
+	{
+		for (int32 WheelIdx = 0; WheelIdx < NumWheels; ++WheelIdx)
+		{
+			PxSetup.setDrivenWheel(WheelIdx, true);
+		}
+		return;
+	}
+
+	for (int32 WheelIdx : Setup.DrivenWheels)
+	{
+		if (WheelIdx >= 0 && WheelIdx < NumWheels)
+		{
+			PxSetup.setDrivenWheel(WheelIdx, true);
+		}
+	}
+}
+
+static void SetupDriveHelperNW(const UWheeledVehicleMovementComponentNW* VehicleData, int32 NumWheels, PxVehicleDriveSimDataNW& DriveData)
+{
+	PxVehicleDifferentialNWData DifferentialSetup;
+	GetVehicleDifferentialNWSetup(VehicleData->DifferentialSetup, NumWheels, DifferentialSetup);
+	DriveData.setDiffData(DifferentialSetup);
+
+	SetupVehicleDriveSimData(VehicleData->EngineSetup, VehicleData->TransmissionSetup, DriveData);
+}
+
+#endif // WITH_PHYSX
+
+#if WITH_PHYSX_VEHICLES
+
+void UWheeledVehicleMovementComponentNW::SetupVehicleDrive(PxVehicleWheelsSimData* PWheelsSimData)
+{
+	const int32 NumWheels = WheelSetups.Num();
+	if (NumWheels < 1 || NumWheels > PX_MAX_NB_WHEELS)
+	{
+		PVehicle = nullptr;
+		PVehicleDrive = nullptr;
+		return;
+	}
+
+	// Setup drive data
+	PxVehicleDriveSimDataNW DriveData;
+	if (!CanUseCompiledSimSetup() || !CompiledSimSetup->GetDriveSimData(PxVehicleTypes::eDRIVENW, DriveData))
+	{
+		SetupDriveHelperNW(this, NumWheels, DriveData);
+	}
+
+	// Create the vehicle
+	PxVehicleDriveNW* PVehicleDriveNW = PxVehicleDriveNW::allocate(NumWheels);
+	check(PVehicleDriveNW);
+
+	FPhysicsCommand::ExecuteWrite(UpdatedPrimitive->GetBodyInstance()->ActorHandle, [&](const FPhysicsActorHandle& Actor)
+	{
+#if WITH_CHAOS || WITH_IMMEDIATE_PHYSX
+		PxRigidActor* PRigidActor = nullptr;
+#else
+		PxRigidActor* PRigidActor = Actor.SyncActor;
+#endif
+
+		if (PRigidActor)
+		{
+			if (PxRigidDynamic* PRigidDynamic = PRigidActor->is<PxRigidDynamic>())
+			{
+				PVehicleDriveNW->setup(GPhysXSDK, PRigidDynamic, *PWheelsSimData, DriveData, NumWheels);
+				PVehicleDriveNW->setToRestState();
+
+				// cleanup
+				PWheelsSimData->free();
+			}
+		}
+	});
+
+	// cache values
+	PVehicle = PVehicleDriveNW;
+	PVehicleDrive = PVehicleDriveNW;
+
+	SetUseAutoGears(TransmissionSetup.bUseGearAutoBox);
+}
+
+void UWheeledVehicleMovementComponentNW::UpdateSimulation_AssumesLocked(float DeltaTime)
+{
+	if (PVehicleDrive == NULL)
+		return;
+
+	PxVehicleDriveNWRawInputData RawInputData;
+	RawInputData.setAnalogAccel(ThrottleInput);
+	RawInputData.setAnalogSteer(SteeringInput);
+	RawInputData.setAnalogBrake(BrakeInput);
+	RawInputData.setAnalogHandbrake(HandbrakeInput);
+
+	if (!PVehicleDrive->mDriveDynData.getUseAutoGears())
+	{
+		RawInputData.setGearUp(bRawGearUpInput);
+		RawInputData.setGearDown(bRawGearDownInput);
+	}
+
+	PxFixedSizeLookupTable<8> SpeedSteerLookup;
+	GetVehicleSteerLookup(SteeringCurve, SpeedSteerLookup);
+
+	PxVehiclePadSmoothingData SmoothData = {
+		{ ThrottleInputRate.RiseRate, BrakeInputRate.RiseRate, HandbrakeInputRate.RiseRate, SteeringInputRate.RiseRate, SteeringInputRate.RiseRate },
+		{ ThrottleInputRate.FallRate, BrakeInputRate.FallRate, HandbrakeInputRate.FallRate, SteeringInputRate.FallRate, SteeringInputRate.FallRate }
+	};
+
+	PxVehicleDriveNW* PVehicleDriveNW = (PxVehicleDriveNW*)PVehicleDrive;
+	PxVehicleDriveNWSmoothAnalogRawInputsAndSetAnalogInputs(SmoothData, SpeedSteerLookup, RawInputData, DeltaTime, false, *PVehicleDriveNW);
+}
+
+#endif // WITH_PHYSX_VEHICLES
+
+
+void UWheeledVehicleMovementComponentNW::UpdateEngineSetup(const FVehicleEngineData& NewEngineSetup)
+{
+#if PHYSICS_INTERFACE_PHYSX
+	if (PVehicleDrive)
+	{
+		PxVehicleEngineData EngineData;
+		GetVehicleEngineSetup(NewEngineSetup, EngineData);
+
+		PxVehicleDriveNW* PVehicleDriveNW = (PxVehicleDriveNW*)PVehicleDrive;
+		PVehicleDriveNW->mDriveSimData.setEngineData(EngineData);
+	}
+#endif // WITH_PHYSX
+}
+
+void UWheeledVehicleMovementComponentNW::UpdateDifferentialSetup(const FVehicleDifferentialNWData& NewDifferentialSetup)
+{
+#if PHYSICS_INTERFACE_PHYSX
+	if (PVehicleDrive)
+	{
+		PxVehicleDifferentialNWData DifferentialData;
+		GetVehicleDifferentialNWSetup(NewDifferentialSetup, PVehicleDrive->mWheelsSimData.getNbWheels(), DifferentialData);
+
+		PxVehicleDriveNW* PVehicleDriveNW = (PxVehicleDriveNW*)PVehicleDrive;
+		PVehicleDriveNW->mDriveSimData.setDiffData(DifferentialData);
+	}
+#endif // WITH_PHYSX
+}
+
+void UWheeledVehicleMovementComponentNW::UpdateTransmissionSetup(const FVehicleTransmissionData& NewTransmissionSetup)
+{
+#if PHYSICS_INTERFACE_PHYSX
+	if (PVehicleDrive)
+	{
+		PxVehicleGearsData GearData;
+		GetVehicleGearSetup(NewTransmissionSetup, GearData);
+
+		PxVehicleAutoBoxData AutoBoxData;
+		GetVehicleAutoBoxSetup(NewTransmissionSetup, AutoBoxData);
+
+		PxVehicleDriveNW* PVehicleDriveNW = (PxVehicleDriveNW*)PVehicleDrive;
+		PVehicleDriveNW->mDriveSimData.setGearsData(GearData);
+		PVehicleDriveNW->mDriveSimData.setAutoBoxData(AutoBoxData);
+	}
+#endif // WITH_PHYSX
+}
+
+void UWheeledVehicleMovementComponentNW::ComputeConstants()
+{
+	Super::ComputeConstants();
+	MaxEngineRPM = EngineSetup.MaxRPM;
+}
+
+uint32 UWheeledVehicleMovementComponentNW::GetSimSetupSourceHash() const
+{
+	uint32 Hash = Super::GetSimSetupSourceHash();
+	Hash = UVehicleSimSetup::HashProperties(FVehicleEngineData::StaticStruct(), &EngineSetup, Hash);
+	Hash = UVehicleSimSetup::HashProperties(FVehicleDifferentialNWData::StaticStruct(), &DifferentialSetup, Hash);
+	return UVehicleSimSetup::HashProperties(FVehicleTransmissionData::StaticStruct(), &TransmissionSetup, Hash);
+}
+
+PRAGMA_ENABLE_DEPRECATION_WARNINGS
@@ -19,6 +19,20 @@ struct PHYSXVEHICLES_API FAnimNode_WheelHandler : public FAnimNode_SkeletalContr
 {
 	GENERATED_USTRUCT_BODY()
 
+	/**
+	 * From this LOD on the wheels are only evaluated every ReducedRateInterval frames and keep their last pose in between.
+	 * INDEX_NONE evaluates every frame at every LOD. Use LODThreshold to skip the wheels entirely
+	 */
+	// 从此 LOD 开始，车轮每 ReducedRateInterval 帧才计算一次，其间保持上次的姿态
+	// INDEX_NONE 表示所有 LOD 都每帧计算。使用 LODThreshold 可完全跳过车轮
+	UPROPERTY(EditAnywhere, Category = Performance, meta = (DisplayName = "Reduced Rate LOD Threshold"))
+	int32 ReducedRateLODThreshold;
+
+	/** Number of frames between wheel evaluations at or beyond ReducedRateLODThreshold */
+	// 在 ReducedRateLODThreshold 及以上时两次车轮计算之间的帧数
+	UPROPERTY(EditAnywhere, Category = Performance, meta = (ClampMin = "1"))
+	int32 ReducedRateInterval;
+
 	FAnimNode_WheelHandler();
 
 	// FAnimNode_Base interface
@@ -40,8 +54,21 @@ private:
 	{
 		int32 WheelIndex;
 		FBoneReference BoneReference;
+
+		// Last evaluation's inputs and result, reused while the input pose and offsets do not change
+		// 上次计算的输入和结果，在输入姿态和偏移不变时复用
+		bool bCacheValid;
+		FRotator CachedRotOffset;
+		FQuat CachedRotQuat;
+		FVector CachedLocOffset;
+		FTransform CachedInputTM;
+		FTransform CachedOutputTM;
 	};
 
+	/** Whether this evaluation can reuse the cached wheel transforms because of the reduced update rate */
+	// 由于降低了更新频率，本次计算是否可以复用缓存的车轮变换
+	bool ShouldSkipEvaluation(const FComponentSpacePoseContext& Output) const;
+
 	TArray<FWheelLookupData> Wheels;
 PRAGMA_DISABLE_DEPRECATION_WARNINGS
 		const FVehicleAnimInstanceProxy* AnimInstanceProxy;	//TODO: we only cache this to use in eval where it's safe. Should change API to pass proxy into eval
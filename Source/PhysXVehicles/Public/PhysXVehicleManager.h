@@ -6,10 +6,19 @@
 #include "WheeledVehicleMovementComponent.h"
 #include "PhysicsPublic.h"
 #include "PhysXIncludes.h"
+#include "PhysXVehicleTelemetry.h"
+#include "PhysXVehicleTelemetryExporter.h"
+#include "VehicleWheelAnimData.h"
 
 class UTireConfig;
 class UWheeledVehicleMovementComponent;
+class UVehicleWheel;
+class ITireModel;
+class UPrimitiveComponent;
 class FPhysScene_PhysX;
+class FPhysXVehicleReplayRecorder;
+class FPhysXVehicleReplayPlayer;
+class FPhysXVehicleWheelInstances;
 
 DECLARE_LOG_CATEGORY_EXTERN(LogVehicles, Log, All);
 
@@ -17,6 +26,37 @@ PRAGMA_DISABLE_DEPRECATION_WARNINGS
 
 #if WITH_PHYSX_VEHICLES
 
+/**
+ * Everything the tire shader reads and writes for one wheel, so PxVehicleUpdates touches no UObject and can run off the game thread.
+ * Owned by the manager, and published to the wheel's Debug members once the update is done
+ */
+// 轮胎着色器对一个车轮读写的全部数据，使 PxVehicleUpdates 不访问任何 UObject，从而可以在游戏线程之外运行
+// 由管理器持有，并在更新完成后发布到车轮的 Debug 成员
+struct FTireShaderWheelData
+{
+	// PhysX tire data of the wheel for the default tire model, owned by the PhysX vehicle
+	// 默认轮胎模型使用的车轮 PhysX 轮胎数据，由 PhysX 车辆持有
+	const PxVehicleTireData*	TireData;
+
+	// Native tire model of the wheel, null for the default tire model
+	// 车轮的原生轮胎模型，默认轮胎模型时为空
+	const ITireModel*			TireModel;
+
+	// Set unless the component cleared bCallGenerateTireForces, the shader then calls into the component for default model wheels
+	// 除非组件清除了 bCallGenerateTireForces，否则会设置此项，此时着色器对默认模型的车轮调用组件
+	UVehicleWheel*				Wheel;
+
+	// Written by the shader on every sub-step
+	// 着色器在每个子步中写入
+	float						LongSlip;
+	float						LatSlip;
+	float						NormalizedTireLoad;
+	float						TireLoad;
+	float						WheelTorque;
+	float						LongForce;
+	float						LatForce;
+};
+
 /**
  * Manages vehicles and tire surface data for all scenes
  */
@@ -54,17 +94,129 @@ public:
 	void RemoveVehicle( TWeakObjectPtr<UWheeledVehicleMovementComponent> Vehicle );
 
 	/**
-	 * Set the vehicle that we want to record telemetry data for
+	 * Leave the creation of a vehicle to PreTick, which commits a limited number of queued vehicles each frame.
+	 * Returns false when creation is not spread over frames, the caller then creates the vehicle right away
 	 */
-	// 设置我们要为其记录遥测数据的车辆
+	// 将车辆的创建交给 PreTick，PreTick 每帧提交有限数量的排队车辆
+	// 如果创建未分摊到多帧，则返回 false，此时由调用者立即创建车辆
+	bool QueueVehicleCreation( TWeakObjectPtr<UWheeledVehicleMovementComponent> Vehicle );
+
+	/**
+	 * Drop a vehicle that is still waiting to be created
+	 */
+	// 移除仍在等待创建的车辆
+	void CancelVehicleCreation( TWeakObjectPtr<UWheeledVehicleMovementComponent> Vehicle );
+
+	/**
+	 * Enable or disable telemetry sampling for a vehicle. Any number of vehicles can record at once
+	 */
+	// 启用或禁用车辆的遥测采样，可以同时为任意数量的车辆记录
 	void SetRecordTelemetry( TWeakObjectPtr<UWheeledVehicleMovementComponent> Vehicle, bool bRecord );
 
 	/**
-	 * Get the updated telemetry data
+	 * Get a vehicle's telemetry history, null if it is not recording
 	 */
-	// 获取更新的遥测数据
-	PxVehicleTelemetryData* GetTelemetryData_AssumesLocked();
+	// 获取车辆的遥测历史记录，如果未在记录则为空
+	const FPhysXVehicleTelemetry* GetTelemetry_AssumesLocked( TWeakObjectPtr<const UWheeledVehicleMovementComponent> Vehicle ) const;
 	
+	/**
+	 * Start streaming every step's inputs and wheel states to a replay file
+	 */
+	// 开始将每一步的输入和车轮状态流式写入重放文件
+	void StartReplayRecording( const FString& Filename );
+
+	/**
+	 * Stop recording and flush the replay file
+	 */
+	// 停止录制并刷新重放文件
+	void StopReplayRecording();
+
+	/**
+	 * Re-feed the inputs of a replay file and diff the resulting wheel states against the recorded ones
+	 */
+	// 重新输入重放文件中的输入，并将产生的车轮状态与录制的状态进行比较
+	void StartReplayPlayback( const FString& Filename );
+
+	/**
+	 * Stop playback and log the divergence and timing report
+	 */
+	// 停止回放并输出偏差和计时报告
+	void StopReplayPlayback();
+
+	/**
+	 * Start streaming per step wheel, engine and gear channels of all vehicles to a file
+	 */
+	// 开始将所有车辆每一步的车轮、引擎和档位通道流式写入文件
+	void StartTelemetryExport( const FString& Filename, EVehicleTelemetryExportFormat Format );
+
+	/**
+	 * Stop the telemetry export and flush the file
+	 */
+	// 停止遥测导出并刷新文件
+	void StopTelemetryExport();
+
+	/**
+	 * Register the heightfield collision of a primitive, such as a landscape tile, for the suspension fast path.
+	 * Raycast vehicles whose wheels all rest on registered heightfields query a scene holding only those tiles instead of the full scene
+	 */
+	// 注册图元的高度场碰撞（例如地形图块），用于悬架快速路径
+	// 所有车轮都位于已注册高度场上的光线投射车辆只查询仅包含这些图块的场景，而不是完整场景
+	void RegisterHeightfield( UPrimitiveComponent* Component );
+
+	/**
+	 * Remove a primitive's heightfield collision from the suspension fast path
+	 */
+	// 从悬架快速路径中移除图元的高度场碰撞
+	void UnregisterHeightfield( UPrimitiveComponent* Component );
+
+	/**
+	 * Time the skeletal and the instanced wheel paths on every vehicle that has an InstancedWheelMesh and log the results
+	 */
+	// 对每辆设置了 InstancedWheelMesh 的车辆计时骨骼车轮路径和实例化车轮路径，并记录结果
+	void BenchmarkWheelVisuals( UWorld* World, int32 Iterations );
+
+	/**
+	 * Time a step of the full PhysX simulation tier against a step of the kinematic LOD tier over the registered vehicles and log
+	 * vehicles per millisecond for each. Both tiers run on copies, the live vehicles are left untouched
+	 */
+	// 对已注册车辆分别计时完整 PhysX 模拟层级和运动学 LOD 层级的一步，并记录各层级每毫秒处理的车辆数
+	// 两个层级都在副本上运行，不触及运行中的车辆
+	void BenchmarkSimulationTiers( int32 Iterations );
+
+	/** Whether the vehicle at VehicleIndex is driven by the kinematic LOD tier instead of PxVehicleUpdates */
+	// VehicleIndex 处的车辆是否由运动学 LOD 层级而不是 PxVehicleUpdates 驱动
+	bool IsUsingKinematicLOD( int32 VehicleIndex ) const { return KinematicLODStates[VehicleIndex].bKinematic; }
+
+	/** Wheels states of the vehicle at VehicleIndex */
+	// VehicleIndex 处车辆的车轮状态
+	PxWheelQueryResult* GetWheelsStates_AssumesLocked( int32 VehicleIndex ) { return PVehiclesWheelsStates[VehicleIndex].wheelQueryResults; }
+
+	/** World transform of a wheel of the vehicle at VehicleIndex from the last bulk wheel update */
+	// VehicleIndex 处车辆的车轮在上次批量车轮更新中的世界变换
+	FTransform GetWheelWorldTransform( int32 VehicleIndex, int32 WheelIdx ) const
+	{
+		const int32 Slot = WheelOffsets[VehicleIndex] + WheelIdx;
+		return FTransform( WheelWorldStates.GetRotation( Slot ), WheelWorldStates.GetLocation( Slot ) );
+	}
+
+	/** Number of wheels of the vehicle at VehicleIndex */
+	// VehicleIndex 处车辆的车轮数量
+	int32 GetNumWheels( int32 VehicleIndex ) const { return GetWheelOffsetEnd( VehicleIndex ) - WheelOffsets[VehicleIndex]; }
+
+	/**
+	 * Packed animation data of the vehicle at VehicleIndex, GetNumWheels() entries published after every PxVehicleUpdates.
+	 * Written and read on the game thread, so it can be copied without a lock
+	 */
+	// VehicleIndex 处车辆的打包动画数据，共 GetNumWheels() 个条目，在每次 PxVehicleUpdates 之后发布
+	// 在游戏线程上读写，因此无需加锁即可复制
+	const FWheelAnimData* GetWheelAnimData( int32 VehicleIndex ) const { return WheelAnimData.GetData() + WheelOffsets[VehicleIndex]; }
+
+	/**
+	 * Point the tire shader of each of the vehicle's wheels at the manager's block, filled from the wheels just initialized
+	 */
+	// 将车辆每个车轮的轮胎着色器指向管理器的数据块，数据块由刚初始化的车轮填充
+	void BindTireShaderData( TWeakObjectPtr<UWheeledVehicleMovementComponent> Vehicle );
+
 	/**
 	 * Get a vehicle's wheels states, such as isInAir, suspJounce, contactPoints, etc
 	 */
@@ -82,6 +234,12 @@ public:
 	// 更新车辆调整和其他状态，例如输入
 	void PreTick(FPhysScene* PhysScene, float DeltaTime);
 
+	/**
+	 * Switch vehicles between skeletal and instanced wheels by view distance and draw the instanced ones, once all actors ticked
+	 */
+	// 在所有 Actor Tick 之后，根据视距在骨骼车轮和实例化车轮之间切换车辆，并绘制实例化车轮
+	void PostActorTick(UWorld* World, ELevelTick TickType, float DeltaTime);
+
 	/** Detach this vehicle manager from a FPhysScene (remove delegates, remove from map etc) */
 	// 从 FPhysScene 中分离该车辆管理器（移除委托、从地图中移除等）
 	void DetachFromPhysScene(FPhysScene* PhysScene);
@@ -94,6 +252,16 @@ public:
 	// 从 FPhysScene 中查找车辆管理器
 	static FPhysXVehicleManager* GetVehicleManagerFromScene(FPhysScene* PhysScene);
 
+	/**
+	 * Build the filter data suspension queries are issued with from a wheel shape's query filter data.
+	 * The suspension channel bit goes in word1 and the collision complexity flags in word2, so the query prefilter is a few ANDs.
+	 * Only the vehicle sim data gets this, the wheel shape keeps its own filter data for regular scene queries
+	 */
+	// 根据车轮形状的查询过滤数据构建悬架查询使用的过滤数据
+	// 悬架通道位存放在 word1，碰撞复杂度标志存放在 word2，因此查询预过滤只需几次按位与
+	// 只有车辆模拟数据使用它，车轮形状仍保留自己的过滤数据用于常规场景查询
+	static PxFilterData PackSuspensionQueryFilterData( const PxFilterData& WheelQueryFilterData );
+
 	/** Gets a transient default TireConfig object */
 	// 获取一个暂时的默认 TireConfig 对象
 	static UTireConfig* GetDefaultTireConfig();
@@ -121,14 +289,186 @@ private:
 	// 所有实例化车辆
 	TArray<TWeakObjectPtr<UWheeledVehicleMovementComponent>>	Vehicles;
 
-	// All instanced PhysX vehicles
-	// 所有实例化的 PhysX 车辆
+	// Vehicles whose physics state was created but whose PhysX vehicle is not set up yet, oldest first
+	// 物理状态已创建但 PhysX 车辆尚未设置的车辆，最早的在前
+	TArray<TWeakObjectPtr<UWheeledVehicleMovementComponent>>	PendingCreations;
+
+	// All instanced PhysX vehicles, sorted into VehiclePartitions like every other array parallel to Vehicles
+	// 所有实例化的 PhysX 车辆，与所有和 Vehicles 平行的数组一样按 VehiclePartitions 排列
 	TArray<PxVehicleWheels*>									PVehicles;
 
+	/** Contiguous run of Vehicles sharing the PhysX vehicle type and wheel count */
+	// Vehicles 中具有相同 PhysX 车辆类型和车轮数量的连续区段
+	struct FVehiclePartition
+	{
+		uint32 Key;
+		int32 First;
+		int32 Num;
+	};
+
+	// Partitions of the arrays parallel to Vehicles in ascending key order, so batched stages see homogeneous runs
+	// 与 Vehicles 平行的数组按键升序划分的分区，使批处理阶段处理的是同类车辆的连续区段
+	TArray<FVehiclePartition>									VehiclePartitions;
+
 	// Store each vehicle's wheels' states like isInAir, suspJounce, contactPoints, etc
 	// 存储每辆车的车轮状态，如 isInAir、suspJounce、contactPoints 等
 	TArray<PxVehicleWheelQueryResult>							PVehiclesWheelsStates;
 
+	// Tire shader data of each vehicle's wheels, parallel to Vehicles. Allocated per vehicle so the pointers PhysX holds stay put
+	// 每辆车车轮的轮胎着色器数据，与 Vehicles 平行。按车辆分配，使 PhysX 持有的指针保持不变
+	TArray<FTireShaderWheelData*>								TireShaderData;
+
+	/**
+	 * World state of every wheel of every vehicle, one entry per wheel in structure of arrays layout.
+	 * Each vehicle's wheels stay together in registration order, vehicles reach theirs through WheelOffsets
+	 */
+	// 每辆车每个车轮的世界状态，每个车轮一个条目，采用数组结构布局
+	// 每辆车的车轮按注册顺序连续存放，车辆通过 WheelOffsets 访问自己的车轮
+	struct FWheelWorldStates
+	{
+		TArray<float> LocationX, LocationY, LocationZ;
+		TArray<float> RotationX, RotationY, RotationZ, RotationW;
+		TArray<float> VelocityX, VelocityY, VelocityZ;
+
+		void AddZeroed( int32 Count );
+		void RemoveAt( int32 Index, int32 Count );
+
+		FVector GetLocation( int32 Idx ) const { return FVector( LocationX[Idx], LocationY[Idx], LocationZ[Idx] ); }
+		FQuat GetRotation( int32 Idx ) const { return FQuat( RotationX[Idx], RotationY[Idx], RotationZ[Idx], RotationW[Idx] ); }
+		FVector GetVelocity( int32 Idx ) const { return FVector( VelocityX[Idx], VelocityY[Idx], VelocityZ[Idx] ); }
+	};
+
+	FWheelWorldStates											WheelWorldStates;
+
+	// Animation data of every wheel of every vehicle, laid out like WheelWorldStates
+	// 每辆车每个车轮的动画数据，布局与 WheelWorldStates 相同
+	TArray<FWheelAnimData>										WheelAnimData;
+
+	// Shape of each entry of WheelWorldStates, its local pose is set by PxVehicleUpdates
+	// WheelWorldStates 中每个条目的形状，其局部姿态由 PxVehicleUpdates 设置
+	TArray<const PxShape*>										WheelShapes;
+
+	// First WheelWorldStates entry of each vehicle, parallel to Vehicles
+	// 每辆车在 WheelWorldStates 中的第一个条目，与 Vehicles 平行
+	TArray<int32>												WheelOffsets;
+
+	// Chassis pose read by the last bulk wheel update, parallel to Vehicles
+	// 上次批量车轮更新读取的底盘姿态，与 Vehicles 平行
+	TArray<PxTransform>											ChassisPoses;
+
+	/** One suspension ray of the kinematic LOD tier, standing in for every wheel within a few cm of the same chassis X */
+	// 运动学 LOD 层级的一条悬架射线，代表底盘 X 坐标相差几厘米以内的所有车轮
+	struct FKinematicLODAxle
+	{
+		// Average wheel centre at rest relative to the centre of mass like PhysX wheel offsets, and the matching wheel radius and suspension travel
+		// 与 PhysX 车轮偏移一样相对于质心的车轮静止平均中心，以及相应的车轮半径和悬架行程
+		PxVec3 LocalCentre;
+		float Radius;
+		float MaxCompression;
+		float MaxDroop;
+	};
+
+	/** Arcade state of a vehicle while the kinematic LOD tier moves it, the chassis pose itself stays on the actor */
+	// 车辆由运动学 LOD 层级移动时的街机状态，底盘姿态本身仍保存在 Actor 上
+	struct FKinematicLODState
+	{
+		// Asked for by the last distance test, applied at the start of the next Update
+		// 上次距离测试请求的层级，在下一次 Update 开始时应用
+		bool bWantsKinematic;
+		bool bKinematic;
+
+		// Carried over from the rigid body when switching in and handed back to it when switching out
+		// 切换进入时从刚体继承，切换退出时交还给刚体
+		float ForwardSpeed;
+		float VerticalSpeed;
+		float YawRate;
+
+		// Drive constants read from the PhysX vehicle when switching in
+		// 切换进入时从 PhysX 车辆读取的驱动常量
+		float DriveAccel;
+		float ReverseAccel;
+		float MaxForwardSpeed;
+		float MaxReverseSpeed;
+		float BrakeDecel;
+		float DragFactor;
+		float MaxSteer;
+		float WheelBase;
+		float SuspensionRate;
+
+		TArray<FKinematicLODAxle, TInlineAllocator<4>> Axles;
+	};
+
+	// Kinematic LOD state of each vehicle, parallel to Vehicles
+	// 每辆车的运动学 LOD 状态，与 Vehicles 平行
+	TArray<FKinematicLODState>									KinematicLODStates;
+
+	// Number of vehicles currently in the kinematic LOD tier
+	// 当前处于运动学 LOD 层级的车辆数
+	int32														NumKinematicVehicles;
+
+	// Vehicles left to PxVehicleUpdates and their wheels states, rebuilt each step while any vehicle is kinematic
+	// 留给 PxVehicleUpdates 的车辆及其车轮状态，在有车辆处于运动学层级时每步重建
+	TArray<PxVehicleWheels*>									FullPVehicles;
+	TArray<PxVehicleWheelQueryResult>							FullPVehiclesWheelsStates;
+
+	// Telemetry history for each vehicle, null for vehicles that are not recording
+	// 每辆车的遥测历史记录，未记录的车辆为空
+	TArray<TUniquePtr<FPhysXVehicleTelemetry>>					VehiclesTelemetry;
+
+	// Number of non null entries in VehiclesTelemetry, sampling is skipped entirely when zero
+	// VehiclesTelemetry 中非空条目的数量，为零时完全跳过采样
+	int32														NumTelemetryVehicles;
+
+	// Vehicles whose suspension uses raycasts, the raycast batch only covers these
+	// 悬架使用光线投射的车辆，光线投射批处理只覆盖这些车辆
+	TArray<PxVehicleWheels*>									RaycastPVehicles;
+
+	// Vehicles whose suspension uses sweeps of the wheel shapes
+	// 悬架使用车轮形状扫描的车辆
+	TArray<PxVehicleWheels*>									SweepPVehicles;
+
+	/** Chassis pose at a vehicle's last suspension query, used to skip queries while it barely moves */
+	// 车辆上次悬架查询时的底盘姿态，用于在车辆几乎不动时跳过查询
+	struct FSuspensionQueryCoherence
+	{
+		PxTransform LastQueryPose;
+
+		// Consecutive steps the cached hit planes have been reused
+		// 连续复用缓存命中平面的步数
+		int32 NumReuses;
+
+		// The vehicle's wheels states, read back to tell whether every wheel touched a registered heightfield
+		// 车辆的车轮状态，回读以判断是否每个车轮都接触了已注册的高度场
+		const PxWheelQueryResult* WheelsStates;
+		PxU32 NumWheels;
+
+		// Every wheel touched a registered heightfield at the last query
+		// 上次查询时每个车轮都接触了已注册的高度场
+		bool bOnHeightfield;
+
+		// Consecutive queries that went through the heightfield scene
+		// 连续通过高度场场景进行的查询次数
+		int32 NumHeightfieldQueries;
+	};
+
+	// Coherence state and per step query mask, parallel to RaycastPVehicles
+	// 一致性状态和每步查询掩码，与 RaycastPVehicles 平行
+	TArray<FSuspensionQueryCoherence>							RaycastCoherence;
+	TArray<bool>												RaycastQueryMask;
+
+	// Raycast vehicles queried against the heightfield scene this step, parallel to RaycastPVehicles
+	// 本步针对高度场场景查询的光线投射车辆，与 RaycastPVehicles 平行
+	TArray<bool>												HeightfieldQueryMask;
+
+	// The vehicles set in HeightfieldQueryMask. They get their own raycast call, since PhysX resets the results of every vehicle a call masks out
+	// HeightfieldQueryMask 中标记的车辆。它们单独调用一次光线投射，因为 PhysX 会重置调用中被掩码排除的每辆车的结果
+	TArray<PxVehicleWheels*>									HeightfieldPVehicles;
+
+	// Coherence state and per step query mask, parallel to SweepPVehicles
+	// 一致性状态和每步查询掩码，与 SweepPVehicles 平行
+	TArray<FSuspensionQueryCoherence>							SweepCoherence;
+	TArray<bool>												SweepQueryMask;
+
 	// Scene query results for each wheel for each vehicle
 	// 每辆车每个车轮的场景查询结果
 	TArray<PxRaycastQueryResult>								WheelQueryResults;
@@ -141,9 +481,136 @@ private:
 	// 车轮悬架光线投射的批量查询
 	PxBatchQuery*												WheelRaycastBatchQuery;
 
+	// Scene sweep results for each wheel of each sweeping vehicle
+	// 每辆扫描车辆每个车轮的场景扫描结果
+	TArray<PxSweepQueryResult>									WheelSweepResults;
+
+	// Scene sweep hits, SweepHitsPerWheel for each wheel of each sweeping vehicle
+	// 场景扫描命中，每辆扫描车辆的每个车轮有 SweepHitsPerWheel 个
+	TArray<PxSweepHit>											WheelSweepHits;
+
+	// Batch query for the wheel suspension sweeps
+	// 车轮悬架扫描的批量查询
+	PxBatchQuery*												WheelSweepBatchQuery;
+
+	// Number of hits reported per wheel sweep, PhysX keeps the best one
+	// 每个车轮扫描报告的命中数，PhysX 会保留最佳的一个
+	int32														SweepHitsPerWheel;
+
+	/** A registered heightfield and its copy in the heightfield scene */
+	// 已注册的高度场及其在高度场场景中的副本
+	struct FHeightfieldTile
+	{
+		TWeakObjectPtr<UPrimitiveComponent> Component;
+
+		PxRigidStatic* ProxyActor;
+
+		// Heightfield shapes of both the source actor and the proxy
+		// 源 Actor 和代理的高度场形状
+		TArray<const PxShape*> Shapes;
+	};
+
+	// Registered heightfields
+	// 已注册的高度场
+	TArray<FHeightfieldTile>									HeightfieldTiles;
+
+	// Every shape of HeightfieldTiles, a tire contact on any of them keeps a wheel on the fast path
+	// HeightfieldTiles 的所有形状，轮胎接触其中任何一个都能让车轮保持在快速路径上
+	TSet<const PxShape*>										HeightfieldShapes;
+
+	// Query only scene holding copies of the registered heightfields, never simulated
+	// 仅用于查询的场景，包含已注册高度场的副本，从不模拟
+	PxScene*													HeightfieldScene;
+	PxDefaultCpuDispatcher*										HeightfieldSceneDispatcher;
+
+	// Scene query results and hits of the heightfield raycasts, sized like WheelQueryResults
+	// 高度场光线投射的场景查询结果和命中，大小与 WheelQueryResults 相同
+	TArray<PxRaycastQueryResult>								HeightfieldQueryResults;
+	TArray<PxRaycastHit>										HeightfieldHitResults;
+
+	// Batch query for the suspension raycasts against the heightfield scene
+	// 针对高度场场景的悬架光线投射批量查询
+	PxBatchQuery*												HeightfieldBatchQuery;
+
+	// Input packets of the locally controlled vehicles, rebuilt every PreTick
+	// 本地控制车辆的输入数据包，每次 PreTick 时重建
+	TArray<FVehicleInputPacket>									InputPackets;
+	TArray<UWheeledVehicleMovementComponent*>					InputPacketVehicles;
+
+	// Active replay recording, if any
+	// 当前进行中的重放录制（如果有）
+	TUniquePtr<FPhysXVehicleReplayRecorder>						ReplayRecorder;
+
+	// Active replay playback, if any
+	// 当前进行中的重放回放（如果有）
+	TUniquePtr<FPhysXVehicleReplayPlayer>						ReplayPlayer;
+
+	// Active telemetry export, if any
+	// 当前进行中的遥测导出（如果有）
+	TUniquePtr<FPhysXVehicleTelemetryExporter>					TelemetryExporter;
+
+	// Instanced wheels of the vehicles beyond their InstancedWheelsDistance, created with the first one
+	// 超出 InstancedWheelsDistance 的车辆的实例化车轮，随第一辆此类车辆创建
+	TUniquePtr<FPhysXVehicleWheelInstances>						InstancedWheels;
+
+	// Vehicles drawing instanced wheels this frame
+	// 本帧绘制实例化车轮的车辆
+	TArray<int32>												InstancedWheelVehicles;
+
 	FDelegateHandle OnPhysScenePreTickHandle;
 	FDelegateHandle OnPhysSceneStepHandle;
+	FDelegateHandle OnWorldPostActorTickHandle;
+	FDelegateHandle OnComponentDestroyPhysicsHandle;
+
+	/** Drop the heightfield tile of a component whose physics state goes away, such as a streamed out landscape */
+	// 移除物理状态即将销毁的组件的高度场图块，例如被流式卸载的地形
+	void OnComponentDestroyPhysicsState( UActorComponent* Component );
+
+	/**
+	 * Fill the instanced wheels with the current wheel transforms of Indices' vehicles, composed from the wheel state snapshot
+	 * and the chassis pose the scene just simulated
+	 */
+	// 使用 Indices 中车辆的当前车轮变换填充实例化车轮，由车轮状态快照与场景刚模拟出的底盘姿态组合而成
+	void WriteInstancedWheels( UWorld* World, const TArray<int32>& Indices );
+
+
+	/**
+	 * Ask each vehicle with a KinematicLODDistance for the kinematic LOD tier when it is farther than that from every view
+	 */
+	// 当设置了 KinematicLODDistance 的车辆与所有视点的距离都超过该值时，请求其进入运动学 LOD 层级
+	void UpdateKinematicLODRequests( const TArray<FVector, TInlineAllocator<4>>& ViewLocations );
 
+	/**
+	 * Move the vehicles whose requested tier changed between PxVehicleUpdates and the kinematic LOD tier, keeping pose and speed
+	 */
+	// 将请求层级发生变化的车辆在 PxVehicleUpdates 和运动学 LOD 层级之间切换，保持姿态和速度
+	void ApplyKinematicLODRequests();
+
+	/** Read the speed and drive constants of the vehicle at VehicleIndex into State */
+	// 将 VehicleIndex 处车辆的速度和驱动常量读入 State
+	void InitKinematicLODState_AssumesLocked( int32 VehicleIndex, FKinematicLODState& State ) const;
+
+	/**
+	 * Advance one vehicle of the kinematic LOD tier: arcade longitudinal and yaw model, one raycast per axle filtered like the
+	 * suspension queries and an analytic suspension settling height and pitch. Returns the new chassis pose
+	 */
+	// 推进运动学 LOD 层级中的一辆车：街机式纵向与偏航模型，每个车轴进行一次与悬架查询相同过滤的光线投射，
+	// 解析悬架调整高度和俯仰，返回新的底盘姿态
+	PxTransform StepKinematicLOD_AssumesLocked( int32 VehicleIndex, FKinematicLODState& State, float DeltaTime ) const;
+
+	/**
+	 * Copy the PhysX vehicle at VehicleIndex, its actor, drive and wheel state into DestScene for benchmarking. The clone's tire
+	 * shader data is allocated into OutTireShaderData, free it with delete[] once the clone is freed
+	 */
+	// 将 VehicleIndex 处的 PhysX 车辆及其 Actor、驱动和车轮状态复制到 DestScene 中用于基准测试。克隆的轮胎着色器数据
+	// 分配到 OutTireShaderData 中，在克隆释放后用 delete[] 释放
+	PxVehicleWheels* CloneVehicle_AssumesLocked( int32 VehicleIndex, PxScene& DestScene, FTireShaderWheelData*& OutTireShaderData ) const;
+
+	/**
+	 * Step every vehicle of the kinematic LOD tier and set its kinematic target, the caller holds the scene write lock
+	 */
+	// 推进运动学 LOD 层级中的每辆车并设置其运动学目标，调用者持有场景写锁
+	void UpdateKinematicVehicles_AssumesLocked( float DeltaTime );
 
 	/**
 	 * Refresh the tire friction pairs
@@ -152,42 +619,113 @@ private:
 	void UpdateTireFrictionTableInternal();
 
 	/**
-	 * Reallocate the WheelRaycastBatchQuery if our number of wheels has increased
+	 * Reallocate the WheelRaycastBatchQuery or WheelSweepBatchQuery if our number of wheels has increased
 	 */
-	// 如果我们的车轮数量增加，则重新分配 WheelRaycastBatchQuery
+	// 如果我们的车轮数量增加，则重新分配 WheelRaycastBatchQuery 或 WheelSweepBatchQuery
 	void SetUpBatchedSceneQuery();
 
 	/**
-	 * Update all vehicles without telemetry
+	 * Fill the query mask: a vehicle is queried unless its chassis moved less than the reuse thresholds since its last query
+	 * and the cached hit planes are not too old. Returns the number of vehicles to query
 	 */
-	// 在没有遥测的情况下更新所有车辆
-	void UpdateVehicles( float DeltaTime );
+	// 填充查询掩码：除非车辆底盘自上次查询以来的移动小于复用阈值且缓存的命中平面不太旧，否则查询该车辆
+	// 返回需要查询的车辆数
+	int32 BuildSuspensionQueryMask_AssumesLocked( const TArray<PxVehicleWheels*>& QueryPVehicles, TArray<FSuspensionQueryCoherence>& Coherence, TArray<bool>& QueryMask );
 
 	/**
-	 * Get the gravity for our phys scene
+	 * Move the queried raycast vehicles that rested only on registered heightfields at their last query to the heightfield mask.
+	 * Every few queries they go through the full scene again, so other geometry under the wheels is noticed. Returns the number moved
 	 */
-	// 获取我们物理场景的重力
-	PxVec3 GetSceneGravity_AssumesLocked();
+	// 将上次查询时只停在已注册高度场上的待查询光线投射车辆移到高度场掩码
+	// 每隔几次查询它们会重新查询完整场景，以便发现车轮下的其他几何体，返回移动的车辆数
+	int32 BuildHeightfieldQueryMask();
 
-#if PX_DEBUG_VEHICLE_ON
+	/**
+	 * Record whether the wheels of each raycast vehicle queried this step all touched a registered heightfield
+	 */
+	// 记录本步查询的每辆光线投射车辆的车轮是否都接触了已注册的高度场
+	void UpdateHeightfieldContacts();
 
-	PxVehicleTelemetryData*				TelemetryData4W;
+	/**
+	 * Reallocate the HeightfieldBatchQuery if the raycast wheel count has grown or the scene was just created
+	 */
+	// 如果光线投射车轮数量增加或场景刚刚创建，则重新分配 HeightfieldBatchQuery
+	void SetUpHeightfieldSceneQuery();
 
-	PxVehicleWheels*					TelemetryVehicle;
+	/**
+	 * Read the chassis pose of vehicles [FirstVehicle, EndVehicle) once and derive all their wheels' world transforms and velocities
+	 */
+	// 为车辆 [FirstVehicle, EndVehicle) 读取一次底盘姿态，并推导出其所有车轮的世界变换和速度
+	void UpdateWheelWorldStates_AssumesLocked( int32 FirstVehicle, int32 EndVehicle, float DeltaTime );
+
+	/**
+	 * Publish every wheel's rotation, steer angle and suspension offset for the anim instance proxies
+	 */
+	// 为动画实例代理发布每个车轮的旋转、转向角和悬挂偏移
+	void UpdateWheelAnimData_AssumesLocked();
 
 	/**
-	 * Init telemetry data
+	 * Copy what the tire shader wrote during the last PxVehicleUpdates into the wheels' Debug members, on the game thread
 	 */
-	// 初始化遥测数据
-	void SetupTelemetryData();
+	// 在游戏线程上将轮胎着色器在上次 PxVehicleUpdates 中写入的数据复制到车轮的 Debug 成员
+	void PublishTireShaderData();
 
 	/**
-	 * Update the telemetry vehicle and then all other vehicles
+	 * Set up as many queued vehicles as p.Vehicle.MaxCreationsPerFrame allows
 	 */
-	// 更新遥测车辆，然后更新所有其他车辆
-	void UpdateVehiclesWithTelemetry( float DeltaTime );
+	// 按 p.Vehicle.MaxCreationsPerFrame 允许的数量设置排队的车辆
+	void CommitPendingCreations();
 
-#endif //PX_DEBUG_VEHICLE_ON
+	/** One past the last WheelWorldStates entry of a vehicle */
+	// 车辆在 WheelWorldStates 中最后一个条目的下一个位置
+	int32 GetWheelOffsetEnd( int32 VehicleIdx ) const
+	{
+		return WheelOffsets[VehicleIdx] + (int32)PVehiclesWheelsStates[VehicleIdx].nbWheelQueryResults;
+	}
+
+	/** Partition key of a vehicle, the PhysX vehicle type then the wheel count */
+	// 车辆的分区键，先按 PhysX 车辆类型，再按车轮数量
+	static uint32 GetPartitionKey( const PxVehicleWheels* PVehicle );
+
+	/** Swap two vehicles in every array parallel to Vehicles */
+	// 在所有与 Vehicles 平行的数组中交换两辆车
+	void SwapVehicleSlots( int32 A, int32 B );
+
+	/**
+	 * Move the vehicle just appended to Vehicles to the end of its partition, one swap per later partition
+	 */
+	// 将刚追加到 Vehicles 的车辆移动到其分区末尾，每个后续分区交换一次
+	void InsertIntoPartition( int32 VehicleIdx );
+
+	/**
+	 * Swap a vehicle out to the end of the arrays parallel to Vehicles, one swap per partition from its own onwards, so it can be popped
+	 */
+	// 将车辆交换到与 Vehicles 平行的数组末尾以便弹出，从其所在分区起每个分区交换一次
+	void RemoveFromPartition( int32 VehicleIdx );
+
+	/**
+	 * Update the wheel world states in parallel batches, then tick every vehicle on the game thread under one write lock
+	 */
+	// 以并行批次更新车轮世界状态，然后在游戏线程上于一次写锁下 Tick 每辆车
+	void TickVehiclesParallel( float DeltaTime );
+
+	/**
+	 * Update all vehicles in one batch, then sample and export telemetry if enabled
+	 */
+	// 批量更新所有车辆，如果启用则随后采样并导出遥测
+	void UpdateVehicles( float DeltaTime );
+
+	/**
+	 * Get the gravity for our phys scene
+	 */
+	// 获取我们物理场景的重力
+	PxVec3 GetSceneGravity_AssumesLocked();
+
+	/**
+	 * Push the latest wheel states of every recording vehicle into its telemetry history
+	 */
+	// 将每辆正在记录的车辆的最新车轮状态推入其遥测历史记录
+	void SampleTelemetry_AssumesLocked();
 };
 
 #endif // WITH_PHYSX
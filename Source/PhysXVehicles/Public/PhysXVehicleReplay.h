@@ -0,0 +1,228 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "WheeledVehicleMovementComponent.h"
+#include "PhysicsPublic.h"
+#include "PhysXIncludes.h"
+
+class FPhysXVehicleAsyncWriter;
+
+PRAGMA_DISABLE_DEPRECATION_WARNINGS
+
+#if WITH_PHYSX_VEHICLES
+
+/**
+ * Wheel state stored in a vehicle replay
+ */
+// 车辆重放中存储的车轮状态
+struct FPhysXVehicleReplayWheel
+{
+	float SuspJounce;
+	float SuspSpringForce;
+	float TireFriction;
+	float LongSlip;
+	float LatSlip;
+	float SteerAngle;
+	float RotationSpeed;
+	bool bInAir;
+
+	friend FArchive& operator<<(FArchive& Ar, FPhysXVehicleReplayWheel& Wheel);
+};
+
+/**
+ * Chassis and spin state of a vehicle when the recording first saw it, restored when playback first matches it
+ */
+// 录制首次看到车辆时的底盘和旋转状态，回放首次匹配到该车辆时恢复
+struct FPhysXVehicleReplayInitialState
+{
+	FVector ChassisLocation;
+	FQuat ChassisRotation;
+	FVector LinearVelocity;
+	FVector AngularVelocity;
+	float EngineRotationSpeed;
+	TArray<float> WheelRotationSpeeds;
+
+	friend FArchive& operator<<(FArchive& Ar, FPhysXVehicleReplayInitialState& InitialState);
+};
+
+/**
+ * Smoothed inputs and resulting wheel states of one vehicle for one step
+ */
+// 一辆车在一个步骤中的平滑输入和由此产生的车轮状态
+struct FPhysXVehicleReplayVehicle
+{
+	// Hash of the component path name, used to match vehicles on playback
+	// 组件路径名的哈希值，用于在回放时匹配车辆
+	uint32 VehicleId;
+
+	float SteeringInput;
+	float ThrottleInput;
+	float BrakeInput;
+	float HandbrakeInput;
+	int32 TargetGear;
+
+	// Direct track thrust of tracked vehicles, zero otherwise
+	// 履带车辆直接设置的履带推力，其他车辆为零
+	float LeftThrustInput;
+	float RightThrustInput;
+
+	// Only stored in the first frame a vehicle appears in
+	// 仅在车辆首次出现的帧中存储
+	bool bHasInitialState;
+	FPhysXVehicleReplayInitialState InitialState;
+
+	TArray<FPhysXVehicleReplayWheel> Wheels;
+
+	friend FArchive& operator<<(FArchive& Ar, FPhysXVehicleReplayVehicle& Vehicle);
+};
+
+/**
+ * One vehicle manager step
+ */
+// 车辆管理器的一个步骤
+struct FPhysXVehicleReplayFrame
+{
+	uint32 FrameNumber;
+	float DeltaTime;
+	TArray<FPhysXVehicleReplayVehicle> Vehicles;
+
+	friend FArchive& operator<<(FArchive& Ar, FPhysXVehicleReplayFrame& Frame);
+};
+
+/**
+ * Streams each vehicle manager step to a compact binary file.
+ * Frames are serialized on the simulating thread and written to disk by a background thread with a bounded number of blocks.
+ */
+// 将车辆管理器的每个步骤流式写入紧凑的二进制文件
+// 帧在模拟线程上序列化，并由块数量有限的后台线程写入磁盘
+class PHYSXVEHICLES_API FPhysXVehicleReplayRecorder
+{
+public:
+
+	explicit FPhysXVehicleReplayRecorder(const FString& Filename);
+	~FPhysXVehicleReplayRecorder();
+
+	/** True if the replay file could be created */
+	// 如果可以创建重放文件，则为真
+	bool IsRecording() const;
+
+	/** Capture the delta time and the smoothed inputs about to be passed to the simulation, plus the initial state of vehicles seen for the first time */
+	// 捕获增量时间以及即将传递给模拟的平滑输入，以及首次出现的车辆的初始状态
+	void RecordInputs_AssumesLocked(float DeltaTime, const TArray<TWeakObjectPtr<UWheeledVehicleMovementComponent>>& Vehicles);
+
+	/** Capture the wheel states produced by the simulation and queue the frame for writing */
+	// 捕获模拟产生的车轮状态并将帧排队以写入
+	void RecordOutputs_AssumesLocked(const TArray<PxVehicleWheels*>& PVehicles, const TArray<PxVehicleWheelQueryResult>& PVehiclesWheelsStates);
+
+private:
+
+	TUniquePtr<FPhysXVehicleAsyncWriter>	Writer;
+
+	// Frame being assembled for the current step
+	// 当前步骤正在组装的帧
+	FPhysXVehicleReplayFrame				Frame;
+
+	// Reused serialization buffer
+	// 复用的序列化缓冲区
+	TArray<uint8>							FrameBuffer;
+
+	// Vehicle ids are derived from path names, cache them so we only build the string once per vehicle
+	// 车辆 id 来自路径名，缓存它们以便每辆车只构建一次字符串
+	TMap<TWeakObjectPtr<UWheeledVehicleMovementComponent>, uint32>	VehicleIds;
+
+	// Vehicles whose initial state is already in the file
+	// 初始状态已写入文件的车辆
+	TSet<uint32>							RecordedInitialStates;
+
+	// Writer drop count when RecordedInitialStates was last trusted, any drop since may have taken initial states with it
+	// 上次信任 RecordedInitialStates 时写入器的丢弃计数，此后的任何丢弃都可能带走了初始状态
+	int32									NumDroppedBlocks;
+
+	uint32									NextFrameNumber;
+};
+
+/**
+ * Re-feeds the inputs of a recorded replay and compares the simulated wheel states against the recorded ones frame by frame.
+ * Also times the vehicle pipeline so a recorded session can be used as a benchmark workload.
+ * Each vehicle starts from its recorded chassis pose, velocities and wheel spin, and PxVehicleUpdates steps with the recorded
+ * delta time. The rest of the scene still steps with the frame's own delta time, so playback is approximate unless both sessions
+ * run with the same fixed time step (-UseFixedTimeStep -FPS=N).
+ */
+// 重新输入录制重放中的输入，并逐帧将模拟的车轮状态与录制的状态进行比较
+// 同时对车辆管线计时，使录制的会话可以用作基准测试负载
+// 每辆车从录制的底盘姿态、速度和车轮旋转开始，PxVehicleUpdates 使用录制的增量时间步进。场景其余部分仍使用当前帧自身的增量时间，
+// 因此除非两次会话都以相同的固定时间步长运行（-UseFixedTimeStep -FPS=N），回放只是近似的
+class PHYSXVEHICLES_API FPhysXVehicleReplayPlayer
+{
+public:
+
+	explicit FPhysXVehicleReplayPlayer(const FString& Filename);
+
+	/** True if the replay loaded and has frames left to play */
+	// 如果重放已加载且还有剩余帧要播放，则为真
+	bool IsPlaying() const { return CurrentFrame < Frames.Num(); }
+
+	/** Apply the recorded inputs of the next frame to the matching vehicles, restore newly matched ones, and return the recorded delta time */
+	// 将下一帧录制的输入应用于匹配的车辆，恢复新匹配车辆的状态，并返回录制的增量时间
+	float ApplyInputs_AssumesLocked(float DeltaTime, const TArray<TWeakObjectPtr<UWheeledVehicleMovementComponent>>& Vehicles);
+
+	/** Diff the simulated wheel states against the recorded ones and advance to the next frame */
+	// 将模拟的车轮状态与录制的状态进行比较，并前进到下一帧
+	void CompareOutputs_AssumesLocked(const TArray<TWeakObjectPtr<UWheeledVehicleMovementComponent>>& Vehicles, const TArray<PxVehicleWheels*>& PVehicles, const TArray<PxVehicleWheelQueryResult>& PVehiclesWheelsStates);
+
+	/** Print divergence and timing results */
+	// 打印偏差和计时结果
+	void LogReport() const;
+
+	/** Largest per-channel wheel state difference seen so far */
+	// 到目前为止看到的最大单通道车轮状态差异
+	float GetMaxError() const { return MaxError; }
+
+	/** Number of frames with a difference above the tolerance */
+	// 差异超过容差的帧数
+	int32 GetNumDivergedFrames() const { return NumDivergedFrames; }
+
+private:
+
+	FString									Filename;
+
+	TArray<FPhysXVehicleReplayFrame>		Frames;
+
+	int32									CurrentFrame;
+
+	TMap<TWeakObjectPtr<UWheeledVehicleMovementComponent>, uint32>	VehicleIds;
+
+	// Vehicles whose recorded initial state was already restored
+	// 已恢复录制初始状态的车辆
+	TSet<uint32>							RestoredVehicles;
+
+	// Index into the manager's vehicles for each vehicle of the current frame, INDEX_NONE if unmatched
+	// 当前帧中每辆车在管理器车辆数组中的索引，未匹配时为 INDEX_NONE
+	TArray<int32>							FrameVehicleIndices;
+
+	// Vehicles in the recorded frame that had no match in the scene
+	// 录制帧中在场景里没有匹配的车辆
+	int32									NumUnmatchedVehicles;
+
+	// Recorded frame numbers that are missing from the file (dropped while recording)
+	// 文件中缺失的录制帧编号（录制时被丢弃）
+	int32									NumMissingFrames;
+
+	int32									NumDivergedFrames;
+
+	int32									FirstDivergedFrame;
+
+	float									MaxError;
+
+	double									FrameStartTime;
+
+	double									TotalSimulationTime;
+
+	double									MaxFrameSimulationTime;
+};
+
+#endif // WITH_PHYSX_VEHICLES
+
+PRAGMA_ENABLE_DEPRECATION_WARNINGS
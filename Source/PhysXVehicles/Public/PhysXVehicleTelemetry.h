@@ -0,0 +1,92 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "PhysicsPublic.h"
+#include "PhysXIncludes.h"
+
+class UVehicleWheel;
+
+PRAGMA_DISABLE_DEPRECATION_WARNINGS
+
+#if WITH_PHYSX_VEHICLES
+
+/**
+ * Per wheel values captured by vehicle telemetry
+ */
+// 车辆遥测捕获的每个车轮的值
+enum class EVehicleTelemetryChannel : uint8
+{
+	SuspJounce,
+	SuspForce,
+	TireLoad,
+	NormalizedTireLoad,
+	WheelOmega,
+	TireFriction,
+	LongSlip,
+	NormLongForce,
+	LatSlip,
+	NormLatForce,
+	Num
+};
+
+/**
+ * Fixed size history of wheel values for one vehicle, any number of wheels.
+ * Sampled by the vehicle manager right after the batched vehicle update, the oldest sample is overwritten once the buffer is full.
+ */
+// 一辆车的车轮值的固定大小历史记录，车轮数量不限
+// 由车辆管理器在批量车辆更新之后立即采样，缓冲区满后覆盖最旧的样本
+class PHYSXVEHICLES_API FPhysXVehicleTelemetry
+{
+public:
+
+	enum { MaxSamples = 256 };
+
+	explicit FPhysXVehicleTelemetry(int32 InNumWheels);
+
+	/** Push the wheel states produced by the last update into the ring buffers */
+	// 将上次更新产生的车轮状态推入环形缓冲区
+	void Sample_AssumesLocked(const PxVehicleWheels* PVehicle, const PxVehicleWheelQueryResult& WheelsStates, const TArray<UVehicleWheel*>& Wheels);
+
+	int32 GetNumWheels() const { return NumWheels; }
+
+	/** Number of valid samples, up to MaxSamples */
+	// 有效样本数，最多 MaxSamples
+	int32 GetNumSamples() const { return NumSamples; }
+
+	/** Get a sample, SampleIdx 0 is the oldest valid sample and GetNumSamples() - 1 the newest */
+	// 获取一个样本，SampleIdx 0 是最旧的有效样本，GetNumSamples() - 1 是最新的
+	float GetSample(int32 WheelIdx, EVehicleTelemetryChannel Channel, int32 SampleIdx) const
+	{
+		const int32 RingIdx = (Head + MaxSamples - NumSamples + SampleIdx) % MaxSamples;
+		return Samples[GetChannelOffset(WheelIdx, Channel) + RingIdx];
+	}
+
+	/** Display name of a channel */
+	// 通道的显示名称
+	static const TCHAR* GetChannelName(EVehicleTelemetryChannel Channel);
+
+private:
+
+	int32 GetChannelOffset(int32 WheelIdx, EVehicleTelemetryChannel Channel) const
+	{
+		return (WheelIdx * (int32)EVehicleTelemetryChannel::Num + (int32)Channel) * MaxSamples;
+	}
+
+	int32								NumWheels;
+
+	// Next sample slot to write
+	// 下一个要写入的样本槽
+	int32								Head;
+
+	int32								NumSamples;
+
+	// [Wheel][Channel][Sample], each channel history is contiguous so graphs read linearly
+	// [车轮][通道][样本]，每个通道的历史记录是连续的，因此图表可以线性读取
+	TArray<float>						Samples;
+};
+
+#endif // WITH_PHYSX_VEHICLES
+
+PRAGMA_ENABLE_DEPRECATION_WARNINGS
@@ -0,0 +1,135 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "PhysicsPublic.h"
+#include "PhysXIncludes.h"
+
+class FPhysXVehicleAsyncWriter;
+class UWheeledVehicleMovementComponent;
+
+PRAGMA_DISABLE_DEPRECATION_WARNINGS
+
+#if WITH_PHYSX_VEHICLES
+
+enum class EVehicleTelemetryExportFormat : uint8
+{
+	// Text, one row per wheel per step
+	// 文本，每步每个车轮一行
+	Csv,
+
+	// Binary row groups, each column stored contiguously
+	// 二进制行组，每列连续存储
+	Columnar,
+};
+
+/**
+ * Streams per step wheel, engine and gear channels of every vehicle to a file for offline analysis.
+ * Rows are formatted on the simulating thread and handed to a background writer through a small set of preallocated blocks,
+ * so long soak tests do not grow memory or cause frame spikes.
+ *
+ * Columnar layout: header ('PXVT', version, column count, then type and name of each column) followed by records.
+ * A record starts with a type byte: a row group (row count, then every column as a contiguous array of 4 byte values)
+ * or a surface entry (surface id and physical material name). Surface entries are never dropped and precede the row groups
+ * that reference them. Row groups are sized to fit one writer block.
+ */
+// 将每辆车每步的车轮、引擎和档位通道流式写入文件，以便离线分析
+// 行在模拟线程上格式化，并通过一小组预分配的块交给后台写入线程，
+// 因此长时间的浸泡测试不会导致内存增长或帧峰值
+//
+// 列式布局：文件头（'PXVT'、版本、列数，然后是每列的类型和名称），随后是记录
+// 每条记录以类型字节开头：行组（行数，然后每列为连续的 4 字节值数组）
+// 或表面条目（表面 id 和物理材质名称）。表面条目永远不会被丢弃，并且位于引用它们的行组之前。行组大小以能放入一个写入块为准
+class PHYSXVEHICLES_API FPhysXVehicleTelemetryExporter
+{
+public:
+
+	FPhysXVehicleTelemetryExporter(const FString& Filename, EVehicleTelemetryExportFormat InFormat);
+	~FPhysXVehicleTelemetryExporter();
+
+	/** True if the export file could be created */
+	// 如果可以创建导出文件，则为真
+	bool IsExporting() const;
+
+	/** Cache the id of a vehicle, on the game thread when the vehicle is added or the export starts */
+	// 缓存车辆的 id，在添加车辆或开始导出时于游戏线程上调用
+	void RegisterVehicle(UWheeledVehicleMovementComponent* Vehicle);
+
+	/** Name every PhysX material, on the game thread outside the scene lock when the export starts or the materials change */
+	// 为每个 PhysX 材质命名，在开始导出或材质变化时于游戏线程上、场景锁之外调用
+	void RegisterSurfaces();
+
+	/** Append one row per wheel of every vehicle for the step that just finished */
+	// 为刚刚完成的步骤中每辆车的每个车轮追加一行
+	void Export_AssumesLocked(float DeltaTime, const TArray<TWeakObjectPtr<UWheeledVehicleMovementComponent>>& Vehicles, const TArray<PxVehicleWheels*>& PVehicles, const TArray<PxVehicleWheelQueryResult>& PVehiclesWheelsStates);
+
+private:
+
+	union FValue
+	{
+		float Float;
+		int32 Int;
+		uint32 UInt;
+	};
+
+	enum EColumn
+	{
+		Column_Step,
+		Column_Time,
+		Column_Vehicle,
+		Column_Wheel,
+		Column_Jounce,
+		Column_SuspForce,
+		Column_TireLoad,
+		Column_LongSlip,
+		Column_LatSlip,
+		Column_Omega,
+		Column_Friction,
+		Column_Surface,
+		Column_EngineRPM,
+		Column_Gear,
+		Column_Num
+	};
+
+	void WriteHeader();
+
+	void AddRow(const FValue (&Row)[Column_Num]);
+
+	void WriteRowGroup();
+
+	int32 AddSurface(const PxMaterial* Surface, const FString& SurfaceName);
+
+	int32 GetSurfaceId(const PxMaterial* Surface);
+
+	TUniquePtr<FPhysXVehicleAsyncWriter>	Writer;
+
+	EVehicleTelemetryExportFormat			Format;
+
+	// Columnar: rows buffered column by column until a row group is full
+	// 列式：按列缓冲行，直到行组已满
+	TArray<FValue>							Columns[Column_Num];
+
+	// Rows of a row group that fit in one writer block
+	// 一个写入块能容纳的行组行数
+	int32									MaxRowGroupRows;
+
+	// Reused formatting buffer for a step (Csv) or a row group (Columnar)
+	// 一个步骤（Csv）或一个行组（列式）复用的格式化缓冲区
+	TArray<uint8>							Buffer;
+
+	// Surface ids by PhysX material and their names, ids are stable for the whole file
+	// 按 PhysX 材质索引的表面 id 及其名称，id 在整个文件中保持稳定
+	TMap<const PxMaterial*, int32>			SurfaceIds;
+	TArray<FString>							SurfaceNames;
+
+	TMap<TWeakObjectPtr<UWheeledVehicleMovementComponent>, uint32>	VehicleIds;
+
+	uint32									StepNumber;
+
+	double									Time;
+};
+
+#endif // WITH_PHYSX_VEHICLES
+
+PRAGMA_ENABLE_DEPRECATION_WARNINGS
@@ -0,0 +1,73 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/WeakObjectPtr.h"
+
+class AActor;
+class UWorld;
+class UStaticMesh;
+class UInstancedStaticMeshComponent;
+
+PRAGMA_DISABLE_DEPRECATION_WARNINGS
+
+#if WITH_PHYSX_VEHICLES
+
+/**
+ * World wide instanced static meshes drawing the wheels of distant vehicles, one component per wheel mesh.
+ * The vehicle manager refills the transforms every frame between BeginUpdate and EndUpdate, so the skeletal meshes of those
+ * vehicles can skip their wheel bones and their animation entirely.
+ */
+// 绘制远处车辆车轮的全局实例化静态网格体，每种车轮网格体一个组件
+// 车辆管理器每帧在 BeginUpdate 和 EndUpdate 之间重新填充变换，
+// 因此这些车辆的骨骼网格体可以完全跳过车轮骨骼及其动画
+class PHYSXVEHICLES_API FPhysXVehicleWheelInstances
+{
+public:
+
+	FPhysXVehicleWheelInstances(UWorld* InWorld);
+	~FPhysXVehicleWheelInstances();
+
+	/** Forget last frame's transforms */
+	// 清除上一帧的变换
+	void BeginUpdate();
+
+	/** Draw one wheel with Mesh at WorldTransform this frame */
+	// 本帧使用 Mesh 在 WorldTransform 处绘制一个车轮
+	void AddWheel(UStaticMesh* Mesh, const FTransform& WorldTransform);
+
+	/** Push this frame's transforms to the instanced static mesh components */
+	// 将本帧的变换推送到实例化静态网格体组件
+	void EndUpdate();
+
+	/** Number of wheels drawn by the last update */
+	// 上次更新绘制的车轮数量
+	int32 GetNumInstances() const;
+
+private:
+
+	struct FMeshInstances
+	{
+		TWeakObjectPtr<UStaticMesh> Mesh;
+		TWeakObjectPtr<UInstancedStaticMeshComponent> Component;
+
+		// This frame's instance transforms, in world space
+		// 本帧的实例变换，位于世界空间
+		TArray<FTransform> Transforms;
+	};
+
+	UInstancedStaticMeshComponent* CreateComponent(UStaticMesh* Mesh);
+
+	TWeakObjectPtr<UWorld>				World;
+
+	// Transient actor owning the components, spawned with the first mesh
+	// 拥有这些组件的临时 Actor，随第一个网格体生成
+	TWeakObjectPtr<AActor>				Actor;
+
+	TArray<FMeshInstances>				Meshes;
+};
+
+#endif // WITH_PHYSX_VEHICLES
+
+PRAGMA_ENABLE_DEPRECATION_WARNINGS
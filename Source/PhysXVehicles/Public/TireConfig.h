@@ -7,6 +7,7 @@
 #include "CoreMinimal.h"
 #include "UObject/ObjectMacros.h"
 #include "Engine/DataAsset.h"
+#include "TireModel.h"
 #include "TireConfig.generated.h"
 
 class UPhysicalMaterial;
@@ -55,12 +56,21 @@ private:
 	UPROPERTY(EditAnywhere, Category = TireConfig)
 	TArray<FTireConfigMaterialFriction> TireFrictionScales;
 
+	/** Magic Formula coefficients for the wheels using the Pacejka tire model */
+	// 使用 Pacejka 轮胎模型的车轮的魔术公式系数
+	UPROPERTY(EditAnywhere, Category = TireConfig)
+	FPacejkaTireCoefficients			PacejkaCoefficients;
+
 private:
 
 	// Tire config ID to pass to PhysX
 	// 要传递给 PhysX 的轮胎配置 ID
 	uint32								TireConfigID;
 
+	// Pacejka model built from PacejkaCoefficients, evaluated by the tire shader without touching this object
+	// 由 PacejkaCoefficients 构建的 Pacejka 模型，轮胎着色器计算时不访问此对象
+	FPacejkaTireModel					PacejkaTireModel;
+
 public:
 
 	UTireConfig();
@@ -85,6 +95,14 @@ public:
 	// 为特定材料设置摩擦缩放
 	void SetPerMaterialFrictionScale(UPhysicalMaterial*	PhysicalMaterial, float	NewFrictionScale);
 
+	/** Pacejka tire model with this config's coefficients */
+	// 使用此配置系数的 Pacejka 轮胎模型
+	const ITireModel& GetPacejkaTireModel() const { return PacejkaTireModel; }
+
+	/** Setter for PacejkaCoefficients. Not thread safe against a running vehicle update */
+	// 设置 PacejkaCoefficients。与正在运行的车辆更新之间不是线程安全的
+	void SetPacejkaCoefficients(const FPacejkaTireCoefficients& NewCoefficients);
+
 	/**
 	* Getter for TireConfigID
 	*/
@@ -97,6 +115,8 @@ public:
 	*/
 	virtual void PostInitProperties() override;
 
+	virtual void PostLoad() override;
+
 	/**
 	* Called before destroying the object.  This is called immediately upon deciding to destroy the object, to allow the object to begin an
 	* asynchronous cleanup process.
@@ -0,0 +1,205 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectMacros.h"
+#include "TireModel.generated.h"
+
+struct FTireShaderInput;
+struct FTireShaderOutput;
+
+/** Which tire model generates a wheel's tire forces */
+// 由哪种轮胎模型生成车轮的轮胎力
+UENUM()
+enum class ETireModelType : uint8
+{
+	/** UWheeledVehicleMovementComponent::GenerateTireForces, or the PhysX default tire model natively for components that clear bCallGenerateTireForces */
+	// UWheeledVehicleMovementComponent::GenerateTireForces；对清除了 bCallGenerateTireForces 的组件则以原生方式使用 PhysX 默认轮胎模型
+	Default,
+
+	/** Pacejka Magic Formula with the coefficients of the wheel's tire config, evaluated natively without going through the component */
+	// 使用车轮轮胎配置系数的 Pacejka 魔术公式，直接在原生代码中计算，不经过组件
+	Pacejka,
+};
+
+/**
+ * Pacejka '96 Magic Formula coefficients for pure longitudinal and lateral slip, with the load Fz in kN, the longitudinal slip in
+ * percent and the slip angle in degrees, giving forces in N. The camber terms are left out, PhysX hands the tire shader no camber.
+ */
+// Pacejka '96 魔术公式的纯纵向和纯横向滑移系数，载荷 Fz 以 kN 为单位，纵向滑移以百分比为单位，侧偏角以度为单位，得到的力以 N 为单位。
+// 省略了外倾项，PhysX 不向轮胎着色器传递外倾角
+USTRUCT()
+struct PHYSXVEHICLES_API FPacejkaTireCoefficients
+{
+	GENERATED_USTRUCT_BODY()
+
+	/** Longitudinal shape factor C */
+	// 纵向形状因子 C
+	UPROPERTY(EditAnywhere, Category = Longitudinal)
+	float B0;
+
+	/** Longitudinal peak factor D = Fz * (B1 * Fz + B2) */
+	// 纵向峰值因子 D = Fz * (B1 * Fz + B2)
+	UPROPERTY(EditAnywhere, Category = Longitudinal)
+	float B1;
+
+	UPROPERTY(EditAnywhere, Category = Longitudinal)
+	float B2;
+
+	/** Longitudinal slip stiffness BCD = (B3 * Fz^2 + B4 * Fz) * exp(-B5 * Fz) */
+	// 纵向滑移刚度 BCD = (B3 * Fz^2 + B4 * Fz) * exp(-B5 * Fz)
+	UPROPERTY(EditAnywhere, Category = Longitudinal)
+	float B3;
+
+	UPROPERTY(EditAnywhere, Category = Longitudinal)
+	float B4;
+
+	UPROPERTY(EditAnywhere, Category = Longitudinal)
+	float B5;
+
+	/** Longitudinal curvature factor E = (B6 * Fz^2 + B7 * Fz + B8) * (1 - B13 * sign(slip + H)) */
+	// 纵向曲率因子 E = (B6 * Fz^2 + B7 * Fz + B8) * (1 - B13 * sign(slip + H))
+	UPROPERTY(EditAnywhere, Category = Longitudinal)
+	float B6;
+
+	UPROPERTY(EditAnywhere, Category = Longitudinal)
+	float B7;
+
+	UPROPERTY(EditAnywhere, Category = Longitudinal)
+	float B8;
+
+	/** Longitudinal horizontal shift H = B9 * Fz + B10 */
+	// 纵向水平偏移 H = B9 * Fz + B10
+	UPROPERTY(EditAnywhere, Category = Longitudinal)
+	float B9;
+
+	UPROPERTY(EditAnywhere, Category = Longitudinal)
+	float B10;
+
+	/** Longitudinal vertical shift V = B11 * Fz + B12 */
+	// 纵向垂直偏移 V = B11 * Fz + B12
+	UPROPERTY(EditAnywhere, Category = Longitudinal)
+	float B11;
+
+	UPROPERTY(EditAnywhere, Category = Longitudinal)
+	float B12;
+
+	UPROPERTY(EditAnywhere, Category = Longitudinal)
+	float B13;
+
+	/** Lateral shape factor C */
+	// 横向形状因子 C
+	UPROPERTY(EditAnywhere, Category = Lateral)
+	float A0;
+
+	/** Lateral peak factor D = Fz * (A1 * Fz + A2) */
+	// 横向峰值因子 D = Fz * (A1 * Fz + A2)
+	UPROPERTY(EditAnywhere, Category = Lateral)
+	float A1;
+
+	UPROPERTY(EditAnywhere, Category = Lateral)
+	float A2;
+
+	/** Cornering stiffness BCD = A3 * sin(2 * atan(Fz / A4)) */
+	// 侧偏刚度 BCD = A3 * sin(2 * atan(Fz / A4))
+	UPROPERTY(EditAnywhere, Category = Lateral)
+	float A3;
+
+	UPROPERTY(EditAnywhere, Category = Lateral)
+	float A4;
+
+	/** Lateral curvature factor E = A6 * Fz + A7 */
+	// 横向曲率因子 E = A6 * Fz + A7
+	UPROPERTY(EditAnywhere, Category = Lateral)
+	float A6;
+
+	UPROPERTY(EditAnywhere, Category = Lateral)
+	float A7;
+
+	/** Lateral horizontal shift H = A8 * Fz + A9 */
+	// 横向水平偏移 H = A8 * Fz + A9
+	UPROPERTY(EditAnywhere, Category = Lateral)
+	float A8;
+
+	UPROPERTY(EditAnywhere, Category = Lateral)
+	float A9;
+
+	/** Lateral vertical shift V = A11 * Fz + A12 */
+	// 横向垂直偏移 V = A11 * Fz + A12
+	UPROPERTY(EditAnywhere, Category = Lateral)
+	float A11;
+
+	UPROPERTY(EditAnywhere, Category = Lateral)
+	float A12;
+
+	/** A road tire with a peak friction of about 1.1 */
+	// 峰值摩擦约为 1.1 的公路轮胎
+	FPacejkaTireCoefficients();
+};
+
+/**
+ * A batch of tires in structure of arrays form, in PhysX units (cm, kg). Every array holds Num entries.
+ */
+// 结构数组形式的一批轮胎，使用 PhysX 单位（厘米、千克）。每个数组包含 Num 个元素
+struct FTireModelBatch
+{
+	int32			Num;
+
+	const float*	TireFriction;
+	const float*	LongSlip;
+	const float*	LatSlip;
+	const float*	TireLoad;
+	const float*	WheelRadius;
+
+	float*			WheelTorque;
+	float*			LongForce;
+	float*			LatForce;
+};
+
+/**
+ * Native tire force model. Called from the PhysX tire shader on whichever thread runs the vehicle update, so implementations
+ * must be thread safe and must not touch UObjects.
+ */
+// 原生轮胎力模型。由运行车辆更新的线程上的 PhysX 轮胎着色器调用，因此实现必须是线程安全的，且不能访问 UObject
+class PHYSXVEHICLES_API ITireModel
+{
+public:
+
+	virtual ~ITireModel() {}
+
+	/** Generate the forces of a batch of tires */
+	// 生成一批轮胎的力
+	virtual void EvaluateBatch(const FTireModelBatch& Batch) const = 0;
+
+	/** Generate the forces of one tire, as a batch of one. Batched models pad it to their width, so this costs a whole batch pass */
+	// 以单个元素的批次生成一个轮胎的力。批处理模型会将其填充到批宽度，因此开销相当于一次完整的批处理
+	virtual void Evaluate(const FTireShaderInput& Input, FTireShaderOutput& Output) const;
+};
+
+/**
+ * Pacejka '96 Magic Formula, four tires at a time in SIMD registers. Combined slip scales both forces back onto the friction ellipse.
+ */
+// Pacejka '96 魔术公式，每次在 SIMD 寄存器中计算四个轮胎。组合滑移时将两个力缩放回摩擦椭圆上
+class PHYSXVEHICLES_API FPacejkaTireModel : public ITireModel
+{
+public:
+
+	FPacejkaTireModel();
+
+	void SetCoefficients(const FPacejkaTireCoefficients& InCoefficients);
+
+	virtual void EvaluateBatch(const FTireModelBatch& Batch) const override;
+
+	/** Model with the default coefficients, for wheels without a tire config */
+	// 使用默认系数的模型，用于没有轮胎配置的车轮
+	static const FPacejkaTireModel& GetDefault();
+
+private:
+
+	// Evaluate exactly four tires starting at Index
+	// 从 Index 开始计算恰好四个轮胎
+	void EvaluateFour(const FTireModelBatch& Batch, int32 Index) const;
+
+	FPacejkaTireCoefficients		Coefficients;
+};
@@ -0,0 +1,96 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+/*
+ * Base VehicleSim for the tracked PhysX vehicle class, each track is driven as one by the engine
+ */
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectMacros.h"
+#include "WheeledVehicleMovementComponent.h"
+#include "WheeledVehicleMovementComponent4W.h"
+#include "TrackedVehicleMovementComponent.generated.h"
+
+PRAGMA_DISABLE_DEPRECATION_WARNINGS
+
+/**
+ * Tank drive on top of PxVehicleDriveTank. WheelSetups alternate left and right road wheels from front to back, the even ones
+ * belong to the left track and the odd ones to the right track, and every wheel of a track spins at the same rate.
+ * Throttle and steering are mixed into left and right track thrust, so full steering with no throttle turns on the spot.
+ * SetTrackThrustInput drives the tracks directly instead, for as long as either thrust is non zero.
+ */
+// 基于 PxVehicleDriveTank 的履带驱动。WheelSetups 从前到后左右交替排列负重轮，偶数索引属于左履带，奇数索引属于右履带，
+// 同一履带上的所有车轮以相同转速旋转。油门和转向被混合为左右履带推力，因此无油门时满转向会原地转向
+// 只要任一推力不为零，SetTrackThrustInput 会改为直接驱动履带
+class UE_DEPRECATED(4.26, "PhysX is deprecated. Use the UChaosWheeledVehicleMovementComponent from the ChaosVehiclePhysics Plugin.") UTrackedVehicleMovementComponent;
+UCLASS(ClassGroup = (Physics), meta = (BlueprintSpawnableComponent), hidecategories = (PlanarMovement, "Components|Movement|Planar", Activation, "Components|Activation"))
+class PHYSXVEHICLES_API UTrackedVehicleMovementComponent : public UWheeledVehicleMovementComponent
+{
+	GENERATED_UCLASS_BODY()
+
+	/** Engine */
+	// 引擎
+	UPROPERTY(EditAnywhere, Category = MechanicalSetup)
+	FVehicleEngineData EngineSetup;
+
+	/** Transmission data */
+	// 变速器
+	UPROPERTY(EditAnywhere, Category = MechanicalSetup)
+	FVehicleTransmissionData TransmissionSetup;
+
+	/** Set the thrust of each track directly, in [-1..1], negative thrust drives a track backwards. Overrides throttle and steering until both are zero.
+	 Replicated and recorded in replays like the other inputs */
+	// 直接设置每条履带的推力，范围 [-1..1]，负推力使履带向后驱动。在二者都归零之前覆盖油门和转向
+	// 与其他输入一样会被同步并记录到重放中
+	UFUNCTION(BlueprintCallable, Category = "Game|Components|TrackedVehicleMovement")
+	void SetTrackThrustInput(float LeftThrust, float RightThrust);
+
+	virtual FReplicatedVehicleState GetSimulationInputState() const override;
+	virtual void SetSimulationInputState(const FReplicatedVehicleState& InState) override;
+
+	virtual void ComputeConstants() override;
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(struct FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+protected:
+
+	// Track thrust set by SetTrackThrustInput, passed to the PhysX vehicle as is. Range -1...1
+	// 由 SetTrackThrustInput 设置的履带推力，原样传递给 PhysX 车辆。范围 -1...1
+	UPROPERTY(Transient)
+	float RawLeftThrustInput;
+
+	UPROPERTY(Transient)
+	float RawRightThrustInput;
+
+	/** Pass the track thrust to the server, which replicates it to the other clients with the rest of the input state */
+	// 将履带推力传递给服务器，服务器将其与其余输入状态一起同步给其他客户端
+	UFUNCTION(reliable, server, WithValidation)
+	void ServerUpdateTrackThrust(float InLeftThrust, float InRightThrust);
+
+	/** Read the replicated track thrust for remote pawns */
+	// 为远程 Pawn 读取同步的履带推力
+	virtual void UpdateState(float DeltaTime) override;
+
+#if WITH_PHYSX && PHYSICS_INTERFACE_PHYSX
+
+	/** Allocate and setup the PhysX vehicle */
+	// 分配和设置 PhysX 车辆
+	virtual void SetupVehicleDrive(physx::PxVehicleWheelsSimData* PWheelsSimData) override;
+
+	virtual void UpdateSimulation_AssumesLocked(float DeltaTime) override;
+
+#endif // WITH_PHYSX
+
+	virtual uint32 GetSimSetupSourceHash() const override;
+
+	/** update simulation data: engine */
+	// 更新模拟数据：引擎
+	void UpdateEngineSetup(const FVehicleEngineData& NewEngineSetup);
+
+	/** update simulation data: transmission */
+	// 更新模拟数据：变速器
+	void UpdateTransmissionSetup(const FVehicleTransmissionData& NewGearSetup);
+};
+
+PRAGMA_ENABLE_DEPRECATION_WARNINGS
@@ -9,19 +9,13 @@
 #include "UObject/ObjectMacros.h"
 #include "Animation/AnimInstance.h"
 #include "Animation/AnimInstanceProxy.h"
+#include "VehicleWheelAnimData.h"
 #include "VehicleAnimInstance.generated.h"
 
 PRAGMA_DISABLE_DEPRECATION_WARNINGS
 
 class UWheeledVehicleMovementComponent;
 
-struct FWheelAnimData
-{
-	FName BoneName;
-	FRotator RotOffset;
-	FVector LocOffset;
-};
-
  /** Proxy override for this UAnimInstance-derived class */
 struct UE_DEPRECATED(4.26, "PhysX is deprecated. Use the FVehicleAnimationInstanceProxy from the ChaosVehiclePhysics Plugin.") FVehicleAnimInstanceProxy;
 USTRUCT()
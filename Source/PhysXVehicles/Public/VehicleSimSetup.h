@@ -0,0 +1,119 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectMacros.h"
+#include "Engine/DataAsset.h"
+#include "VehicleSimSetup.generated.h"
+
+#if WITH_PHYSX && PHYSICS_INTERFACE_PHYSX
+namespace physx
+{
+	class PxVehicleWheels;
+	class PxVehicleWheelsSimData;
+}
+#endif // WITH_PHYSX
+
+/**
+ * PhysX vehicle sim data compiled ahead of time from a vehicle setup: wheel, tire and suspension data with the sprung masses
+ * already solved, the resting wheel positions read from the skeletal mesh, and the drive sim data with the engine curve, gears,
+ * differential and Ackermann geometry. A vehicle pointing at a compatible setup copies it instead of deriving it again on spawn.
+ * The setup stores a hash of the inputs it was compiled from, a vehicle whose wheels, mesh, mass or drive changed since derives
+ * its sim data again until the setup is recompiled (p.Vehicle.CompileSimSetups in PIE).
+ */
+// 预先从车辆设置编译的 PhysX 车辆模拟数据：已解算簧载质量的车轮、轮胎和悬架数据，从骨骼网格体读取的车轮静止位置，
+// 以及包含引擎曲线、档位、差速器和阿克曼几何的驱动模拟数据。指向兼容设置的车辆在生成时直接复制它，而不是重新推导。
+// 该设置保存了编译时输入数据的哈希，车轮、网格体、质量或驱动此后发生变化的车辆会重新推导模拟数据，
+// 直到该设置被重新编译（在 PIE 中使用 p.Vehicle.CompileSimSetups）
+class UE_DEPRECATED(4.26, "PhysX is deprecated. Use the Chaos physics and the ChaosVehiclePhysics Plugin.") UVehicleSimSetup;
+UCLASS()
+class PHYSXVEHICLES_API UVehicleSimSetup : public UDataAsset
+{
+	GENERATED_BODY()
+
+public:
+
+	UVehicleSimSetup();
+
+	/** Number of wheels the setup was compiled for */
+	// 编译该设置时的车轮数量
+	UPROPERTY(VisibleAnywhere, Category = VehicleSimSetup)
+	int32								NumWheels;
+
+	/** Chassis mass the sprung masses were solved for [kg] */
+	// 解算簧载质量时的底盘质量 [kg]
+	UPROPERTY(VisibleAnywhere, Category = VehicleSimSetup)
+	float								ChassisMass;
+
+	/** PhysX vehicle type of the compiled drive, PxVehicleTypes */
+	// 已编译驱动的 PhysX 车辆类型，PxVehicleTypes
+	UPROPERTY(VisibleAnywhere, Category = VehicleSimSetup)
+	int32								VehicleType;
+
+	/** Resting position of each wheel relative to the chassis body */
+	// 每个车轮相对于底盘刚体的静止位置
+	UPROPERTY(VisibleAnywhere, Category = VehicleSimSetup)
+	TArray<FVector>						WheelRestingPositions;
+
+private:
+
+	// PhysX SDK version and record sizes the blobs were written with, a mismatch means they must be compiled again
+	// 写入数据块时的 PhysX SDK 版本和记录大小，不匹配意味着必须重新编译
+	UPROPERTY()
+	int32								PhysXVersion;
+
+	UPROPERTY()
+	int32								WheelRecordSize;
+
+	// Hash of the vehicle setup the data was compiled from, see UWheeledVehicleMovementComponent::GetSimSetupSourceHash
+	// 编译数据时所用车辆设置的哈希，参见 UWheeledVehicleMovementComponent::GetSimSetupSourceHash
+	UPROPERTY()
+	uint32								SourceHash;
+
+	// One record per wheel, see FCompiledWheelRecord
+	// 每个车轮一条记录，参见 FCompiledWheelRecord
+	UPROPERTY()
+	TArray<uint8>						WheelRecords;
+
+	// PxVehicleDriveSimData4W, PxVehicleDriveSimDataNW or PxVehicleDriveSimData as is, empty for vehicles without a drive
+	// 原样存储的 PxVehicleDriveSimData4W、PxVehicleDriveSimDataNW 或 PxVehicleDriveSimData，无驱动的车辆为空
+	UPROPERTY()
+	TArray<uint8>						DriveSimData;
+
+public:
+
+	/** Whether the wheel data fits a vehicle with this many wheels, this mass and this setup hash */
+	// 车轮数据是否适用于具有该车轮数量、质量和设置哈希的车辆
+	bool IsCompatible(int32 InNumWheels, float InMass, uint32 InSourceHash) const;
+
+	/** Combine the exported text of every non-transient property of Data into Hash */
+	// 将 Data 所有非瞬态属性的导出文本合并到 Hash 中
+	static uint32 HashProperties(const UStruct* Struct, const void* Data, uint32 Hash);
+
+#if WITH_PHYSX && PHYSICS_INTERFACE_PHYSX
+
+	/** Capture the sim data of a vehicle PhysX already set up */
+	// 捕获 PhysX 已设置好的车辆的模拟数据
+	void Compile(const physx::PxVehicleWheels& PVehicle, const TArray<FVector>& InWheelRestingPositions, float InChassisMass, uint32 InSourceHash);
+
+	/** Copy the wheel, tire and suspension data of every wheel. Tire types are runtime IDs and are left to the caller */
+	// 复制每个车轮的车轮、轮胎和悬架数据。轮胎类型是运行时 ID，由调用者设置
+	void ApplyWheelsSimData(physx::PxVehicleWheelsSimData& PWheelsSimData) const;
+
+	/** Copy the compiled drive sim data, if it was compiled for this vehicle type */
+	// 如果驱动模拟数据是为该车辆类型编译的，则复制它
+	template<typename DriveSimDataType>
+	bool GetDriveSimData(int32 InVehicleType, DriveSimDataType& OutDriveSimData) const
+	{
+		if (VehicleType != InVehicleType || DriveSimData.Num() != sizeof(DriveSimDataType))
+		{
+			return false;
+		}
+
+		FMemory::Memcpy(&OutDriveSimData, DriveSimData.GetData(), sizeof(DriveSimDataType));
+		return true;
+	}
+
+#endif // WITH_PHYSX
+};
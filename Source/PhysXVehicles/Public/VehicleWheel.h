@@ -11,6 +11,7 @@
 #include "UObject/Object.h"
 #include "UObject/ScriptMacros.h"
 #include "EngineDefines.h"
+#include "TireModel.h"
 #include "VehicleWheel.generated.h"
 
 class UPhysicalMaterial;
@@ -115,6 +116,11 @@ class PHYSXVEHICLES_API UVehicleWheel : public UObject
 	UPROPERTY(EditAnywhere, Category = Tire)
 	class UTireConfig*								TireConfig;
 
+	/** Tire model generating the forces of this wheel. Pacejka uses the tire config's coefficients and skips GenerateTireForces */
+	// 生成该车轮轮胎力的轮胎模型。Pacejka 使用轮胎配置的系数，并跳过 GenerateTireForces
+	UPROPERTY(EditAnywhere, Category = Tire)
+	ETireModelType									TireModel;
+
 	/** Max normalized tire load at which the tire can deliver no more lateral stiffness no matter how much extra load is applied to the tire. */
 	// 最大归一化轮胎载荷，在该载荷下，无论对轮胎施加多少额外载荷，轮胎都无法提供更多横向刚度
 	UPROPERTY(EditAnywhere, Category=Tire, meta=(ClampMin = "0.01", UIMin = "0.01"))
@@ -285,6 +291,18 @@ class PHYSXVEHICLES_API UVehicleWheel : public UObject
 	// 当车辆Tick时Tick这个车轮
 	virtual void Tick( float DeltaTime );
 
+	/**
+	 * Take this step's location and velocity from the vehicle manager's bulk wheel update instead of ticking
+	 */
+	// 从车辆管理器的批量车轮更新中获取本步的位置和速度，而不是进行Tick
+	void SetWorldState( const FVector& InLocation, const FVector& InVelocity );
+
+	/**
+	 * Native tire model picked in Init, null when the forces come from GenerateTireForces
+	 */
+	// 在 Init 中选定的原生轮胎模型，轮胎力来自 GenerateTireForces 时为空
+	const ITireModel* GetTireModel() const { return NativeTireModel; }
+
 #if WITH_EDITOR
 
 	/**
@@ -303,6 +321,11 @@ protected:
 	FVector GetPhysicsLocation();
 
 private:
+
+	// Tire model the tire shader calls directly, owned by the tire config or the default Pacejka model
+	// 轮胎着色器直接调用的轮胎模型，由轮胎配置或默认 Pacejka 模型持有
+	const ITireModel*								NativeTireModel;
+
 #if WITH_PHYSX && PHYSICS_INTERFACE_PHYSX
 	FPhysXVehicleManager* GetVehicleManager() const;
 #endif // WITH_PHYSX
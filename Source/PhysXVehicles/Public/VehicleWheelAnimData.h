@@ -0,0 +1,16 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Animation data of one wheel, shared by the vehicle anim instance and the vehicle manager publishing it
+ */
+// 单个车轮的动画数据，由车辆动画实例和发布它的车辆管理器共用
+struct FWheelAnimData
+{
+	FName BoneName;
+	FRotator RotOffset;
+	FVector LocOffset;
+};
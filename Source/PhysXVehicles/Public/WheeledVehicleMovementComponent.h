@@ -20,6 +20,7 @@ namespace physx
 	class PxVehicleWheels;
 	class PxVehicleWheelsSimData;
 	class PxRigidBody;
+	class PxTransform;
 }
 #endif // WITH_PHYSX
 
@@ -163,6 +164,14 @@ struct PHYSXVEHICLES_API FReplicatedVehicleState
 	// 当前档位
 	UPROPERTY()
 	int32 CurrentGear;
+
+	// input replication: direct track thrust, only read by tracked vehicles
+	// 直接设置的履带推力，仅由履带车辆读取
+	UPROPERTY()
+	float LeftThrustInput;
+
+	UPROPERTY()
+	float RightThrustInput;
 };
 
 USTRUCT()
@@ -201,6 +210,52 @@ struct PHYSXVEHICLES_API FVehicleInputRate
 	}
 };
 
+/**
+ * Everything the input smoothing of one vehicle needs, packed so the vehicle manager can run it in parallel without touching UObjects
+ */
+// 一辆车的输入平滑所需的全部数据，打包后车辆管理器可以并行运行而无需访问 UObject
+struct PHYSXVEHICLES_API FVehicleInputPacket
+{
+	// Raw inputs after auto reverse and avoidance adjustments
+	// 经过自动倒车和规避调整后的原始输入
+	float RawSteeringInput;
+	float RawThrottleInput;
+	float RawBrakeInput;
+	bool bRawHandbrakeInput;
+
+	bool bReverseAsBrake;
+	float ForwardSpeed;
+	int32 TargetGear;
+
+	float IdleBrakeInput;
+	float StopThreshold;
+	float WrongDirectionThreshold;
+
+	FVehicleInputRate SteeringInputRate;
+	FVehicleInputRate ThrottleInputRate;
+	FVehicleInputRate BrakeInputRate;
+	FVehicleInputRate HandbrakeInputRate;
+
+	// Smoothed inputs, last step's going in and this step's coming out of InterpInputs
+	// 平滑后的输入，传入 InterpInputs 的是上一步的值，输出的是这一步的值
+	float SteeringInput;
+	float ThrottleInput;
+	float BrakeInput;
+	float HandbrakeInput;
+
+	/** Throttle the raw input asks for, zero while the vehicle still has to change direction */
+	// 原始输入要求的油门，车辆仍需改变方向时为零
+	float CalcThrottleInput() const;
+
+	/** Brake the raw input asks for, including auto brake and reverse as brake */
+	// 原始输入要求的刹车，包括自动刹车和倒车即刹车
+	float CalcBrakeInput() const;
+
+	/** Move the smoothed inputs toward the raw ones at the configured rise and fall rates */
+	// 以配置的上升和下降速率将平滑输入向原始输入移动
+	void InterpInputs(float DeltaTime);
+};
+
 /**
  * Component to handle the vehicle simulation for an actor.
  */
@@ -261,6 +316,13 @@ public:
 	UPROPERTY(EditAnywhere, Category=VehicleSetup)
 	TArray<FWheelSetup> WheelSetups;
 
+	/** Sim data compiled ahead of time from this vehicle (p.Vehicle.CompileSimSetups in PIE), copied on spawn instead of being derived
+	 from the wheels, mesh and drive again. Ignored once it no longer matches the wheel count or mass */
+	// 预先从该车辆编译的模拟数据（在 PIE 中使用 p.Vehicle.CompileSimSetups），生成时直接复制，而不是从车轮、网格体和驱动重新推导
+	// 当其与车轮数量或质量不再匹配时将被忽略
+	UPROPERTY(EditAnywhere, Category=VehicleSetup, AdvancedDisplay)
+	class UVehicleSimSetup* CompiledSimSetup;
+
 	/** DragCoefficient of the vehicle chassis. */
 	// 车辆底盘阻力系数
 	UPROPERTY(EditAnywhere, Category = VehicleSetup)
@@ -348,6 +410,53 @@ public:
     // 超过阈值纵向速度的sub-step数量默认为 1
     UPROPERTY(EditAnywhere, Category=VehicleSetup, AdvancedDisplay, meta = (ClampMin = "1", UIMin = "1", ClampMax = "10", UIMax = "5"))
     int32 HighForwardSpeedSubStepCount;
+
+	/** Sweep the wheel shapes for the suspension instead of casting a single ray per wheel.
+	 Gives smoother contacts over kerbs and thin geometry, which usually allows fewer sub-steps.
+	 Vehicles with triangle mesh wheel shapes keep using raycasts. */
+	// 悬架使用车轮形状扫描，而不是每个车轮投射一条射线
+	// 在路缘和薄几何体上提供更平滑的接触，通常可以减少sub-steps
+	// 车轮形状为三角网格的车辆仍然使用光线投射
+	UPROPERTY(EditAnywhere, Category=VehicleSetup, AdvancedDisplay)
+	uint8 bUseSuspensionSweeps : 1;
+
+	/** Distance (cm) from every player beyond which the vehicle leaves the PhysX vehicle simulation for a cheaper kinematic model:
+	 one raycast per axle, analytic suspension and a kinematic chassis. Speed and pose carry over both ways. 0 always simulates fully */
+	// 与所有玩家的距离（厘米）超过该值后，车辆离开 PhysX 车辆模拟，改用更廉价的运动学模型：
+	// 每个车轴一条射线、解析悬架和运动学底盘。切换时双向保留速度和姿态。为 0 时始终完整模拟
+	UPROPERTY(EditAnywhere, Category=VehicleSetup, AdvancedDisplay, meta = (ClampMin = "0.0", UIMin = "0.0"))
+	float KinematicLODDistance;
+
+	/** Static mesh drawn for each wheel through instanced static meshes shared by all vehicles, once this vehicle is farther than
+	 InstancedWheelsDistance from every view. The skeletal mesh then hides its wheel bones and stops evaluating its skeleton.
+	 None keeps the skeletal wheels at every distance. */
+	// 当车辆与所有视点的距离都超过 InstancedWheelsDistance 时，通过所有车辆共享的实例化静态网格体为每个车轮绘制的静态网格体
+	// 此时骨骼网格体隐藏其车轮骨骼并停止计算骨架
+	// 为空时在任何距离都保留骨骼车轮
+	UPROPERTY(EditAnywhere, Category=WheelSetup)
+	class UStaticMesh* InstancedWheelMesh;
+
+	/** Transform of InstancedWheelMesh relative to the wheel */
+	// InstancedWheelMesh 相对于车轮的变换
+	UPROPERTY(EditAnywhere, Category=WheelSetup, AdvancedDisplay)
+	FTransform InstancedWheelMeshTransform;
+
+	/** Distance (cm) from the nearest view beyond which the wheels are drawn with InstancedWheelMesh */
+	// 距最近视点的距离（厘米），超过该距离后车轮使用 InstancedWheelMesh 绘制
+	UPROPERTY(EditAnywhere, Category=WheelSetup, meta = (ClampMin = "0.0", UIMin = "0.0"))
+	float InstancedWheelsDistance;
+
+	/** Hide the skeletal wheels and stop evaluating the skeleton while the vehicle manager draws instanced wheels, or go back */
+	// 在车辆管理器绘制实例化车轮时隐藏骨骼车轮并停止计算骨架，或者恢复
+	void SetUseInstancedWheels(bool bEnable);
+
+	/** Capture the sim data PhysX was set up with into CompiledSimSetup, so later spawns can copy it */
+	// 将 PhysX 设置时使用的模拟数据捕获到 CompiledSimSetup 中，以便之后的生成可以直接复制
+	void CompileSimSetup();
+
+	/** Whether the vehicle manager currently draws this vehicle's wheels */
+	// 车辆管理器当前是否在绘制该车辆的车轮
+	bool IsUsingInstancedWheels() const { return bUsingInstancedWheels; }
     
 	// Our instanced wheels
 	UPROPERTY(transient, duplicatetransient, BlueprintReadOnly, Category=Vehicle)
@@ -376,6 +485,12 @@ public:
 	physx::PxVehicleWheels* PVehicle;
 	physx::PxVehicleDrive* PVehicleDrive;
 
+	// Manager the vehicle is registered with and its index in the manager's per vehicle arrays. Only the manager writes them,
+	// when this vehicle is added, removed or moved to another slot
+	// 车辆所注册的管理器及其在管理器每车辆数组中的索引。仅由管理器在添加、移除此车辆或将其移动到其他槽位时写入
+	class FPhysXVehicleManager* OwningVehicleManager;
+	int32 VehicleManagerIndex;
+
 #endif // WITH_PHYSX
 
 	/** Overridden to allow registration with components NOT owned by a Pawn. */
@@ -386,6 +501,13 @@ public:
 	// 计算旋转轮胎产生的力
 	virtual void GenerateTireForces(class UVehicleWheel* Wheel, const FTireShaderInput& Input, FTireShaderOutput& Output);
 
+	/** Call GenerateTireForces from the tire shader for wheels using the default tire model, on by default. Subclasses that do not
+	 override it clear this in their constructor to evaluate the default tire natively, without reaching into this component from
+	 inside PxVehicleUpdates, as the 4W, NW and tracked components do. Their subclasses overriding it set it back */
+	// 对使用默认轮胎模型的车轮，从轮胎着色器调用 GenerateTireForces，默认开启。未重写它的子类在构造函数中清除此项，
+	// 以原生方式计算默认轮胎，而不必在 PxVehicleUpdates 内部访问此组件，4W、NW 和履带组件即是如此。重写它的子类需将其重新设置
+	uint8 bCallGenerateTireForces : 1;
+
 #if WITH_PHYSX && PHYSICS_INTERFACE_PHYSX
 
 	/** Return true if we are ready to create a vehicle */
@@ -400,6 +522,14 @@ public:
 	// 在将输入发送到车辆系统之前Tick此车辆模拟
 	virtual void TickVehicle( float DeltaTime );
 
+	/**
+	 * TickVehicle for the vehicle manager's batched tick: passes inputs to the PhysX vehicle and adds drag. Runs on the game thread
+	 * with the scene write lock held, after the manager read the chassis pose and moved the wheels in parallel
+	 */
+	// 供车辆管理器批量 Tick 使用的 TickVehicle：将输入传递给 PhysX 车辆并施加阻力。在游戏线程上持有场景写锁运行，
+	// 此前管理器已并行读取了底盘姿态并移动了车轮
+	void TickVehicle_AssumesLocked( float DeltaTime, const physx::PxTransform& ChassisPose );
+
 	/** Updates the vehicle tuning and other state such as user input. */
 	// 更新车辆调整和其他状态，例如用户输入
 	virtual void PreTick(float DeltaTime);
@@ -412,6 +542,10 @@ public:
 	// 用于为该组件创建任何物理引擎信息
 	virtual void OnCreatePhysicsState() override;
 
+	/** Set up the PhysX vehicle and register it, right from OnCreatePhysicsState or later from the vehicle manager's creation queue */
+	// 设置 PhysX 车辆并注册，可直接在 OnCreatePhysicsState 中调用，也可稍后由车辆管理器的创建队列调用
+	void FinishCreatePhysicsState();
+
 	/** Used to shut down and pysics engine structure for this component */
 	// 用于关闭此组件的物理引擎结构
 	virtual void OnDestroyPhysicsState() override;
@@ -520,6 +654,14 @@ public:
 	UFUNCTION(BlueprintCallable, Category="Game|Components|WheeledVehicleMovement")
 	bool GetUseAutoGears() const;
 
+	/** Smoothed inputs and target gear about to be passed to the simulation */
+	// 即将传递给模拟的平滑输入和目标档位
+	virtual FReplicatedVehicleState GetSimulationInputState() const;
+
+	/** Override the smoothed inputs and target gear for the next simulation step, used by replay playback */
+	// 覆盖下一个模拟步骤的平滑输入和目标档位，供重放回放使用
+	virtual void SetSimulationInputState(const FReplicatedVehicleState& InState);
+
 	// RVO Avoidance
 
 	/** Vehicle Radius to use for RVO avoidance (usually half of vehicle width) */
@@ -601,6 +743,18 @@ public:
 	UPROPERTY()
 	FVector PendingLaunchVelocity;
 	
+	/**
+	 * Game thread part of UpdateState: auto reverse, avoidance and replicated input for remote pawns.
+	 * Returns true if the vehicle is locally controlled and OutPacket needs smoothing and applying
+	 */
+	// UpdateState 的游戏线程部分：自动倒车、规避以及远程 Pawn 的同步输入
+	// 如果车辆由本地控制且 OutPacket 需要平滑和应用，则返回 true
+	bool GatherInputPacket(float DeltaTime, FVehicleInputPacket& OutPacket);
+
+	/** Store the smoothed inputs of a packet and send them to the server */
+	// 存储数据包中的平滑输入并发送给服务器
+	void ApplyInputPacket(const FVehicleInputPacket& Packet);
+
 	/** Change avoidance state and register with RVO manager if necessary */
 	// 如有必要，更改规避状态并注册到 RVO 管理器
 	UFUNCTION(BlueprintCallable, Category = "Pawn|Components|WheeledVehicleMovement")
@@ -689,6 +843,18 @@ protected:
 	UPROPERTY(EditAnywhere, Category=VehicleInput, AdvancedDisplay)
 	FVehicleInputRate SteeringInputRate;
 
+	/** Fill a packet from the current raw inputs and tuning */
+	// 根据当前原始输入和调校填充数据包
+	void PackInput(float ForwardSpeed, FVehicleInputPacket& OutPacket) const;
+
+	/** Nudge the raw steering toward the avoidance velocity */
+	// 将原始转向向规避速度方向微调
+	void ApplyAvoidanceToRawSteering();
+
+	/** Nudge the raw throttle toward the avoidance speed */
+	// 将原始油门向规避速度微调
+	void ApplyAvoidanceToRawThrottle();
+
 	/** Compute steering input */
 	// 计算转向输入
 	float CalcSteeringInput();
@@ -764,6 +930,26 @@ protected:
 	// 规避速度锁定剩余时间
 	float AvoidanceLockTimer;
 
+	/** The wheel bones are hidden and the skeleton frozen, see SetUseInstancedWheels */
+	// 车轮骨骼已隐藏且骨架已冻结，参见 SetUseInstancedWheels
+	bool bUsingInstancedWheels;
+
+	/** The mesh's bNoSkeletonUpdate before SetUseInstancedWheels froze the skeleton, put back when skeletal wheels return */
+	// SetUseInstancedWheels 冻结骨架之前网格体的 bNoSkeletonUpdate 值，恢复骨骼车轮时还原
+	bool bSavedNoSkeletonUpdate;
+
+	/** The chassis body was made kinematic while waiting in the vehicle manager's creation queue, see HoldBodyForCreation */
+	// 在车辆管理器的创建队列中等待时，底盘刚体被设为运动学，参见 HoldBodyForCreation
+	bool bBodyHeldForCreation;
+
+	/** CompiledSimSetup matched the vehicle setup when SetupVehicle started, see CanUseCompiledSimSetup */
+	// SetupVehicle 开始时 CompiledSimSetup 与车辆设置匹配，参见 CanUseCompiledSimSetup
+	bool bUseCompiledSimSetup;
+
+	/** Keep the chassis body from simulating without its wheels until the queued vehicle is created, or hand it back */
+	// 在排队的车辆创建之前阻止底盘刚体在没有车轮的情况下模拟，或者将其交还
+	void HoldBodyForCreation(bool bHold);
+
 	/** Handle for delegate registered on mesh component */
 	// 在网格组件上注册的委托的句柄
 	FDelegateHandle MeshOnPhysicsStateChangeHandle;
@@ -798,6 +984,10 @@ protected:
 	// 将输入值传递给车辆模拟
 	virtual void UpdateSimulation( float DeltaTime );
 
+	/** Pass input values to vehicle simulation, the caller holds the scene write lock */
+	// 将输入值传递给车辆模拟，调用者持有场景写锁
+	virtual void UpdateSimulation_AssumesLocked( float DeltaTime );
+
 	/** Allocate and setup the PhysX vehicle */
 	// 分配和设置 PhysX 车辆
 	virtual void SetupVehicle();
@@ -837,6 +1027,14 @@ protected:
 	// 获取车轮静止时的局部坐标
 	virtual FVector GetWheelRestingPosition(const FWheelSetup& WheelSetup);
 
+	/** Whether CompiledSimSetup can stand in for deriving the sim data from the vehicle setup, checked once at the start of SetupVehicle */
+	// CompiledSimSetup 是否可以代替从车辆设置推导模拟数据，在 SetupVehicle 开始时检查一次
+	bool CanUseCompiledSimSetup() const { return bUseCompiledSimSetup; }
+
+	/** Hash of everything the sim data is derived from: mass, wheel classes, COM offset, mesh and physics asset, and the drive of subclasses */
+	// 推导模拟数据所依据的全部输入的哈希：质量、车轮类、重心偏移、网格体和物理资产，以及子类的驱动设置
+	virtual uint32 GetSimSetupSourceHash() const;
+
 	/** Get the local COM */
 	// center of mass
 	// 重心
@@ -223,10 +223,12 @@ protected:
 	// 分配和设置 PhysX 车辆
 	virtual void SetupVehicleDrive(physx::PxVehicleWheelsSimData* PWheelsSimData) override;
 
-	virtual void UpdateSimulation(float DeltaTime) override;
+	virtual void UpdateSimulation_AssumesLocked(float DeltaTime) override;
 
 #endif // WITH_PHYSX
 
+	virtual uint32 GetSimSetupSourceHash() const override;
+
 	/** update simulation data: engine */
 	// 更新模拟数据：引擎
 	void UpdateEngineSetup(const FVehicleEngineData& NewEngineSetup);
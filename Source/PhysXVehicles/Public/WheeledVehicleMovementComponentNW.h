@@ -0,0 +1,88 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+/*
+ * Base VehicleSim for the N-wheeled PhysX vehicle class, for trucks and other multi-axle vehicles
+ */
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectMacros.h"
+#include "WheeledVehicleMovementComponent.h"
+#include "WheeledVehicleMovementComponent4W.h"
+#include "Curves/CurveFloat.h"
+#include "WheeledVehicleMovementComponentNW.generated.h"
+
+USTRUCT()
+struct FVehicleDifferentialNWData
+{
+	GENERATED_USTRUCT_BODY()
+
+	/** Indices into WheelSetups of the wheels the engine drives, its torque is split equally between them. Empty drives every wheel */
+	// 由引擎驱动的车轮在 WheelSetups 中的索引，扭矩在它们之间平均分配。为空时驱动所有车轮
+	UPROPERTY(EditAnywhere, Category = Setup)
+	TArray<int32> DrivenWheels;
+};
+
+PRAGMA_DISABLE_DEPRECATION_WARNINGS
+
+class UE_DEPRECATED(4.26, "PhysX is deprecated. Use the UChaosWheeledVehicleMovementComponent from the ChaosVehiclePhysics Plugin.") UWheeledVehicleMovementComponentNW;
+UCLASS(ClassGroup = (Physics), meta = (BlueprintSpawnableComponent), hidecategories = (PlanarMovement, "Components|Movement|Planar", Activation, "Components|Activation"))
+class PHYSXVEHICLES_API UWheeledVehicleMovementComponentNW : public UWheeledVehicleMovementComponent
+{
+	GENERATED_UCLASS_BODY()
+
+	/** Engine */
+	// 引擎
+	UPROPERTY(EditAnywhere, Category = MechanicalSetup)
+	FVehicleEngineData EngineSetup;
+
+	/** Differential */
+	// 差速器
+	UPROPERTY(EditAnywhere, Category = MechanicalSetup)
+	FVehicleDifferentialNWData DifferentialSetup;
+
+	/** Transmission data */
+	// 变速器
+	UPROPERTY(EditAnywhere, Category = MechanicalSetup)
+	FVehicleTransmissionData TransmissionSetup;
+
+	/** Maximum steering versus forward speed (km/h) */
+	// 最大转向与前进速度 (km/h)
+	// 转向曲线
+	UPROPERTY(EditAnywhere, Category = SteeringSetup)
+	FRuntimeFloatCurve SteeringCurve;
+
+	virtual void ComputeConstants() override;
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(struct FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+protected:
+
+
+#if WITH_PHYSX && PHYSICS_INTERFACE_PHYSX
+
+	/** Allocate and setup the PhysX vehicle */
+	// 分配和设置 PhysX 车辆
+	virtual void SetupVehicleDrive(physx::PxVehicleWheelsSimData* PWheelsSimData) override;
+
+	virtual void UpdateSimulation_AssumesLocked(float DeltaTime) override;
+
+#endif // WITH_PHYSX
+
+	virtual uint32 GetSimSetupSourceHash() const override;
+
+	/** update simulation data: engine */
+	// 更新模拟数据：引擎
+	void UpdateEngineSetup(const FVehicleEngineData& NewEngineSetup);
+
+	/** update simulation data: differential */
+	// 更新模拟数据：差速器
+	void UpdateDifferentialSetup(const FVehicleDifferentialNWData& NewDifferentialSetup);
+
+	/** update simulation data: transmission */
+	// 更新模拟数据：变速器
+	void UpdateTransmissionSetup(const FVehicleTransmissionData& NewGearSetup);
+};
+
+PRAGMA_ENABLE_DEPRECATION_WARNINGS